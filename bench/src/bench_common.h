@@ -0,0 +1,35 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static inline double bench_now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Element count from argv[1], falling back to the given default
+static inline size_t bench_arg_count(int argc, char **argv, size_t fallback)
+{
+  if (argc > 1)
+  {
+    return (size_t)strtoull(argv[1], NULL, 10);
+  }
+  return fallback;
+}
+
+static inline void bench_report(const char *name, double start_ns, double end_ns, size_t ops)
+{
+  double total_ms = (end_ns - start_ns) / 1e6;
+  double per_op = ops ? (end_ns - start_ns) / (double)ops : 0.0;
+  printf("%-40s %10.2f ms %8.2f ns/op\n", name, total_ms, per_op);
+}
+
+// Keeps the optimizer from discarding benchmark results
+static volatile long long bench_sink;
+
+#endif
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_common.h"
+#include "df_iterator.h"
+#include "bench_common.h"
+
+static DfArray *filled_array(size_t n)
+{
+  DfResult res = dfarray_create(sizeof(int), n);
+  if (res.error)
+  {
+    printf("Create error: %s\n", df_error_to_string(res.error));
+    exit(1);
+  }
+
+  DfArray *array = res.value;
+  for (size_t i = 0; i < n; i++)
+  {
+    int value = (int)i;
+    dfarray_push(array, &value);
+  }
+  return array;
+}
+
+// Build and drop many arrays of 8 ints, the common tiny-array case
+static void bench_tiny_arrays(size_t n)
+{
+  size_t count = n / 8;
+  long long sum;
+  double start;
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < count; i++)
+  {
+    DfArray *array = dfarray_create(sizeof(int), 8).value;
+    for (int j = 0; j < 8; j++)
+    {
+      dfarray_push(array, &j);
+    }
+    sum += *(int *)dfarray_back(array).value;
+    dfarray_destroy(array);
+  }
+  bench_report("tiny arrays: dfarray_create", start, bench_now_ns(), count);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < count; i++)
+  {
+    DfArray *array = dfarray_create_inline(sizeof(int), 8).value;
+    for (int j = 0; j < 8; j++)
+    {
+      dfarray_push(array, &j);
+    }
+    sum += *(int *)dfarray_back(array).value;
+    dfarray_destroy(array);
+  }
+  bench_report("tiny arrays: dfarray_create_inline", start, bench_now_ns(), count);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < count; i++)
+  {
+    DFARRAY_INLINE_STORAGE(storage, sizeof(int), 8);
+    DfArray *array = dfarray_init_inline(storage, sizeof(storage), sizeof(int)).value;
+    for (int j = 0; j < 8; j++)
+    {
+      dfarray_push(array, &j);
+    }
+    sum += *(int *)dfarray_back(array).value;
+    dfarray_destroy(array);
+  }
+  bench_report("tiny arrays: dfarray_init_inline", start, bench_now_ns(), count);
+  bench_sink = sum;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 10000000);
+  printf("DfArray access, %zu ints\n", n);
+
+  DfArray *array = filled_array(n);
+  long long sum;
+  double start;
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    DfResult res = dfarray_get(array, i);
+    sum += *(int *)res.value;
+    free(res.value);
+  }
+  bench_report("dfarray_get (copy)", start, bench_now_ns(), n);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    sum += *(int *)dfarray_at(array, i).value;
+  }
+  bench_report("dfarray_at (borrowed)", start, bench_now_ns(), n);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  DfArray_Span span;
+  dfarray_span(array, &span);
+  const int *data = span.data;
+  for (size_t i = 0; i < span.length; i++)
+  {
+    sum += data[i];
+  }
+  bench_report("dfarray_span (direct loop)", start, bench_now_ns(), n);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  Iterator *it = dfarray_iterator_create(array).value;
+  while (it->has_next(it))
+  {
+    DfResult res = it->next(it);
+    sum += *(int *)res.value;
+    free(res.value);
+  }
+  bench_report("dfarray_iterator_next (copy)", start, bench_now_ns(), n);
+  bench_sink = sum;
+  iterator_destroy(it);
+  free(it);
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    DfResult res = dfarray_pop(array);
+    sum += *(int *)res.value;
+    free(res.value);
+  }
+  bench_report("dfarray_pop (copy)", start, bench_now_ns(), n);
+  bench_sink = sum;
+  dfarray_destroy(array);
+
+  array = filled_array(n);
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    int value;
+    dfarray_pop_into(array, &value);
+    sum += value;
+  }
+  bench_report("dfarray_pop_into (caller buffer)", start, bench_now_ns(), n);
+  bench_sink = sum;
+  dfarray_destroy(array);
+
+  bench_tiny_arrays(n);
+
+  return 0;
+}
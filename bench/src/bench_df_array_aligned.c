@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+// Enough passes to scan about 200M elements per measurement
+#define BENCH_ELEMENTS_PER_RUN 200000000
+
+static int bench_passes = 1;
+
+static uint32_t sum_unaligned(const uint32_t *data, size_t n)
+{
+  uint32_t total = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    total += data[i];
+  }
+  return total;
+}
+
+static uint32_t sum_aligned(const uint32_t *data, size_t n)
+{
+  const uint32_t *aligned = __builtin_assume_aligned(data, 64);
+  uint32_t total = 0;
+  for (size_t i = 0; i < n; i++)
+  {
+    total += aligned[i];
+  }
+  return total;
+}
+
+static void bench_scan(const char *name, uint32_t (*sum)(const uint32_t *, size_t), const uint32_t *data, size_t n)
+{
+  uint32_t total = 0;
+  double start = bench_now_ns();
+  for (int pass = 0; pass < bench_passes; pass++)
+  {
+    total += sum(data, n);
+  }
+  bench_report(name, start, bench_now_ns(), n * bench_passes);
+  bench_sink = total;
+}
+
+static DfArray *bench_fill(DfArray *array, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    uint32_t value = (uint32_t)(i & 1023);
+    dfarray_push(array, &value);
+  }
+  return array;
+}
+
+int main(int argc, char **argv)
+{
+  // The default fits in L2, so the scans are bound by loads rather than memory bandwidth
+  size_t n = bench_arg_count(argc, argv, 16384);
+  bench_passes = n < BENCH_ELEMENTS_PER_RUN ? (int)(BENCH_ELEMENTS_PER_RUN / n) : 1;
+  printf("DfArray scans, %zu uint32_t x %d passes\n", n, bench_passes);
+
+  DfArray_Span span;
+
+  DfArray *plain = bench_fill(dfarray_create(sizeof(uint32_t), 0).value, n);
+  dfarray_span(plain, &span);
+  printf("  malloc storage offset within cache line: %zu\n", (size_t)((uintptr_t)span.data % 64));
+  bench_scan("sum (malloc storage)", sum_unaligned, span.data, span.length);
+
+  DfArray *aligned = bench_fill(dfarray_create_aligned(sizeof(uint32_t), 0, 64, 0).value, n);
+  dfarray_span(aligned, &span);
+  bench_scan("sum (64 byte aligned, assumed)", sum_aligned, span.data, span.length);
+  bench_scan("sum (misaligned by 4 bytes)", sum_unaligned, (const uint32_t *)span.data + 1, span.length - 1);
+
+  // One element per cache line, as for per-thread slots
+  DfArray *padded = bench_fill(dfarray_create_aligned(sizeof(uint32_t), 0, 64, 64).value, n / 16);
+  dfarray_span(padded, &span);
+  uint32_t total = 0;
+  double start = bench_now_ns();
+  for (int pass = 0; pass < bench_passes; pass++)
+  {
+    for (size_t i = 0; i < span.length; i++)
+    {
+      total += *(const uint32_t *)((const char *)span.data + i * span.stride);
+    }
+  }
+  bench_report("sum (padded to 64 byte stride)", start, bench_now_ns(), span.length * bench_passes);
+  bench_sink = total;
+
+  dfarray_destroy(plain);
+  dfarray_destroy(aligned);
+  dfarray_destroy(padded);
+  return 0;
+}
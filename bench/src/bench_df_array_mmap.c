@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+static void bench_growth(const char *name, size_t n, const DfArray_Policy *policy)
+{
+  DfArray *array = dfarray_create_with_policy(sizeof(uint64_t), 0, policy).value;
+
+  double start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    uint64_t value = i;
+    dfarray_push(array, &value);
+  }
+  bench_report(name, start, bench_now_ns(), n);
+
+  DfArray_Stats stats;
+  dfarray_stats(array, &stats);
+  printf("  reallocs %zu, of which remaps %zu\n", stats.reallocs, stats.remaps);
+
+  start = bench_now_ns();
+  while ((size_t)dfarray_length(array).value > n / 8)
+  {
+    dfarray_remove_range(array, n / 8, (size_t)dfarray_length(array).value - n / 8);
+    dfarray_shrink_to_fit(array);
+  }
+  bench_report("  shrink to 1/8", start, bench_now_ns(), 1);
+
+  dfarray_destroy(array);
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 50000000);
+  printf("DfArray growth, %zu uint64_t (%zu MB)\n", n, n * sizeof(uint64_t) >> 20);
+
+  DfArray_Policy heap = DFARRAY_POLICY_DEFAULT;
+  heap.mmap_threshold = 0;
+  bench_growth("push (heap, realloc)", n, &heap);
+
+  DfArray_Policy mapped = DFARRAY_POLICY_DEFAULT;
+  bench_growth("push (mapped above threshold)", n, &mapped);
+
+  DfArray_Policy huge = DFARRAY_POLICY_DEFAULT;
+  huge.huge_pages = true;
+  bench_growth("push (mapped, huge pages)", n, &huge);
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "df_array.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+typedef struct BenchRecord
+{
+  uint64_t key;
+  char payload[56];
+} BenchRecord;
+
+static int cmp_u32(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_f64(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_record(const void *a, const void *b)
+{
+  uint64_t x = ((const BenchRecord *)a)->key;
+  uint64_t y = ((const BenchRecord *)b)->key;
+  return (x > y) - (x < y);
+}
+
+static uint64_t bench_rand_state = 88172645463325252ull;
+
+static uint64_t bench_rand(void)
+{
+  bench_rand_state ^= bench_rand_state << 13;
+  bench_rand_state ^= bench_rand_state >> 7;
+  bench_rand_state ^= bench_rand_state << 17;
+  return bench_rand_state;
+}
+
+// Fills the array with n random elements produced by fill
+static DfArray *bench_fill(size_t elem_size, size_t n, void (*fill)(void *))
+{
+  DfArray *array = dfarray_create(elem_size, n).value;
+  unsigned char element[sizeof(BenchRecord)];
+  for (size_t i = 0; i < n; i++)
+  {
+    fill(element);
+    dfarray_push(array, element);
+  }
+  return array;
+}
+
+static void fill_u32(void *out)
+{
+  *(uint32_t *)out = (uint32_t)bench_rand();
+}
+
+static void fill_f64(void *out)
+{
+  *(double *)out = (double)(int64_t)bench_rand() / 1e6;
+}
+
+static void fill_record(void *out)
+{
+  BenchRecord *record = out;
+  memset(record, 0, sizeof(*record));
+  record->key = bench_rand();
+}
+
+static DfArray *bench_copy(DfArray *source, size_t elem_size)
+{
+  DfArray_Span span;
+  dfarray_span(source, &span);
+  DfArray *copy = dfarray_create(elem_size, span.length).value;
+  dfarray_append_n(copy, span.data, span.length);
+  return copy;
+}
+
+static void bench_qsort(const char *name, DfArray *source, size_t elem_size, int (*cmp)(const void *, const void *))
+{
+  DfArray *copy = bench_copy(source, elem_size);
+  DfArray_Span span;
+  dfarray_span(copy, &span);
+  double start = bench_now_ns();
+  qsort(span.data, span.length, elem_size, cmp);
+  bench_report(name, start, bench_now_ns(), span.length);
+  dfarray_destroy(copy);
+}
+
+static void bench_sort(const char *name, DfArray *source, size_t elem_size, int (*cmp)(const void *, const void *))
+{
+  DfArray *copy = bench_copy(source, elem_size);
+  size_t n = (size_t)dfarray_length(copy).value;
+  double start = bench_now_ns();
+  dfarray_sort(copy, cmp);
+  bench_report(name, start, bench_now_ns(), n);
+  dfarray_destroy(copy);
+}
+
+static void bench_radix(const char *name, DfArray *source, size_t elem_size, DfKey_Type key_type, size_t key_offset)
+{
+  DfArray *copy = bench_copy(source, elem_size);
+  size_t n = (size_t)dfarray_length(copy).value;
+  double start = bench_now_ns();
+  dfarray_radix_sort(copy, key_type, key_offset);
+  bench_report(name, start, bench_now_ns(), n);
+  dfarray_destroy(copy);
+}
+
+static void bench_search(DfArray *sorted, size_t n)
+{
+  long long hits = 0;
+  double start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    uint32_t key = (uint32_t)bench_rand();
+    hits += (size_t)dfarray_lower_bound(sorted, &key, cmp_u32).value;
+  }
+  bench_report("dfarray_lower_bound (u32)", start, bench_now_ns(), n);
+  bench_sink = hits;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("DfArray sort, %zu elements\n", n);
+
+  DfArray *u32 = bench_fill(sizeof(uint32_t), n, fill_u32);
+  bench_qsort("qsort (u32)", u32, sizeof(uint32_t), cmp_u32);
+  bench_sort("dfarray_sort (u32)", u32, sizeof(uint32_t), cmp_u32);
+  bench_radix("dfarray_radix_sort (u32)", u32, sizeof(uint32_t), DF_KEY_U32, 0);
+
+  DfArray *f64 = bench_fill(sizeof(double), n, fill_f64);
+  bench_qsort("qsort (f64)", f64, sizeof(double), cmp_f64);
+  bench_sort("dfarray_sort (f64)", f64, sizeof(double), cmp_f64);
+  bench_radix("dfarray_radix_sort (f64)", f64, sizeof(double), DF_KEY_F64, 0);
+
+  DfArray *records = bench_fill(sizeof(BenchRecord), n, fill_record);
+  bench_qsort("qsort (64 byte records)", records, sizeof(BenchRecord), cmp_record);
+  bench_sort("dfarray_sort (64 byte records)", records, sizeof(BenchRecord), cmp_record);
+  bench_radix("dfarray_radix_sort (64 byte records)", records, sizeof(BenchRecord), DF_KEY_U64, offsetof(BenchRecord, key));
+
+  dfarray_radix_sort(u32, DF_KEY_U32, 0);
+  bench_search(u32, n);
+
+  dfarray_destroy(u32);
+  dfarray_destroy(f64);
+  dfarray_destroy(records);
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_array_typed.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+DF_ARRAY_DEFINE(int32_t, i32)
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 10000000);
+  printf("DfArray typed vs untyped, %zu int32_t\n", n);
+
+  long long sum;
+  double start;
+
+  DfArray *untyped = dfarray_create(sizeof(int32_t), 0).value;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    int32_t value = (int32_t)i;
+    dfarray_push(untyped, &value);
+  }
+  bench_report("dfarray_push", start, bench_now_ns(), n);
+
+  DfArray *typed = dfarray_i32_create(0).value;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    dfarray_i32_push(typed, (int32_t)i);
+  }
+  bench_report("dfarray_i32_push", start, bench_now_ns(), n);
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    sum += *(int32_t *)dfarray_at(untyped, i).value;
+  }
+  bench_report("dfarray_at", start, bench_now_ns(), n);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    int32_t value = 0;
+    dfarray_i32_get(typed, i, &value);
+    sum += value;
+  }
+  bench_report("dfarray_i32_get", start, bench_now_ns(), n);
+  bench_sink = sum;
+
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    int32_t value = (int32_t)(i * 2);
+    dfarray_set(untyped, i, &value);
+  }
+  bench_report("dfarray_set", start, bench_now_ns(), n);
+
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    dfarray_i32_set(typed, i, (int32_t)(i * 2));
+  }
+  bench_report("dfarray_i32_set", start, bench_now_ns(), n);
+
+  dfarray_destroy(untyped);
+  dfarray_destroy(typed);
+  return 0;
+}
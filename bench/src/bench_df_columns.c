@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_columns.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+// Wide record, only balance is read by the aggregation
+typedef struct BenchAccount
+{
+  uint64_t id;
+  int32_t age;
+  double balance;
+  char name[48];
+} BenchAccount;
+
+static void sum_balance(void *acc, const void *elem)
+{
+  *(double *)acc += *(const double *)elem;
+}
+
+static bool is_adult(const void *element)
+{
+  return *(const int32_t *)element >= 18;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 5000000);
+  printf("DfArray of structs vs DfColumns, %zu rows of %zu bytes\n", n, sizeof(BenchAccount));
+
+  DfArray *records = dfarray_create(sizeof(BenchAccount), n).value;
+  size_t sizes[] = {sizeof(uint64_t), sizeof(int32_t), sizeof(double), sizeof(((BenchAccount *)0)->name)};
+  DfColumns *columns = dfcolumns_create(sizes, 4, n).value;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    BenchAccount account = {.id = i, .age = (int32_t)(i % 90), .balance = (double)(i % 1000)};
+    dfarray_push(records, &account);
+    const void *row[] = {&account.id, &account.age, &account.balance, account.name};
+    dfcolumns_append_row(columns, row);
+  }
+
+  double start;
+  double total;
+
+  DfArray_Span span;
+  dfarray_span(records, &span);
+  const BenchAccount *accounts = span.data;
+  total = 0.0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < span.length; i++)
+  {
+    total += accounts[i].balance;
+  }
+  bench_report("sum balance (array of structs)", start, bench_now_ns(), n);
+  bench_sink = (long long)total;
+
+  const double *balances = DFCOLUMNS_DATA(columns, 2, double);
+  total = 0.0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    total += balances[i];
+  }
+  bench_report("sum balance (column data)", start, bench_now_ns(), n);
+  bench_sink = (long long)total;
+
+  total = 0.0;
+  start = bench_now_ns();
+  dfcolumns_reduce(columns, 2, NULL, &total, sum_balance);
+  bench_report("dfcolumns_reduce", start, bench_now_ns(), n);
+  bench_sink = (long long)total;
+
+  total = 0.0;
+  start = bench_now_ns();
+  for (size_t i = 0; i < span.length; i++)
+  {
+    if (accounts[i].age >= 18)
+    {
+      total += accounts[i].balance;
+    }
+  }
+  bench_report("filtered sum (array of structs)", start, bench_now_ns(), n);
+  bench_sink = (long long)total;
+
+  total = 0.0;
+  start = bench_now_ns();
+  DfArray *adults = dfcolumns_filter(columns, 1, NULL, is_adult).value;
+  dfcolumns_reduce(columns, 2, adults, &total, sum_balance);
+  bench_report("dfcolumns_filter + dfcolumns_reduce", start, bench_now_ns(), n);
+  bench_sink = (long long)total;
+
+  dfarray_destroy(adults);
+  dfarray_destroy(records);
+  dfcolumns_destroy(columns);
+  return 0;
+}
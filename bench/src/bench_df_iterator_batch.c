@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_list_s.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "df_utils.h"
+#include "bench_common.h"
+
+static long long total;
+
+static bool accumulate(void *elem)
+{
+  total += *(long long *)elem;
+  return true;
+}
+
+// The element-at-a-time loop df_reduce ran before next_batch existed
+static long long sum_by_next(Iterator *it, int owns_copies)
+{
+  long long sum = 0;
+  while (it->has_next(it))
+  {
+    void *element = it->next(it).value;
+    sum += *(long long *)element;
+    if (owns_copies)
+    {
+      free(element);
+    }
+  }
+  return sum;
+}
+
+// df_count runs on next_batch; lists have no element size, so df_reduce cannot take them
+static long long sum_by_batch(Iterator *it)
+{
+  total = 0;
+  df_count(it, accumulate);
+  return total;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("Summing %zu elements with next() vs next_batch (df_count)\n", n);
+
+  DfArray *array = dfarray_create(sizeof(long long), n).value;
+  DfList_S *list = dflist_s_create().value;
+  long long *values = malloc(n * sizeof(long long));
+  for (size_t i = 0; i < n; i++)
+  {
+    values[i] = (long long)i;
+    dfarray_push(array, &values[i]);
+    dflist_s_push_back(list, &values[i]);
+  }
+
+  // DfArray::next() hands out a heap copy per element
+  Iterator *it = dfarray_iterator_create(array).value;
+  double start = bench_now_ns();
+  bench_sink = sum_by_next(it, 1);
+  bench_report("DfArray next()", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+
+  it = dfarray_iterator_create(array).value;
+  start = bench_now_ns();
+  bench_sink = sum_by_batch(it);
+  bench_report("DfArray next_batch", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+
+  it = dflist_s_iterator_create(list).value;
+  start = bench_now_ns();
+  bench_sink = sum_by_next(it, 0);
+  bench_report("DfList_S next()", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+
+  it = dflist_s_iterator_create(list).value;
+  start = bench_now_ns();
+  bench_sink = sum_by_batch(it);
+  bench_report("DfList_S next_batch", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+
+  dfarray_destroy(array);
+  dflist_s_destroy(list, NULL);
+  free(values);
+  return 0;
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_list_s.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+// Short-lived iterators that read a couple of elements, heap-created vs initialized on the stack
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("Create, read two elements and destroy %zu iterators\n", n);
+
+  DfArray *array = dfarray_create(sizeof(long long), 4).value;
+  DfList_S *list = dflist_s_create().value;
+  long long values[4] = {1, 2, 3, 4};
+  for (int i = 0; i < 4; i++)
+  {
+    dfarray_push(array, &values[i]);
+    dflist_s_push_back(list, &values[i]);
+  }
+
+  long long sum = 0;
+  DfSpan span;
+
+  double start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    Iterator *it = dfarray_iterator_create(array).value;
+    it->next_batch(it, &span, 2);
+    sum += *(long long *)df_span_at(&span, 1);
+    iterator_free(it);
+  }
+  bench_report("DfArray create/free", start, bench_now_ns(), n);
+
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    Iterator it;
+    dfarray_iterator_init(&it, array);
+    it.next_batch(&it, &span, 2);
+    sum += *(long long *)df_span_at(&span, 1);
+    iterator_destroy(&it);
+  }
+  bench_report("DfArray init (stack)", start, bench_now_ns(), n);
+
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    Iterator *it = dflist_s_iterator_create(list).value;
+    sum += *(long long *)it->next(it).value;
+    iterator_free(it);
+  }
+  bench_report("DfList_S create/free", start, bench_now_ns(), n);
+
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    Iterator it;
+    dflist_s_iterator_init(&it, list);
+    sum += *(long long *)it.next(&it).value;
+    iterator_destroy(&it);
+  }
+  bench_report("DfList_S init (stack)", start, bench_now_ns(), n);
+
+  bench_sink = sum;
+  dfarray_destroy(array);
+  dflist_s_destroy(list, NULL);
+  return 0;
+}
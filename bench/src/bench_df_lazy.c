@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_deque.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "df_utils.h"
+#include "bench_common.h"
+
+static long long scratch;
+
+static bool is_odd(void *element)
+{
+  return *(long long *)element % 2 != 0;
+}
+
+// Writes into scratch so the source is left untouched
+static void *triple_value(void *element)
+{
+  scratch = *(long long *)element * 3;
+  return &scratch;
+}
+
+static void sum_values(void *acc, void *elem)
+{
+  *(long long *)acc += *(long long *)elem;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("filter -> map -> reduce over a DfDeque, %zu elements\n", n);
+
+  DfDeque *deque = dfdeque_create(sizeof(long long), n).value;
+  for (size_t i = 0; i < n; i++)
+  {
+    long long value = (long long)i;
+    dfdeque_push_back(deque, &value);
+  }
+
+  // Eager: each stage materializes a full deque
+  double start = bench_now_ns();
+  Iterator *it = dfdeque_iterator_create(deque).value;
+  DfDeque *filtered = df_filter(it, is_odd).value;
+  Iterator *filtered_it = dfdeque_iterator_create(filtered).value;
+  DfDeque *mapped = df_map(filtered_it, triple_value).value;
+  Iterator *mapped_it = dfdeque_iterator_create(mapped).value;
+  long long initial = 0;
+  long long *eager = df_reduce(mapped_it, &initial, sum_values).value;
+  bench_report("eager", start, bench_now_ns(), n);
+
+  iterator_destroy(it);
+  free(it);
+  iterator_destroy(filtered_it);
+  free(filtered_it);
+  iterator_destroy(mapped_it);
+  free(mapped_it);
+  dfdeque_destroy(filtered);
+  dfdeque_destroy(mapped);
+
+  // Lazy: one fused pass, no intermediate structures
+  start = bench_now_ns();
+  it = dfdeque_iterator_create(deque).value;
+  Iterator *lazy_filter = df_lazy_filter(it, is_odd).value;
+  Iterator *lazy_map = df_lazy_map(lazy_filter, triple_value).value;
+  long long *lazy = df_reduce(lazy_map, &initial, sum_values).value;
+  bench_report("lazy", start, bench_now_ns(), n);
+
+  bench_sink = *eager + *lazy;
+  if (*eager != *lazy)
+  {
+    printf("mismatch: %lld != %lld\n", *eager, *lazy);
+  }
+
+  free(eager);
+  free(lazy);
+  iterator_destroy(lazy_map);
+  free(lazy_map);
+  iterator_destroy(lazy_filter);
+  free(lazy_filter);
+  iterator_destroy(it);
+  free(it);
+  dfdeque_destroy(deque);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+static int values[2] = {0, 1};
+
+static DfList_S *bench_make_list(size_t n)
+{
+  DfList_S *list = dflist_s_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_push_back(list, &values[i & 1]);
+  }
+  return list;
+}
+
+// One filtering pass: drop every odd element and duplicate every even one
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  size_t indexed_n = n < 20000 ? n : 20000;
+  printf("Streaming edit pass, %zu elements (index-based pass on %zu)\n", n, indexed_n);
+
+  DfList_S *list = bench_make_list(indexed_n);
+  double start = bench_now_ns();
+  for (size_t i = 0; i < (size_t)dflist_s_length(list).value;)
+  {
+    if (*(int *)dflist_s_get(list, i).value)
+    {
+      dflist_s_remove_at(list, i);
+    }
+    else
+    {
+      dflist_s_insert_at(list, &values[0], i + 1);
+      i += 2;
+    }
+  }
+  bench_report("get/insert_at/remove_at", start, bench_now_ns(), indexed_n);
+  dflist_s_destroy(list, NULL);
+
+  list = bench_make_list(n);
+  start = bench_now_ns();
+  DfList_S_Cursor *cursor = dflist_s_cursor_create(list).value;
+  while (!dflist_s_cursor_at_end(cursor))
+  {
+    if (*(int *)dflist_s_cursor_get(cursor).value)
+    {
+      dflist_s_cursor_remove(cursor);
+    }
+    else
+    {
+      dflist_s_cursor_insert_after(cursor, &values[0]);
+      dflist_s_cursor_advance(cursor);
+      dflist_s_cursor_advance(cursor);
+    }
+  }
+  dflist_s_cursor_destroy(cursor);
+  bench_report("DfList_S_Cursor", start, bench_now_ns(), n);
+  bench_sink = (long long)(size_t)dflist_s_length(list).value;
+
+  dflist_s_destroy(list, NULL);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_slab.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+// Fills the list, then churns it as a queue and drains it
+static void bench_churn(const char *name, DfList_S *list, size_t n)
+{
+  static int element = 1;
+
+  double start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_push_back(list, &element);
+  }
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_pop_front(list);
+    dflist_s_push_back(list, &element);
+  }
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_pop_front(list);
+  }
+  bench_report(name, start, bench_now_ns(), 4 * n);
+}
+
+static void bench_teardown(const char *name, DfList_S *list, size_t n)
+{
+  static int element = 1;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_push_front(list, &element);
+  }
+
+  double start = bench_now_ns();
+  dflist_s_destroy(list, NULL);
+  bench_report(name, start, bench_now_ns(), n);
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("DfList_S node allocation, %zu nodes\n", n);
+
+  DfList_S *plain = dflist_s_create().value;
+  bench_churn("push/pop (malloc per node)", plain, n);
+  dflist_s_destroy(plain, NULL);
+
+  DfList_S *pooled = dflist_s_create_pooled(NULL).value;
+  bench_churn("push/pop (private pool)", pooled, n);
+
+  DfSlab_Stats stats;
+  dfslab_stats(dflist_s_pool(pooled).value, &stats);
+  printf("  pool: %zu allocs from %zu chunks, fragmentation %.2f\n", stats.allocs, stats.chunks, stats.fragmentation);
+  dflist_s_destroy(pooled, NULL);
+
+  bench_teardown("destroy (malloc per node)", dflist_s_create().value, n);
+  bench_teardown("destroy (private pool)", dflist_s_create_pooled(NULL).value, n);
+
+  return 0;
+}
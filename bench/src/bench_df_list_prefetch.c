@@ -0,0 +1,116 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_iterator.h"
+#include "df_utils.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+typedef struct
+{
+  unsigned key;
+  int value;
+} BenchItem;
+
+static int cmp_key(const void *a, const void *b)
+{
+  unsigned x = ((const BenchItem *)a)->key, y = ((const BenchItem *)b)->key;
+  return (x > y) - (x < y);
+}
+
+// A predicate with some arithmetic per element, like a hash or a parse, that a walk can overlap with the next miss
+static bool is_positive(void *element)
+{
+  unsigned h = ((BenchItem *)element)->key;
+  for (int i = 0; i < 64; i++)
+  {
+    h = h * 2654435761u + 0x9e3779b9u;
+  }
+  bench_sink += h & 1;
+  return ((BenchItem *)element)->value > 0;
+}
+
+// Sorting by a random key relinks the nodes in random memory order, so neither the
+// nodes nor the elements they point to are walked sequentially
+static DfList_S *bench_make_scattered(BenchItem *items, size_t n)
+{
+  DfList_S *list = dflist_s_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    items[i] = (BenchItem){(unsigned)rand(), 1};
+    dflist_s_push_back(list, &items[i]);
+  }
+  dflist_s_sort(list, cmp_key);
+  return list;
+}
+
+static void bench_iterate(DfList_S *list, const char *name, size_t n)
+{
+  long long sum = 0;
+  double start = bench_now_ns();
+  Iterator *it = dflist_s_iterator_create(list).value;
+  while (it->has_next(it))
+  {
+    sum += ((BenchItem *)it->next(it).value)->value;
+  }
+  bench_report(name, start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+  bench_sink = sum;
+}
+
+static void bench_count(DfList_S *list, const char *name, size_t n)
+{
+  double start = bench_now_ns();
+  Iterator *it = dflist_s_iterator_create(list).value;
+  bench_sink = (long long)(size_t)df_count(it, is_positive).value;
+  bench_report(name, start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+}
+
+int main(int argc, char **argv)
+{
+  // Far beyond the last-level cache: 32-byte nodes plus 8-byte elements per entry
+  size_t n = bench_arg_count(argc, argv, 4000000);
+  printf("Prefetching traversal of a scattered DfList_S, %zu elements\n", n);
+
+  srand(9);
+  BenchItem *items = malloc(n * sizeof(BenchItem));
+  DfList_S *list = bench_make_scattered(items, n);
+
+  // A bare walk is bound by the chain of next loads, which the runner cannot shorten
+  bench_iterate(list, "iterate, no prefetch", n);
+  dflist_s_set_prefetch(list, DFLIST_PREFETCH_DEFAULT_DISTANCE, true);
+  bench_iterate(list, "iterate, default distance + elements", n);
+
+  // With work per element, the runner's misses overlap that work
+  dflist_s_set_prefetch(list, 0, false);
+  bench_count(list, "df_count, no prefetch", n);
+  size_t distances[] = {2, 8, 32};
+  for (size_t i = 0; i < sizeof(distances) / sizeof(distances[0]); i++)
+  {
+    char label[64];
+    dflist_s_set_prefetch(list, distances[i], false);
+    snprintf(label, sizeof(label), "df_count, distance %zu", distances[i]);
+    bench_count(list, label, n);
+    dflist_s_set_prefetch(list, distances[i], true);
+    snprintf(label, sizeof(label), "df_count, distance %zu + elements", distances[i]);
+    bench_count(list, label, n);
+  }
+
+  dflist_s_set_prefetch(list, 0, false);
+  DfList_S *half = dflist_s_split_at(list, n / 2).value;
+  double start = bench_now_ns();
+  dflist_s_destroy(half, NULL);
+  bench_report("destroy, no prefetch", start, bench_now_ns(), n - n / 2);
+
+  dflist_s_set_prefetch(list, DFLIST_PREFETCH_DEFAULT_DISTANCE, false);
+  start = bench_now_ns();
+  dflist_s_destroy(list, NULL);
+  bench_report("destroy, default distance", start, bench_now_ns(), n / 2);
+
+  free(items);
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+static int cmp_int(const void *a, const void *b)
+{
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+// qsort hands over pointers to the stored element pointers
+static int cmp_int_ref(const void *a, const void *b)
+{
+  return cmp_int(*(void *const *)a, *(void *const *)b);
+}
+
+static DfList_S *bench_make_list(int *values, size_t n)
+{
+  DfList_S *list = dflist_s_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_push_back(list, &values[i]);
+  }
+  return list;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("Sorting a DfList_S of %zu ints\n", n);
+
+  int *values = malloc(n * sizeof(int));
+  void **scratch = malloc(n * sizeof(void *));
+  srand(5);
+  for (size_t i = 0; i < n; i++)
+  {
+    values[i] = rand();
+  }
+
+  // What callers did before: drain into an array, qsort, rebuild every node
+  DfList_S *list = bench_make_list(values, n);
+  double start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    scratch[i] = dflist_s_pop_front(list).value;
+  }
+  qsort(scratch, n, sizeof(void *), cmp_int_ref);
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_push_back(list, scratch[i]);
+  }
+  bench_report("copy + qsort + rebuild", start, bench_now_ns(), n);
+  dflist_s_destroy(list, NULL);
+
+  list = bench_make_list(values, n);
+  start = bench_now_ns();
+  dflist_s_sort(list, cmp_int);
+  bench_report("dflist_s_sort", start, bench_now_ns(), n);
+  bench_sink = *(int *)dflist_s_peek_front(list).value;
+
+  dflist_s_destroy(list, NULL);
+
+  // Two independently sorted halves interleave, so the merge cannot fall back to a concat
+  list = bench_make_list(values, n);
+  DfList_S *half = dflist_s_split_at(list, n / 2).value;
+  dflist_s_sort(list, cmp_int);
+  dflist_s_sort(half, cmp_int);
+  start = bench_now_ns();
+  dflist_s_merge(list, half, cmp_int);
+  bench_report("dflist_s_merge (two halves)", start, bench_now_ns(), n);
+
+  dflist_s_destroy(list, NULL);
+  dflist_s_destroy(half, NULL);
+  free(scratch);
+  free(values);
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+#define BENCH_PARTS 1000
+
+// Split and splice walk to the cut, so they get fewer rounds
+#define BENCH_SPLITS 100
+
+static int element = 1;
+
+static DfList_S **bench_make_parts(size_t per_part)
+{
+  DfList_S **parts = malloc(BENCH_PARTS * sizeof(DfList_S *));
+  for (size_t i = 0; i < BENCH_PARTS; i++)
+  {
+    parts[i] = dflist_s_create().value;
+    for (size_t j = 0; j < per_part; j++)
+    {
+      dflist_s_push_back(parts[i], &element);
+    }
+  }
+  return parts;
+}
+
+static void bench_free_parts(DfList_S **parts)
+{
+  for (size_t i = 0; i < BENCH_PARTS; i++)
+  {
+    dflist_s_destroy(parts[i], NULL);
+  }
+  free(parts);
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  size_t per_part = n / BENCH_PARTS;
+  printf("Gluing %d partial lists of %zu elements\n", BENCH_PARTS, per_part);
+
+  DfList_S **parts = bench_make_parts(per_part);
+  DfList_S *batch = dflist_s_create().value;
+  double start = bench_now_ns();
+  for (size_t i = 0; i < BENCH_PARTS; i++)
+  {
+    while (!dflist_s_pop_front(parts[i]).error)
+    {
+      dflist_s_push_back(batch, &element);
+    }
+  }
+  bench_report("pop_front + push_back", start, bench_now_ns(), BENCH_PARTS);
+  dflist_s_destroy(batch, NULL);
+  bench_free_parts(parts);
+
+  parts = bench_make_parts(per_part);
+  batch = dflist_s_create().value;
+  start = bench_now_ns();
+  for (size_t i = 0; i < BENCH_PARTS; i++)
+  {
+    dflist_s_concat(batch, parts[i]);
+  }
+  bench_report("dflist_s_concat", start, bench_now_ns(), BENCH_PARTS);
+
+  start = bench_now_ns();
+  for (size_t i = 0; i < BENCH_SPLITS; i++)
+  {
+    DfList_S *rest = dflist_s_split_at(batch, (size_t)dflist_s_length(batch).value / 2).value;
+    dflist_s_splice_at(batch, rest, 0);
+    dflist_s_destroy(rest, NULL);
+  }
+  bench_report("dflist_s_split_at + splice_at (half)", start, bench_now_ns(), 2 * BENCH_SPLITS);
+  bench_sink = (long long)(size_t)dflist_s_length(batch).value;
+
+  dflist_s_destroy(batch, NULL);
+  bench_free_parts(parts);
+  return 0;
+}
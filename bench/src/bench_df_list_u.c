@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_list_u.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+#define BENCH_POSITIONAL_OPS 200
+
+static int element = 1;
+
+// Pushes to both ends in a shuffled order so nodes are spread across the heap like a long-lived list
+static void bench_fill_s(DfList_S *list, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    if (rand() & 1)
+    {
+      dflist_s_push_back(list, &element);
+    }
+    else
+    {
+      dflist_s_push_front(list, &element);
+    }
+  }
+}
+
+static void bench_fill_u(DfList_U *list, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    if (rand() & 1)
+    {
+      dflist_u_push_back(list, &element);
+    }
+    else
+    {
+      dflist_u_push_front(list, &element);
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("DfList_S vs DfList_U, %zu elements\n", n);
+
+  srand(1);
+  DfList_S *list_s = dflist_s_create().value;
+  bench_fill_s(list_s, n);
+  DfList_U *list_u = dflist_u_create().value;
+  bench_fill_u(list_u, n);
+
+  long long sum = 0;
+  double start = bench_now_ns();
+  Iterator *it = dflist_s_iterator_create(list_s).value;
+  while (it->has_next(it))
+  {
+    sum += *(int *)it->next(it).value;
+  }
+  bench_report("iterate (DfList_S)", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+  bench_sink = sum;
+
+  sum = 0;
+  start = bench_now_ns();
+  it = dflist_u_iterator_create(list_u).value;
+  while (it->has_next(it))
+  {
+    sum += *(int *)it->next(it).value;
+  }
+  bench_report("iterate (DfList_U)", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+  bench_sink = sum;
+
+  srand(2);
+  start = bench_now_ns();
+  for (int i = 0; i < BENCH_POSITIONAL_OPS; i++)
+  {
+    size_t index = (size_t)rand() % n;
+    dflist_s_insert_at(list_s, &element, index);
+    dflist_s_remove_at(list_s, index);
+    sum += *(int *)dflist_s_get(list_s, index).value;
+  }
+  bench_report("get/insert_at/remove_at (DfList_S)", start, bench_now_ns(), 3 * BENCH_POSITIONAL_OPS);
+
+  srand(2);
+  start = bench_now_ns();
+  for (int i = 0; i < BENCH_POSITIONAL_OPS; i++)
+  {
+    size_t index = (size_t)rand() % n;
+    dflist_u_insert_at(list_u, &element, index);
+    dflist_u_remove_at(list_u, index);
+    sum += *(int *)dflist_u_get(list_u, index).value;
+  }
+  bench_report("get/insert_at/remove_at (DfList_U)", start, bench_now_ns(), 3 * BENCH_POSITIONAL_OPS);
+  bench_sink = sum;
+
+  dflist_s_destroy(list_s, NULL);
+  dflist_u_destroy(list_u, NULL);
+  return 0;
+}
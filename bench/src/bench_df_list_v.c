@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_list_v.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+typedef struct
+{
+  long long id;
+  double weight;
+} BenchRecord;
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("DfList_S of heap elements vs DfList_V, %zu records\n", n);
+
+  // DfList_S: one malloc for the record and one for the node
+  double start = bench_now_ns();
+  DfList_S *list_s = dflist_s_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    BenchRecord *record = malloc(sizeof(BenchRecord));
+    *record = (BenchRecord){(long long)i, 1.0};
+    dflist_s_push_back(list_s, record);
+  }
+  bench_report("build (DfList_S)", start, bench_now_ns(), n);
+
+  DfList_V *list_v = dflist_v_create(sizeof(BenchRecord)).value;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    BenchRecord record = {(long long)i, 1.0};
+    dflist_v_push_back(list_v, &record);
+  }
+  bench_report("build (DfList_V)", start, bench_now_ns(), n);
+
+  long long sum = 0;
+  start = bench_now_ns();
+  DfList_S_Cursor *cursor = dflist_s_cursor_create(list_s).value;
+  while (!dflist_s_cursor_at_end(cursor))
+  {
+    sum += ((BenchRecord *)dflist_s_cursor_get(cursor).value)->id;
+    dflist_s_cursor_advance(cursor);
+  }
+  dflist_s_cursor_destroy(cursor);
+  bench_report("traverse (DfList_S)", start, bench_now_ns(), n);
+
+  start = bench_now_ns();
+  Iterator *it = dflist_v_iterator_create(list_v).value;
+  while (it->has_next(it))
+  {
+    sum += ((BenchRecord *)it->next(it).value)->id;
+  }
+  iterator_destroy(it);
+  free(it);
+  bench_report("traverse (DfList_V)", start, bench_now_ns(), n);
+  bench_sink = sum;
+
+  start = bench_now_ns();
+  dflist_s_destroy(list_s, free);
+  bench_report("destroy with cleanup (DfList_S)", start, bench_now_ns(), n);
+
+  start = bench_now_ns();
+  dflist_v_destroy(list_v);
+  bench_report("destroy (DfList_V)", start, bench_now_ns(), n);
+
+  return 0;
+}
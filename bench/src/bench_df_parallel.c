@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "df_utils.h"
+#include "bench_common.h"
+
+static void add_into(void *acc, void *elem)
+{
+  *(double *)acc += *(double *)elem;
+}
+
+static void scale_into(void *element, void *out)
+{
+  *(double *)out = *(double *)element * 1.5 + 1.0;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 10000000);
+  printf("df_reduce vs df_parallel_reduce and df_parallel_map over a DfArray, %zu doubles\n", n);
+
+  DfArray *array = dfarray_create(sizeof(double), n).value;
+  for (size_t i = 0; i < n; i++)
+  {
+    double value = (double)(i % 1000);
+    dfarray_push(array, &value);
+  }
+  DfArray *output = dfarray_create(sizeof(double), n).value;
+
+  Iterator it;
+  double initial = 0.0;
+
+  dfarray_iterator_init(&it, array);
+  double start = bench_now_ns();
+  double *sum = df_reduce(&it, &initial, add_into).value;
+  bench_report("df_reduce", start, bench_now_ns(), n);
+  bench_sink = (long long)*sum;
+  free(sum);
+
+  size_t thread_counts[] = {1, 2, 4, 8};
+  for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++)
+  {
+    DfParallel_Options options = {thread_counts[t], 0, NULL};
+    char name[64];
+
+    dfarray_iterator_init(&it, array);
+    start = bench_now_ns();
+    sum = df_parallel_reduce(&it, &initial, add_into, add_into, &options).value;
+    snprintf(name, sizeof(name), "df_parallel_reduce (%zu threads)", thread_counts[t]);
+    bench_report(name, start, bench_now_ns(), n);
+    bench_sink = (long long)*sum;
+    free(sum);
+
+    dfarray_iterator_init(&it, array);
+    start = bench_now_ns();
+    df_parallel_map(&it, output, scale_into, &options);
+    snprintf(name, sizeof(name), "df_parallel_map (%zu threads)", thread_counts[t]);
+    bench_report(name, start, bench_now_ns(), n);
+  }
+
+  dfarray_destroy(array);
+  dfarray_destroy(output);
+  return 0;
+}
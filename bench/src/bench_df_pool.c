@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "df_pool.h"
+#include "df_utils.h"
+#include "bench_common.h"
+
+#define BENCH_ROUNDS 200
+
+static void add_into(void *acc, void *elem)
+{
+  *(double *)acc += *(double *)elem;
+}
+
+static double *values;
+
+// Row i costs i steps, so equal-sized static chunks are badly unbalanced
+static void triangle_rows(size_t begin, size_t end, void *arg)
+{
+  (void)arg;
+  double total = 0.0;
+  for (size_t row = begin; row < end; row++)
+  {
+    for (size_t col = 0; col < row; col++)
+    {
+      total += values[col];
+    }
+  }
+  bench_sink += (long long)total;
+}
+
+static void empty_task(void *arg)
+{
+  (void)arg;
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  DfPool *pool = dfpool_create(0).value;
+  DfPool_Stats stats;
+  dfpool_stats(pool, &stats);
+  printf("df_pool with %zu workers: reused pool vs fresh threads, %zu doubles\n", stats.workers, n);
+
+  DfArray *array = dfarray_create(sizeof(double), n).value;
+  for (size_t i = 0; i < n; i++)
+  {
+    double value = (double)(i % 1000);
+    dfarray_push(array, &value);
+  }
+
+  // Many short parallel reductions: thread start-up dominates without a pool
+  Iterator it;
+  double initial = 0.0;
+  DfParallel_Options fresh = {stats.workers, 0, NULL};
+  DfParallel_Options pooled = {0, 0, pool};
+
+  double start = bench_now_ns();
+  for (size_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    dfarray_iterator_init(&it, array);
+    double *sum = df_parallel_reduce(&it, &initial, add_into, add_into, &fresh).value;
+    bench_sink = (long long)*sum;
+    free(sum);
+  }
+  bench_report("df_parallel_reduce, fresh threads", start, bench_now_ns(), n * BENCH_ROUNDS);
+
+  start = bench_now_ns();
+  for (size_t r = 0; r < BENCH_ROUNDS; r++)
+  {
+    dfarray_iterator_init(&it, array);
+    double *sum = df_parallel_reduce(&it, &initial, add_into, add_into, &pooled).value;
+    bench_sink = (long long)*sum;
+    free(sum);
+  }
+  bench_report("df_parallel_reduce, pool", start, bench_now_ns(), n * BENCH_ROUNDS);
+
+  // Unbalanced rows, split down to single rows that idle workers steal
+  size_t rows = 20000;
+  values = (double *)dfarray_at(array, 0).value;
+  start = bench_now_ns();
+  dfpool_parallel_for(pool, 0, rows, 0, triangle_rows, NULL);
+  bench_report("dfpool_parallel_for, triangular rows", start, bench_now_ns(), rows * (rows - 1) / 2);
+
+  DfWait_Group *group = dfwaitgroup_create().value;
+  start = bench_now_ns();
+  for (size_t i = 0; i < n; i++)
+  {
+    dfpool_submit(pool, empty_task, NULL, group);
+  }
+  dfwaitgroup_wait(group);
+  bench_report("dfpool_submit + run, empty tasks", start, bench_now_ns(), n);
+  dfwaitgroup_destroy(group);
+
+  dfpool_stats(pool, &stats);
+  printf("  stats: %zu submitted, %zu executed, %zu steals, %zu failed steals, %zu idle sleeps\n",
+         stats.submitted, stats.executed, stats.steals, stats.failed_steals, stats.idle_sleeps);
+
+  dfpool_destroy(pool);
+  dfarray_destroy(array);
+  return 0;
+}
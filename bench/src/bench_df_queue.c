@@ -0,0 +1,127 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_queue.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+#define BENCH_MAX_THREADS 32
+
+static int element = 1;
+
+typedef struct
+{
+  DfQueue *queue;
+  DfList_S *list;
+  pthread_mutex_t *lock;
+  size_t ops;
+  atomic_size_t *remaining;
+} BenchWorker;
+
+static void *queue_producer(void *arg)
+{
+  BenchWorker *worker = arg;
+  for (size_t i = 0; i < worker->ops; i++)
+  {
+    while (dfqueue_push(worker->queue, &element).error == DF_ERR_FULL)
+    {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void *queue_consumer(void *arg)
+{
+  BenchWorker *worker = arg;
+  while (atomic_load_explicit(worker->remaining, memory_order_relaxed) > 0)
+  {
+    if (!dfqueue_pop(worker->queue).error)
+    {
+      atomic_fetch_sub_explicit(worker->remaining, 1, memory_order_relaxed);
+    }
+  }
+  return NULL;
+}
+
+// The baseline this queue replaces: a DfList_S behind one mutex
+static void *locked_producer(void *arg)
+{
+  BenchWorker *worker = arg;
+  for (size_t i = 0; i < worker->ops; i++)
+  {
+    pthread_mutex_lock(worker->lock);
+    dflist_s_push_back(worker->list, &element);
+    pthread_mutex_unlock(worker->lock);
+  }
+  return NULL;
+}
+
+static void *locked_consumer(void *arg)
+{
+  BenchWorker *worker = arg;
+  while (atomic_load_explicit(worker->remaining, memory_order_relaxed) > 0)
+  {
+    pthread_mutex_lock(worker->lock);
+    DfResult res = dflist_s_pop_front(worker->list);
+    pthread_mutex_unlock(worker->lock);
+    if (!res.error)
+    {
+      atomic_fetch_sub_explicit(worker->remaining, 1, memory_order_relaxed);
+    }
+  }
+  return NULL;
+}
+
+static void bench_run(const char *name, size_t threads, size_t n, void *(*producer)(void *), void *(*consumer)(void *), BenchWorker base)
+{
+  pthread_t producers[BENCH_MAX_THREADS], consumers[BENCH_MAX_THREADS];
+  BenchWorker workers[BENCH_MAX_THREADS];
+  atomic_size_t remaining = (n / threads) * threads;
+  char label[64];
+
+  double start = bench_now_ns();
+  for (size_t i = 0; i < threads; i++)
+  {
+    workers[i] = base;
+    workers[i].ops = n / threads;
+    workers[i].remaining = &remaining;
+    pthread_create(&producers[i], NULL, producer, &workers[i]);
+    pthread_create(&consumers[i], NULL, consumer, &workers[i]);
+  }
+  for (size_t i = 0; i < threads; i++)
+  {
+    pthread_join(producers[i], NULL);
+    pthread_join(consumers[i], NULL);
+  }
+
+  snprintf(label, sizeof(label), "%s, %zu+%zu threads", name, threads, threads);
+  bench_report(label, start, bench_now_ns(), 2 * (n / threads) * threads);
+}
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("MPMC transfer of %zu elements, producers+consumers\n", n);
+
+  for (size_t threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2)
+  {
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    DfList_S *list = dflist_s_create().value;
+    bench_run("mutex + DfList_S", threads, n, locked_producer, locked_consumer, (BenchWorker){.list = list, .lock = &lock});
+    dflist_s_destroy(list, NULL);
+
+    DfQueue *queue = dfqueue_create(0).value;
+    bench_run("DfQueue", threads, n, queue_producer, queue_consumer, (BenchWorker){.queue = queue});
+    dfqueue_destroy(queue, NULL);
+
+    queue = dfqueue_create(1024).value;
+    bench_run("DfQueue bounded", threads, n, queue_producer, queue_consumer, (BenchWorker){.queue = queue});
+    dfqueue_destroy(queue, NULL);
+  }
+
+  return 0;
+}
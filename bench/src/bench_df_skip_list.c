@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "df_list_s.h"
+#include "df_list_u.h"
+#include "df_skip_list.h"
+#include "df_iterator.h"
+#include "df_common.h"
+#include "bench_common.h"
+
+// DfList_S and DfList_U are linear per edit, so they get far fewer operations
+#define BENCH_LINEAR_OPS 200
+#define BENCH_SKIP_OPS 200000
+
+static int element = 1;
+
+int main(int argc, char **argv)
+{
+  size_t n = bench_arg_count(argc, argv, 1000000);
+  printf("Random positional edits, %zu elements\n", n);
+
+  DfList_S *list_s = dflist_s_create().value;
+  DfList_U *list_u = dflist_u_create().value;
+  DfSkipList *skip = dfskiplist_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    dflist_s_push_front(list_s, &element);
+    dflist_u_push_back(list_u, &element);
+    dfskiplist_push_back(skip, &element);
+  }
+
+  long long sum = 0;
+
+  srand(3);
+  double start = bench_now_ns();
+  for (int i = 0; i < BENCH_LINEAR_OPS; i++)
+  {
+    size_t index = (size_t)rand() % n;
+    dflist_s_insert_at(list_s, &element, index);
+    dflist_s_remove_at(list_s, (size_t)rand() % n);
+    sum += *(int *)dflist_s_get(list_s, (size_t)rand() % n).value;
+  }
+  bench_report("get/insert_at/remove_at (DfList_S)", start, bench_now_ns(), 3 * BENCH_LINEAR_OPS);
+
+  srand(3);
+  start = bench_now_ns();
+  for (int i = 0; i < BENCH_LINEAR_OPS; i++)
+  {
+    size_t index = (size_t)rand() % n;
+    dflist_u_insert_at(list_u, &element, index);
+    dflist_u_remove_at(list_u, (size_t)rand() % n);
+    sum += *(int *)dflist_u_get(list_u, (size_t)rand() % n).value;
+  }
+  bench_report("get/insert_at/remove_at (DfList_U)", start, bench_now_ns(), 3 * BENCH_LINEAR_OPS);
+
+  srand(3);
+  start = bench_now_ns();
+  for (int i = 0; i < BENCH_SKIP_OPS; i++)
+  {
+    size_t index = (size_t)rand() % n;
+    dfskiplist_insert_at(skip, &element, index);
+    dfskiplist_remove_at(skip, (size_t)rand() % n);
+    sum += *(int *)dfskiplist_get(skip, (size_t)rand() % n).value;
+  }
+  bench_report("get/insert_at/remove_at (DfSkipList)", start, bench_now_ns(), 3 * BENCH_SKIP_OPS);
+
+  start = bench_now_ns();
+  Iterator *it = dfskiplist_iterator_create(skip).value;
+  while (it->has_next(it))
+  {
+    sum += *(int *)it->next(it).value;
+  }
+  bench_report("iterate (DfSkipList)", start, bench_now_ns(), n);
+  iterator_destroy(it);
+  free(it);
+  bench_sink = sum;
+
+  dflist_s_destroy(list_s, NULL);
+  dflist_u_destroy(list_u, NULL);
+  dfskiplist_destroy(skip, NULL);
+  return 0;
+}
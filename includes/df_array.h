@@ -2,13 +2,72 @@
 #define ARRAY_H
 
 #include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "df_iterator.h"
 #include "df_common.h"
 
 typedef struct DfArray DfArray;
 
+// Upper bound on the DfArray header, used to size storage for dfarray_init_inline
+#define DFARRAY_HEADER_SIZE 192
+
+// Bytes of storage needed to hold a DfArray header plus count inline elements
+#define DFARRAY_INLINE_STORAGE_SIZE(elem_size, count) (DFARRAY_HEADER_SIZE + (elem_size) * (count))
+
+// Declares suitably aligned storage for dfarray_init_inline, e.g. on the stack or inside a struct
+#define DFARRAY_INLINE_STORAGE(name, elem_size, count) \
+    _Alignas(max_align_t) unsigned char name[DFARRAY_INLINE_STORAGE_SIZE(elem_size, count)]
+
+// Capacity used for the first allocation of an array created empty
+#define DFARRAY_DEFAULT_CAPACITY 5
+
+// Controls how an array grows and shrinks
+typedef struct DfArray_Policy
+{
+    double growth_factor;  // Capacity multiplier when the array is full (> 1.0)
+    size_t shrink_divisor; // Shrink once length <= capacity / shrink_divisor
+    double shrink_slack;   // Capacity kept after shrinking, as a multiple of length (>= 1.0)
+    size_t min_capacity;   // Capacity never shrinks below this
+    bool never_shrink;     // Disable automatic shrinking on pop, shift and remove
+    size_t mmap_threshold; // Storage of at least this many bytes is an anonymous mapping, 0 disables (Linux only)
+    bool huge_pages;       // Ask for transparent huge pages on mapped storage
+} DfArray_Policy;
+
+// Storage size at which arrays switch from the heap to mremap-grown mappings
+#define DFARRAY_MMAP_THRESHOLD ((size_t)64 << 20)
+
+// Doubles on growth and shrinks to fit at half capacity
+#define DFARRAY_POLICY_DEFAULT ((DfArray_Policy){2.0, 2, 1.0, 0, false, DFARRAY_MMAP_THRESHOLD, false})
+
+typedef struct DfArray_Stats
+{
+    size_t reallocs; // Storage reallocations of any kind
+    size_t grows;    // Reallocations that increased capacity
+    size_t shrinks;  // Reallocations that decreased capacity
+    size_t remaps;   // Reallocations of mapped storage, done without copying elements
+} DfArray_Stats;
+
+// Borrowed view over the array storage, valid until the next call that changes the array
+typedef struct DfArray_Span
+{
+    void *data;
+    size_t length;
+    size_t elem_size;
+    size_t stride; // Bytes from one element to the next, elem_size unless the array is padded
+} DfArray_Span;
+
 DfResult dfarray_create(size_t elem_size, size_t initial_capacity);
 
+DfResult dfarray_create_with_policy(size_t elem_size, size_t initial_capacity, const DfArray_Policy *policy);
+
+DfResult dfarray_create_aligned(size_t elem_size, size_t initial_capacity, size_t alignment, size_t stride);
+
+DfResult dfarray_create_inline(size_t elem_size, size_t inline_count);
+
+DfResult dfarray_init_inline(void *storage, size_t storage_size, size_t elem_size);
+
 DfResult dfarray_destroy(DfArray *array);
 
 DfResult dfarray_get(DfArray *array, size_t index);
@@ -29,13 +88,85 @@ DfResult dfarray_remove_at(DfArray *array, size_t index);
 
 DfResult dfarray_length(DfArray *array);
 
+// Capacity policy
+
+DfResult dfarray_set_policy(DfArray *array, const DfArray_Policy *policy);
+
+DfResult dfarray_get_policy(DfArray *array, DfArray_Policy *policy);
+
+DfResult dfarray_reserve(DfArray *array, size_t capacity);
+
+DfResult dfarray_ensure_capacity(DfArray *array, size_t needed);
+
+DfResult dfarray_shrink_to_fit(DfArray *array);
+
+DfResult dfarray_stats(DfArray *array, DfArray_Stats *stats);
+
+// Borrowed access
+
+DfResult dfarray_at(DfArray *array, size_t index);
+
+DfResult dfarray_front(DfArray *array);
+
+DfResult dfarray_back(DfArray *array);
+
+DfResult dfarray_span(DfArray *array, DfArray_Span *span);
+
+DfResult dfarray_pop_into(DfArray *array, void *dest);
+
+DfResult dfarray_shift_into(DfArray *array, void *dest);
+
+// Range operations
+
+DfResult dfarray_append_n(DfArray *array, void *values, size_t count);
+
+DfResult dfarray_insert_range(DfArray *array, size_t index, void *values, size_t count);
+
+DfResult dfarray_remove_range(DfArray *array, size_t index, size_t count);
+
+DfResult dfarray_extend(DfArray *array, Iterator *it);
+
+// Sort & search
+
+// Key layouts understood by dfarray_radix_sort
+typedef enum
+{
+    DF_KEY_U32,
+    DF_KEY_I32,
+    DF_KEY_U64,
+    DF_KEY_I64,
+    DF_KEY_F32,
+    DF_KEY_F64,
+} DfKey_Type;
+
+DfResult dfarray_sort(DfArray *array, int (*cmp)(const void *a, const void *b));
+
+DfResult dfarray_radix_sort(DfArray *array, DfKey_Type key_type, size_t key_offset);
+
+DfResult dfarray_radix_sort_by(DfArray *array, uint64_t (*key)(const void *element));
+
+DfResult dfarray_lower_bound(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b));
+
+DfResult dfarray_upper_bound(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b));
+
+DfResult dfarray_binary_search(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b));
+
 // Iterator
 typedef struct DfArray_Iterator DfArray_Iterator;
 
 DfResult dfarray_iterator_create(DfArray *array);
 
+// Fills a caller-provided Iterator without allocating
+DfResult dfarray_iterator_init(Iterator *it, DfArray *array);
+
 int dfarray_iterator_has_next(Iterator *it);
 
 DfResult dfarray_iterator_next(Iterator *it);
 
+DfResult dfarray_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+size_t dfarray_iterator_remaining(Iterator *it);
+
+DfResult dfarray_iterator_span_at(Iterator *it, size_t offset, DfSpan *span, size_t max);
+
 #endif
@@ -0,0 +1,145 @@
+#ifndef ARRAY_TYPED_H
+#define ARRAY_TYPED_H
+
+#include <stddef.h>
+#include "df_array.h"
+#include "df_common.h"
+
+// Leading fields of DfArray, kept in sync with src/df_array.c
+typedef struct DfArray_Header
+{
+    void *items;
+    size_t length;
+    size_t elem_size;
+    size_t capacity;
+    size_t stride;
+} DfArray_Header;
+
+// Generates static inline accessors for a DfArray holding elements of type T.
+// The functions work on any unpadded DfArray created with elem_size == sizeof(T), including
+// arrays built through the untyped API, and grow through the same policy as dfarray_push.
+//
+//   DF_ARRAY_DEFINE(int32_t, i32)
+//   DfArray *array = dfarray_i32_create(16).value;
+//   dfarray_i32_push(array, 42);
+#define DF_ARRAY_DEFINE(T, suffix)                                                               \
+    static inline DfResult dfarray_##suffix##_create(size_t initial_capacity)                    \
+    {                                                                                            \
+        return dfarray_create(sizeof(T), initial_capacity);                                      \
+    }                                                                                            \
+                                                                                                 \
+    static inline DfResult dfarray_##suffix##_check(DfArray *array)                              \
+    {                                                                                            \
+        DfResult res = {DF_OK, NULL};                                                            \
+        if (!array)                                                                              \
+        {                                                                                        \
+            res.error = DF_ERR_NULL_PTR;                                                         \
+        }                                                                                        \
+        else if (((DfArray_Header *)array)->elem_size != sizeof(T) ||                            \
+                 ((DfArray_Header *)array)->stride != sizeof(T))                                 \
+        {                                                                                        \
+            res.error = DF_ERR_SIZE_MISMATCH;                                                    \
+        }                                                                                        \
+        return res;                                                                              \
+    }                                                                                            \
+                                                                                                 \
+    static inline T *dfarray_##suffix##_data(DfArray *array)                                     \
+    {                                                                                            \
+        return (T *)((DfArray_Header *)array)->items;                                            \
+    }                                                                                            \
+                                                                                                 \
+    static inline size_t dfarray_##suffix##_length(DfArray *array)                               \
+    {                                                                                            \
+        return ((DfArray_Header *)array)->length;                                                \
+    }                                                                                            \
+                                                                                                 \
+    static inline DfResult dfarray_##suffix##_push(DfArray *array, T value)                      \
+    {                                                                                            \
+        DfResult res = dfarray_##suffix##_check(array);                                          \
+        if (res.error)                                                                           \
+        {                                                                                        \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        DfArray_Header *header = (DfArray_Header *)array;                                        \
+        if (header->length >= header->capacity)                                                  \
+        {                                                                                        \
+            DfResult grow_res = dfarray_ensure_capacity(array, header->length + 1);              \
+            if (grow_res.error)                                                                  \
+            {                                                                                    \
+                return grow_res;                                                                 \
+            }                                                                                    \
+        }                                                                                        \
+                                                                                                 \
+        ((T *)header->items)[header->length++] = value;                                          \
+        return res;                                                                              \
+    }                                                                                            \
+                                                                                                 \
+    static inline DfResult dfarray_##suffix##_get(DfArray *array, size_t index, T *out)          \
+    {                                                                                            \
+        DfResult res = dfarray_##suffix##_check(array);                                          \
+        if (res.error)                                                                           \
+        {                                                                                        \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        DfArray_Header *header = (DfArray_Header *)array;                                        \
+        if (index >= header->length)                                                             \
+        {                                                                                        \
+            res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;                                              \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        *out = ((T *)header->items)[index];                                                      \
+        return res;                                                                              \
+    }                                                                                            \
+                                                                                                 \
+    static inline DfResult dfarray_##suffix##_set(DfArray *array, size_t index, T value)         \
+    {                                                                                            \
+        DfResult res = dfarray_##suffix##_check(array);                                          \
+        if (res.error)                                                                           \
+        {                                                                                        \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        DfArray_Header *header = (DfArray_Header *)array;                                        \
+        if (index >= header->length)                                                             \
+        {                                                                                        \
+            res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;                                              \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        ((T *)header->items)[index] = value;                                                     \
+        return res;                                                                              \
+    }                                                                                            \
+                                                                                                 \
+    static inline DfResult dfarray_##suffix##_pop(DfArray *array, T *out)                        \
+    {                                                                                            \
+        DfResult res = dfarray_##suffix##_check(array);                                          \
+        if (res.error)                                                                           \
+        {                                                                                        \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        /* Shrinking follows the array policy, so defer to the untyped path */                   \
+        return dfarray_pop_into(array, out);                                                     \
+    }                                                                                            \
+                                                                                                 \
+    static inline DfResult dfarray_##suffix##_for_each(DfArray *array, void (*func)(T *element)) \
+    {                                                                                            \
+        DfResult res = dfarray_##suffix##_check(array);                                          \
+        if (res.error)                                                                           \
+        {                                                                                        \
+            return res;                                                                          \
+        }                                                                                        \
+                                                                                                 \
+        DfArray_Header *header = (DfArray_Header *)array;                                        \
+        T *items = (T *)header->items;                                                           \
+        for (size_t i = 0; i < header->length; i++)                                              \
+        {                                                                                        \
+            func(&items[i]);                                                                     \
+        }                                                                                        \
+        return res;                                                                              \
+    }
+
+#endif
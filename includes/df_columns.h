@@ -0,0 +1,51 @@
+#ifndef COLUMNS_H
+#define COLUMNS_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "df_array.h"
+#include "df_common.h"
+#include "df_iterator.h"
+
+// Structure of arrays: each column is a DfArray holding one field of every row
+typedef struct DfColumns DfColumns;
+
+DfResult dfcolumns_create(const size_t *elem_sizes, size_t column_count, size_t initial_capacity);
+
+DfResult dfcolumns_destroy(DfColumns *columns);
+
+DfResult dfcolumns_append_row(DfColumns *columns, const void *const *values);
+
+DfResult dfcolumns_reserve(DfColumns *columns, size_t rows);
+
+DfResult dfcolumns_length(DfColumns *columns);
+
+DfResult dfcolumns_column_count(DfColumns *columns);
+
+// Column access
+
+DfResult dfcolumns_column(DfColumns *columns, size_t column);
+
+DfResult dfcolumns_at(DfColumns *columns, size_t column, size_t row);
+
+DfResult dfcolumns_span(DfColumns *columns, size_t column, DfArray_Span *span);
+
+DfResult dfcolumns_data(DfColumns *columns, size_t column, size_t elem_size);
+
+// Typed pointer to a column's storage, NULL if the column does not hold T
+#define DFCOLUMNS_DATA(columns, column, T) ((T *)dfcolumns_data((columns), (column), sizeof(T)).value)
+
+// Column scans
+// A selection is a DfArray of size_t row indices in ascending order, NULL selects every row
+
+DfResult dfcolumns_filter(DfColumns *columns, size_t column, DfArray *selection, bool (*func)(const void *element));
+
+DfResult dfcolumns_reduce(DfColumns *columns, size_t column, DfArray *selection, void *accumulator, void (*func)(void *accumulator, const void *element));
+
+// Iterator
+
+DfResult dfcolumns_iterator_create(DfColumns *columns, size_t column);
+
+DfResult dfcolumns_iterator_init(Iterator *it, DfColumns *columns, size_t column);
+
+#endif
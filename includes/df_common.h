@@ -12,6 +12,9 @@ typedef enum
     DF_ERR_ALREADY_FREED,
     DF_ERR_ELEMENT_NOT_FOUND,
     DF_ERR_END_OF_LIST,
+    DF_ERR_SIZE_MISMATCH,
+    DF_ERR_FULL,
+    DF_ERR_INCOMPATIBLE,
 } DfError;
 
 const char *df_error_to_string(DfError err);
@@ -0,0 +1,60 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stdlib.h>
+#include "df_common.h"
+#include "df_iterator.h"
+
+// Smallest capacity a deque allocates, always a power of two
+#define DFDEQUE_MIN_CAPACITY 8
+
+typedef struct DfDeque DfDeque;
+
+DfResult dfdeque_create(size_t elem_size, size_t initial_capacity);
+
+DfResult dfdeque_destroy(DfDeque *deque);
+
+DfResult dfdeque_push_back(DfDeque *deque, void *value);
+
+DfResult dfdeque_push_front(DfDeque *deque, void *value);
+
+DfResult dfdeque_pop_back(DfDeque *deque);
+
+DfResult dfdeque_pop_front(DfDeque *deque);
+
+DfResult dfdeque_pop_back_into(DfDeque *deque, void *dest);
+
+DfResult dfdeque_pop_front_into(DfDeque *deque, void *dest);
+
+DfResult dfdeque_peek_front(DfDeque *deque);
+
+DfResult dfdeque_peek_back(DfDeque *deque);
+
+DfResult dfdeque_at(DfDeque *deque, size_t index);
+
+DfResult dfdeque_set(DfDeque *deque, size_t index, void *value);
+
+DfResult dfdeque_length(DfDeque *deque);
+
+DfResult dfdeque_capacity(DfDeque *deque);
+
+// Iterator
+
+typedef struct DfDeque_Iterator DfDeque_Iterator;
+
+DfResult dfdeque_iterator_create(DfDeque *deque);
+
+// Fills a caller-provided Iterator without allocating
+DfResult dfdeque_iterator_init(Iterator *it, DfDeque *deque);
+
+int dfdeque_iterator_has_next(Iterator *it);
+
+DfResult dfdeque_iterator_next(Iterator *it);
+
+DfResult dfdeque_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+size_t dfdeque_iterator_remaining(Iterator *it);
+
+DfResult dfdeque_iterator_span_at(Iterator *it, size_t offset, DfSpan *span, size_t max);
+
+#endif
@@ -2,8 +2,33 @@
 #define DF_ITERATOR_H
 
 #include <stdlib.h>
+#include <stddef.h>
 #include "df_common.h"
 
+// Most elements a gathered batch holds; iterators that hand out storage directly may return more
+#define DF_ITERATOR_BATCH 64
+
+// Room for structure-specific iterator state inside the Iterator itself (a gather buffer plus a few fields)
+#define DF_ITERATOR_STATE_SIZE (DF_ITERATOR_BATCH * sizeof(void *) + 64)
+
+// A run of elements returned by next_batch, valid until the iterator is advanced again
+typedef struct DfSpan
+{
+    void *items;   // First element, or an array of element pointers when stride is 0
+    size_t count;  // Elements in the span, 0 once the iterator is exhausted
+    size_t stride; // Bytes between consecutive elements
+} DfSpan;
+
+// Pointer to element i of a span
+static inline void *df_span_at(const DfSpan *span, size_t i)
+{
+    if (span->stride == 0)
+    {
+        return ((void **)span->items)[i];
+    }
+    return (char *)span->items + i * span->stride;
+}
+
 typedef struct Iterator
 {
     void *structure; // Pointer to the data structure
@@ -15,10 +40,25 @@ typedef struct Iterator
     DfResult (*insert_new)(void *new_ds, void *element); // Insert an element into the new ds
     size_t (*elem_size)(struct Iterator *);              // Return size_t for elements
     DfResult (*free_all)(struct Iterator *);             // Free the iterator and all resources
+
+    // Optional: fill span with up to max elements and advance past them, NULL when unsupported
+    DfResult (*next_batch)(struct Iterator *, DfSpan *span, size_t max);
+
+    // Optional random access, NULL for sequential structures: elements left to iterate, and a span
+    // of up to max elements starting offset elements past the current position, without advancing
+    size_t (*remaining)(struct Iterator *);
+    DfResult (*span_at)(struct Iterator *, size_t offset, DfSpan *span, size_t max);
+
+    // Embedded state used by the *_iterator_init functions, so iterators can live on the stack
+    max_align_t state[(DF_ITERATOR_STATE_SIZE + sizeof(max_align_t) - 1) / sizeof(max_align_t)];
 } Iterator;
 
 DfResult iterator_create();
 
+// Releases state the iterator allocated; the Iterator itself stays with the caller
 DfResult iterator_destroy(Iterator *it);
 
+// Destroys an iterator returned by a *_iterator_create function and frees the Iterator too
+DfResult iterator_free(Iterator *it);
+
 #endif
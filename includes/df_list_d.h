@@ -0,0 +1,70 @@
+#ifndef LIST_D_H
+#define LIST_D_H
+
+#include "df_common.h"
+#include "df_iterator.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct DfList_D DfList_D;
+
+// Node handles returned by the push and insert functions stay valid until the element is removed
+typedef struct DfList_D_Node DfList_D_Node;
+
+DfResult dflist_d_create();
+
+DfResult dflist_d_destroy(DfList_D *list, void (*cleanup)(void *element));
+
+DfResult dflist_d_push_back(DfList_D *list, void *element);
+
+DfResult dflist_d_push_front(DfList_D *list, void *element);
+
+DfResult dflist_d_pop_front(DfList_D *list);
+
+DfResult dflist_d_pop_back(DfList_D *list);
+
+DfResult dflist_d_insert_at(DfList_D *list, void *element, size_t index);
+
+DfResult dflist_d_remove_at(DfList_D *list, size_t index);
+
+DfResult dflist_d_get(DfList_D *list, size_t index);
+
+DfResult dflist_d_peek_front(DfList_D *list);
+
+DfResult dflist_d_peek_back(DfList_D *list);
+
+DfResult dflist_d_length(DfList_D *list);
+
+// Opt-in prefetching for iterators and destroy, as dflist_s_set_prefetch
+DfResult dflist_d_set_prefetch(DfList_D *list, size_t distance, bool elements);
+
+// Node handles
+
+DfResult dflist_d_insert_before(DfList_D *list, DfList_D_Node *node, void *element);
+
+DfResult dflist_d_insert_after(DfList_D *list, DfList_D_Node *node, void *element);
+
+DfResult dflist_d_unlink(DfList_D *list, DfList_D_Node *node);
+
+DfResult dflist_d_node_element(DfList_D_Node *node);
+
+// Iterator
+
+typedef struct DfList_D_Iterator DfList_D_Iterator;
+
+DfResult dflist_d_iterator_create(DfList_D *list);
+
+DfResult dflist_d_iterator_create_reverse(DfList_D *list);
+
+// Fill a caller-provided Iterator without allocating
+DfResult dflist_d_iterator_init(Iterator *it, DfList_D *list);
+
+DfResult dflist_d_iterator_init_reverse(Iterator *it, DfList_D *list);
+
+int dflist_d_iterator_has_next(Iterator *it);
+
+DfResult dflist_d_iterator_next(Iterator *it);
+
+DfResult dflist_d_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+#endif
@@ -3,7 +3,16 @@
 
 #include "df_common.h"
 #include "df_iterator.h"
+#include "df_slab.h"
 #include <stdlib.h>
+#include <stdbool.h>
+
+// Nodes per chunk in the pool dflist_s_create_pooled creates for a list, and in
+// dflist_s_pool_create(0)
+#define DFLIST_S_POOL_CHUNK_NODES 1024
+
+// A reasonable prefetch distance for dflist_s_set_prefetch on lists much larger than the cache
+#define DFLIST_PREFETCH_DEFAULT_DISTANCE 8
 
 typedef struct DfList_S DfList_S;
 
@@ -11,6 +20,13 @@ typedef struct DfList_S_Node DfList_S_Node;
 
 DfResult dflist_s_create();
 
+// A DfSlab sized for list nodes, to share between lists with dflist_s_create_pooled
+DfResult dflist_s_pool_create(size_t nodes_per_chunk);
+
+DfResult dflist_s_create_pooled(DfSlab *pool);
+
+DfResult dflist_s_pool(DfList_S *list);
+
 DfResult dflist_s_destroy(DfList_S *list, void (*cleanup)(void *element));
 
 DfResult dflist_s_push_back(DfList_S *list, void *element);
@@ -33,14 +49,71 @@ DfResult dflist_s_peek_back(DfList_S *list);
 
 DfResult dflist_s_length(DfList_S *list);
 
+// Opt-in prefetching for iterators and destroy: traversals keep a runner `distance` nodes
+// ahead and prefetch each node it reaches, and the node's element too when `elements` is set.
+// A distance of 0 turns prefetching off again.
+DfResult dflist_s_set_prefetch(DfList_S *list, size_t distance, bool elements);
+
+// Relinking: nodes move between lists without being copied or reallocated.
+// Both lists must allocate nodes the same way (malloc, or one shared DfSlab);
+// a list that owns its private pool cannot give nodes away.
+
+DfResult dflist_s_concat(DfList_S *list, DfList_S *other);
+
+DfResult dflist_s_splice_at(DfList_S *list, DfList_S *other, size_t index);
+
+DfResult dflist_s_split_at(DfList_S *list, size_t index);
+
+// Sorting: cmp receives the stored element pointers. Nodes are relinked, never allocated.
+
+DfResult dflist_s_sort(DfList_S *list, int (*cmp)(const void *a, const void *b));
+
+DfResult dflist_s_merge(DfList_S *list, DfList_S *other, int (*cmp)(const void *a, const void *b));
+
 // Iterator
 
 typedef struct DfList_S_Iterator DfList_S_Iterator;
 
 DfResult dflist_s_iterator_create(DfList_S *list);
 
+// Fills a caller-provided Iterator without allocating
+DfResult dflist_s_iterator_init(Iterator *it, DfList_S *list);
+
 int dflist_s_iterator_has_next(Iterator *it);
 
 DfResult dflist_s_iterator_next(Iterator *it);
 
+DfResult dflist_s_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+DfResult dflist_s_split_at_iterator(DfList_S *list, Iterator *it);
+
+// Cursor: a read-write position for single-pass edits. Every cursor operation is O(1).
+// Only edit the list through the cursor while it is in use. push_back is fine (a cursor at the
+// end then sits on the new element). push_front is fine unless the cursor is on the head: the
+// cursor tracks the node before it, so it moves onto the newly pushed element.
+
+typedef struct DfList_S_Cursor DfList_S_Cursor;
+
+DfResult dflist_s_cursor_create(DfList_S *list);
+
+DfResult dflist_s_cursor_destroy(DfList_S_Cursor *cursor);
+
+DfResult dflist_s_cursor_reset(DfList_S_Cursor *cursor);
+
+bool dflist_s_cursor_at_end(DfList_S_Cursor *cursor);
+
+DfResult dflist_s_cursor_get(DfList_S_Cursor *cursor);
+
+DfResult dflist_s_cursor_advance(DfList_S_Cursor *cursor);
+
+DfResult dflist_s_cursor_replace(DfList_S_Cursor *cursor, void *element);
+
+DfResult dflist_s_cursor_insert_before(DfList_S_Cursor *cursor, void *element);
+
+DfResult dflist_s_cursor_insert_after(DfList_S_Cursor *cursor, void *element);
+
+DfResult dflist_s_cursor_remove(DfList_S_Cursor *cursor);
+
+DfResult dflist_s_cursor_remove_after(DfList_S_Cursor *cursor);
+
 #endif
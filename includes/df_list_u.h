@@ -0,0 +1,58 @@
+#ifndef LIST_U_H
+#define LIST_U_H
+
+#include "df_common.h"
+#include "df_iterator.h"
+#include <stdlib.h>
+
+// Unrolled linked list: each node stores up to DFLIST_U_NODE_CAPACITY element
+// pointers contiguously, so a walk touches one node per block of elements
+typedef struct DfList_U DfList_U;
+
+typedef struct DfList_U_Node DfList_U_Node;
+
+// Element slots per node, sized so a node fills four cache lines
+#define DFLIST_U_NODE_CAPACITY 29
+
+DfResult dflist_u_create();
+
+DfResult dflist_u_destroy(DfList_U *list, void (*cleanup)(void *element));
+
+DfResult dflist_u_push_back(DfList_U *list, void *element);
+
+DfResult dflist_u_push_front(DfList_U *list, void *element);
+
+DfResult dflist_u_pop_front(DfList_U *list);
+
+DfResult dflist_u_pop_back(DfList_U *list);
+
+DfResult dflist_u_insert_at(DfList_U *list, void *element, size_t index);
+
+DfResult dflist_u_remove_at(DfList_U *list, size_t index);
+
+DfResult dflist_u_get(DfList_U *list, size_t index);
+
+DfResult dflist_u_peek_front(DfList_U *list);
+
+DfResult dflist_u_peek_back(DfList_U *list);
+
+DfResult dflist_u_length(DfList_U *list);
+
+DfResult dflist_u_node_count(DfList_U *list);
+
+// Iterator
+
+typedef struct DfList_U_Iterator DfList_U_Iterator;
+
+DfResult dflist_u_iterator_create(DfList_U *list);
+
+// Fills a caller-provided Iterator without allocating
+DfResult dflist_u_iterator_init(Iterator *it, DfList_U *list);
+
+int dflist_u_iterator_has_next(Iterator *it);
+
+DfResult dflist_u_iterator_next(Iterator *it);
+
+DfResult dflist_u_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+#endif
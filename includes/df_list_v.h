@@ -0,0 +1,67 @@
+#ifndef LIST_V_H
+#define LIST_V_H
+
+#include "df_common.h"
+#include "df_iterator.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Singly linked list that stores elements by value: each node is one allocation holding
+// the link and elem_size bytes of payload. Pushes copy in, accessors return pointers into
+// the node that stay valid until that element is removed.
+typedef struct DfList_V DfList_V;
+
+typedef struct DfList_V_Node DfList_V_Node;
+
+DfResult dflist_v_create(size_t elem_size);
+
+DfResult dflist_v_destroy(DfList_V *list);
+
+// Opt-in prefetching for iterators and destroy, as dflist_s_set_prefetch. Payloads live in the
+// nodes, so `elements` requests every cache line of a node rather than only its first.
+DfResult dflist_v_set_prefetch(DfList_V *list, size_t distance, bool elements);
+
+DfResult dflist_v_push_back(DfList_V *list, void *value);
+
+DfResult dflist_v_push_front(DfList_V *list, void *value);
+
+DfResult dflist_v_pop_front(DfList_V *list);
+
+DfResult dflist_v_pop_back(DfList_V *list);
+
+DfResult dflist_v_pop_front_into(DfList_V *list, void *dest);
+
+DfResult dflist_v_pop_back_into(DfList_V *list, void *dest);
+
+DfResult dflist_v_insert_at(DfList_V *list, void *value, size_t index);
+
+DfResult dflist_v_remove_at(DfList_V *list, size_t index, void *dest);
+
+DfResult dflist_v_get(DfList_V *list, size_t index);
+
+DfResult dflist_v_set(DfList_V *list, size_t index, void *value);
+
+DfResult dflist_v_peek_front(DfList_V *list);
+
+DfResult dflist_v_peek_back(DfList_V *list);
+
+DfResult dflist_v_length(DfList_V *list);
+
+DfResult dflist_v_elem_size(DfList_V *list);
+
+// Iterator
+
+typedef struct DfList_V_Iterator DfList_V_Iterator;
+
+DfResult dflist_v_iterator_create(DfList_V *list);
+
+// Fills a caller-provided Iterator without allocating
+DfResult dflist_v_iterator_init(Iterator *it, DfList_V *list);
+
+int dflist_v_iterator_has_next(Iterator *it);
+
+DfResult dflist_v_iterator_next(Iterator *it);
+
+DfResult dflist_v_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include "df_common.h"
+#include <stdlib.h>
+
+// Work-stealing thread pool. Each worker owns a Chase-Lev deque: tasks a worker submits go
+// on its own deque and run newest first, idle workers steal the oldest tasks from the others,
+// and tasks submitted from outside the pool go through a shared lock-free queue.
+typedef struct DfPool DfPool;
+
+// Counts outstanding tasks; waiting on it from a worker runs other tasks instead of blocking
+typedef struct DfWait_Group DfWait_Group;
+
+// Chunks parallel_for aims to give each worker when grain is 0
+#define DFPOOL_CHUNKS_PER_WORKER 8
+
+// Totals across all workers since the pool was created
+typedef struct DfPool_Stats
+{
+    size_t workers;
+    size_t submitted;
+    size_t executed;
+    size_t steals;        // Tasks taken from another worker's deque
+    size_t failed_steals; // Steal attempts that found the victim empty or lost a race
+    size_t idle_sleeps;   // Times a worker found nothing to do and went to sleep
+} DfPool_Stats;
+
+// workers 0 starts one worker per online CPU
+DfResult dfpool_create(size_t workers);
+
+// Runs every task already submitted, then stops and joins the workers
+DfResult dfpool_destroy(DfPool *pool);
+
+// group may be NULL; otherwise it is incremented here and decremented once the task has run
+DfResult dfpool_submit(DfPool *pool, void (*task)(void *arg), void *arg, DfWait_Group *group);
+
+// Calls body on disjoint subranges covering [begin, end), splitting ranges longer than grain
+// in half so idle workers can steal them; returns once every subrange is done
+DfResult dfpool_parallel_for(DfPool *pool, size_t begin, size_t end, size_t grain, void (*body)(size_t begin, size_t end, void *arg), void *arg);
+
+DfResult dfpool_stats(DfPool *pool, DfPool_Stats *stats);
+
+DfResult dfwaitgroup_create();
+
+DfResult dfwaitgroup_destroy(DfWait_Group *group);
+
+DfResult dfwaitgroup_add(DfWait_Group *group, size_t count);
+
+DfResult dfwaitgroup_done(DfWait_Group *group);
+
+// Returns once the count reaches zero; pool workers keep running tasks meanwhile
+DfResult dfwaitgroup_wait(DfWait_Group *group);
+
+#endif
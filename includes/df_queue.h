@@ -0,0 +1,34 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "df_common.h"
+#include <stdlib.h>
+
+// Lock-free multi-producer multi-consumer FIFO (Michael-Scott queue).
+// Push and pop may be called from any number of threads at once; create and
+// destroy must not race with anything else.
+typedef struct DfQueue DfQueue;
+
+typedef struct DfQueue_Node DfQueue_Node;
+
+// Threads that can be inside push/pop at the same time; extra threads wait for a free slot
+#define DFQUEUE_MAX_THREADS 64
+
+// Retired nodes a thread slot collects before it scans hazard pointers and frees them
+#define DFQUEUE_RETIRE_THRESHOLD (4 * DFQUEUE_MAX_THREADS)
+
+// capacity 0 makes the queue unbounded; otherwise push fails with DF_ERR_FULL once it is reached
+DfResult dfqueue_create(size_t capacity);
+
+DfResult dfqueue_destroy(DfQueue *queue, void (*cleanup)(void *element));
+
+DfResult dfqueue_push(DfQueue *queue, void *element);
+
+DfResult dfqueue_pop(DfQueue *queue);
+
+// Snapshot of the element count; may be stale by the time it is read under concurrency
+DfResult dfqueue_length(DfQueue *queue);
+
+DfResult dfqueue_capacity(DfQueue *queue);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include "df_common.h"
+#include "df_iterator.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+// Indexable skip list: every forward link records how many elements it spans,
+// so get/insert_at/remove_at find a position in O(log n) expected time
+typedef struct DfSkipList DfSkipList;
+
+typedef struct DfSkipList_Node DfSkipList_Node;
+
+// Highest level a node can reach; with a 1/4 promotion chance this covers 4^16 elements
+#define DFSKIPLIST_MAX_LEVEL 16
+
+DfResult dfskiplist_create();
+
+DfResult dfskiplist_destroy(DfSkipList *list, void (*cleanup)(void *element));
+
+// Opt-in prefetching for iterators and destroy along the bottom level, as dflist_s_set_prefetch
+DfResult dfskiplist_set_prefetch(DfSkipList *list, size_t distance, bool elements);
+
+DfResult dfskiplist_push_back(DfSkipList *list, void *element);
+
+DfResult dfskiplist_push_front(DfSkipList *list, void *element);
+
+DfResult dfskiplist_pop_front(DfSkipList *list);
+
+DfResult dfskiplist_pop_back(DfSkipList *list);
+
+DfResult dfskiplist_insert_at(DfSkipList *list, void *element, size_t index);
+
+DfResult dfskiplist_remove_at(DfSkipList *list, size_t index);
+
+DfResult dfskiplist_get(DfSkipList *list, size_t index);
+
+DfResult dfskiplist_peek_front(DfSkipList *list);
+
+DfResult dfskiplist_peek_back(DfSkipList *list);
+
+DfResult dfskiplist_length(DfSkipList *list);
+
+// Iterator
+
+typedef struct DfSkipList_Iterator DfSkipList_Iterator;
+
+DfResult dfskiplist_iterator_create(DfSkipList *list);
+
+// Fills a caller-provided Iterator without allocating
+DfResult dfskiplist_iterator_init(Iterator *it, DfSkipList *list);
+
+int dfskiplist_iterator_has_next(Iterator *it);
+
+DfResult dfskiplist_iterator_next(Iterator *it);
+
+DfResult dfskiplist_iterator_next_batch(Iterator *it, DfSpan *span, size_t max);
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdlib.h>
+#include "df_common.h"
+
+// Fixed-size object allocator: objects are carved out of large chunks and
+// recycled through a free list, and every chunk is released at once on destroy.
+// Not thread safe; a slab shared between structures must be used from one thread.
+typedef struct DfSlab DfSlab;
+
+// Objects carved from each chunk when 0 is passed to dfslab_create
+#define DFSLAB_DEFAULT_OBJECTS_PER_CHUNK 1024
+
+typedef struct DfSlab_Stats
+{
+    size_t allocs;        // Objects handed out
+    size_t frees;         // Objects returned
+    size_t live;          // Objects currently in use
+    size_t capacity;      // Objects the allocated chunks can hold
+    size_t chunks;        // Chunks requested from malloc
+    double fragmentation; // Share of capacity not in use, 0.0 to 1.0
+} DfSlab_Stats;
+
+DfResult dfslab_create(size_t object_size, size_t objects_per_chunk);
+
+DfResult dfslab_destroy(DfSlab *slab);
+
+DfResult dfslab_alloc(DfSlab *slab);
+
+DfResult dfslab_free(DfSlab *slab, void *object);
+
+DfResult dfslab_reset(DfSlab *slab);
+
+DfResult dfslab_object_size(DfSlab *slab);
+
+DfResult dfslab_stats(DfSlab *slab, DfSlab_Stats *stats);
+
+#endif
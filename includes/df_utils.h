@@ -2,13 +2,26 @@
 #define DF_UTILS_H
 
 #include "df_iterator.h"
+#include "df_array.h"
+#include "df_pool.h"
 #include "df_common.h"
 #include <stdbool.h>
 
+// Smallest chunk picked when DfParallel_Options.grain is 0
+#define DF_PARALLEL_MIN_GRAIN 4096
+
+typedef struct DfParallel_Options
+{
+    size_t threads; // Threads including the caller, 0 for one per online CPU
+    size_t grain;   // Elements per chunk, 0 to derive one from the length and thread count
+    DfPool *pool;   // Runs the chunks on this pool's workers instead of fresh threads; threads is then ignored
+} DfParallel_Options;
+
 DfResult df_map(Iterator *it, void *(*func)(void *element));
 
 DfResult df_filter(Iterator *it, bool (*func)(void *element));
 
+// Returns a borrowed pointer to the first match, valid until the source is modified; do not free it
 DfResult df_find(Iterator *it, bool (*func)(void *element));
 
 DfResult df_for_each(Iterator *it, void (*func)(void *element));
@@ -19,4 +32,37 @@ DfResult df_reduce(Iterator *it, void *initial, void (*func)(void *accumulator,
 
 DfResult df_free_all(Iterator *it);
 
+// Lazy adaptors: each wraps source iterators and does no work until it is pulled, so a
+// pipeline such as filter -> map -> reduce builds no intermediate structures. Adaptors
+// borrow their sources, which must outlive them; destroy an adaptor like any iterator.
+
+DfResult df_lazy_map(Iterator *source, void *(*func)(void *element));
+
+DfResult df_lazy_filter(Iterator *source, bool (*func)(void *element));
+
+DfResult df_lazy_take(Iterator *source, size_t count);
+
+DfResult df_lazy_skip(Iterator *source, size_t count);
+
+DfResult df_lazy_chain(Iterator *first, Iterator *second);
+
+DfResult df_lazy_zip(Iterator *left, Iterator *right, void *(*combine)(void *left, void *right));
+
+// Terminal: drains it into a new structure of the source's type
+DfResult df_collect(Iterator *it);
+
+// Parallel variants: random-access sources (span_at, e.g. DfArray and DfDeque) are split into
+// chunks of grain elements shared out across threads; other iterators run sequentially on the
+// calling thread. Callbacks run concurrently and must not share unsynchronized state. options may
+// be NULL for the defaults. The iterator is exhausted afterwards, as with the sequential versions.
+
+// Writes func's result for element i into slot i of output, which is resized to the source's length
+DfResult df_parallel_map(Iterator *it, DfArray *output, void (*func)(void *element, void *out), const DfParallel_Options *options);
+
+DfResult df_parallel_for_each(Iterator *it, void (*func)(void *element), const DfParallel_Options *options);
+
+// Every chunk starts from a copy of initial, so it must be an identity for combine; partials are
+// combined in order, so combine only needs to be associative
+DfResult df_parallel_reduce(Iterator *it, void *initial, void (*func)(void *accumulator, void *element), void (*combine)(void *accumulator, void *partial), const DfParallel_Options *options);
+
 #endif
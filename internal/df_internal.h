@@ -4,6 +4,7 @@
 #include "../includes/df_common.h"
 #include "../includes/df_array.h"
 #include "../includes/df_iterator.h"
+#include "../includes/df_deque.h"
 #include <stdlib.h>
 
 DfResult df_result_init();
@@ -14,10 +15,27 @@ void df_index_check_access(size_t index, size_t length, DfResult *res);
 
 void df_index_check_insert(size_t index, size_t length, DfResult *res);
 
+// Resets the iterator's callbacks and points current at its embedded state, which is returned
+void *iterator_prepare(Iterator *it, void *structure);
+
+// Read prefetch hint for linked traversals; compiles to nothing where unsupported
+#if defined(__GNUC__) || defined(__clang__)
+#define DF_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define DF_PREFETCH(addr) ((void)(addr))
+#endif
+
+// Line size assumed when prefetching objects that span several lines
+#define DF_CACHE_LINE 64
+
 DfResult dfarray_shrink(DfArray *array);
 
+DfResult dfarray_maybe_shrink(DfArray *array);
+
 DfResult dfarray_resize(DfArray *array);
 
+DfResult dfarray_set_length(DfArray *array, size_t length);
+
 DfResult dfarray_free_all(Iterator *it);
 
 DfResult dfarray_insert_new(void *new_ds, void *element);
@@ -26,4 +44,38 @@ DfResult dfarray_create_new(Iterator *it);
 
 size_t dfarray_elem_size(Iterator *it);
 
+DfResult dfdeque_free_all(Iterator *it);
+
+DfResult dfdeque_insert_new(void *new_ds, void *element);
+
+DfResult dfdeque_create_new(Iterator *it);
+
+size_t dfdeque_elem_size(Iterator *it);
+
+DfResult dflist_u_free_all(Iterator *it);
+
+DfResult dflist_u_insert_new(void *new_ds, void *element);
+
+DfResult dflist_u_create_new(Iterator *it);
+
+DfResult dflist_d_free_all(Iterator *it);
+
+DfResult dflist_d_insert_new(void *new_ds, void *element);
+
+DfResult dflist_d_create_new(Iterator *it);
+
+DfResult dfskiplist_free_all(Iterator *it);
+
+DfResult dfskiplist_insert_new(void *new_ds, void *element);
+
+DfResult dfskiplist_create_new(Iterator *it);
+
+DfResult dflist_v_free_all(Iterator *it);
+
+DfResult dflist_v_insert_new(void *new_ds, void *element);
+
+DfResult dflist_v_create_new(Iterator *it);
+
+size_t dflist_v_iterator_elem_size(Iterator *it);
+
 #endif
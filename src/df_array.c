@@ -1,11 +1,22 @@
+#ifdef __linux__
+#define _GNU_SOURCE // mremap
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include "../includes/df_array.h"
+#include "../includes/df_array_typed.h"
 #include "../includes/df_iterator.h"
 #include "../includes/df_common.h"
 #include "../internal/df_internal.h"
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 // Core functionality
 
 typedef struct DfArray
@@ -14,12 +25,361 @@ typedef struct DfArray
   size_t length;
   size_t elem_size;
   size_t capacity;
+  size_t stride;    // Bytes between consecutive elements, elem_size unless padded
+  size_t alignment; // Alignment of items, kept across every reallocation
+  DfArray_Policy policy;
+  DfArray_Stats stats;
+  size_t inline_capacity; // Elements that fit in inline_items
+  size_t mapped_bytes;    // Length of the mapping behind items when DFARRAY_FLAG_MAPPED is set
+  unsigned flags;
+  max_align_t inline_items[];
 } DfArray;
 
-DfResult dfarray_create(size_t elem_size, size_t initial_capacity)
+// Header lives in caller-provided storage and must not be freed
+#define DFARRAY_FLAG_EMBEDDED 0x1u
+// Items are an anonymous mapping rather than a heap block
+#define DFARRAY_FLAG_MAPPED 0x2u
+
+// Alignment malloc and realloc already guarantee
+#define DFARRAY_MALLOC_ALIGNMENT _Alignof(max_align_t)
+
+_Static_assert(offsetof(DfArray, items) == offsetof(DfArray_Header, items) &&
+                   offsetof(DfArray, length) == offsetof(DfArray_Header, length) &&
+                   offsetof(DfArray, elem_size) == offsetof(DfArray_Header, elem_size) &&
+                   offsetof(DfArray, capacity) == offsetof(DfArray_Header, capacity) &&
+                   offsetof(DfArray, stride) == offsetof(DfArray_Header, stride),
+               "DfArray_Header must match the leading fields of DfArray");
+_Static_assert(sizeof(DfArray) <= DFARRAY_HEADER_SIZE, "DFARRAY_HEADER_SIZE is too small for DfArray");
+
+static inline void *dfarray_slot(const DfArray *array, size_t index)
+{
+  return (char *)array->items + index * array->stride;
+}
+
+// Copies count elements between buffers that may be padded differently
+static void dfarray_copy_elements(void *dest, size_t dest_stride, const void *src, size_t src_stride, size_t elem_size, size_t count)
+{
+  if (dest_stride == elem_size && src_stride == elem_size)
+  {
+    memcpy(dest, src, count * elem_size);
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    memcpy((char *)dest + i * dest_stride, (const char *)src + i * src_stride, elem_size);
+  }
+}
+
+static inline bool dfarray_is_inline(const DfArray *array)
+{
+  return array->inline_capacity > 0 && array->items == (void *)array->inline_items;
+}
+
+static inline bool dfarray_is_mapped(const DfArray *array)
+{
+  return (array->flags & DFARRAY_FLAG_MAPPED) != 0;
+}
+
+#ifdef __linux__
+
+static size_t dfarray_page_round(size_t bytes)
+{
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  return (bytes + page - 1) & ~(page - 1);
+}
+
+// Mappings are page aligned, so larger alignments stay on the heap
+static bool dfarray_wants_mapping(const DfArray *array, size_t bytes)
+{
+  return array->policy.mmap_threshold > 0 && bytes >= array->policy.mmap_threshold &&
+         array->alignment <= (size_t)sysconf(_SC_PAGESIZE);
+}
+
+// MAP_NORESERVE so untouched capacity costs address space only, not commit charge
+static void *dfarray_map(const DfArray *array, size_t bytes)
+{
+  void *items = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (items == MAP_FAILED)
+  {
+    return NULL;
+  }
+
+#ifdef MADV_HUGEPAGE
+  if (array->policy.huge_pages)
+  {
+    madvise(items, bytes, MADV_HUGEPAGE);
+  }
+#endif
+
+  return items;
+}
+
+static void dfarray_unmap(void *items, size_t bytes)
+{
+  munmap(items, bytes);
+}
+
+// Resizes mapped storage without copying: mremap moves page tables, and
+// shrinking hands the tail pages back while keeping them reserved
+static DfResult dfarray_remap(DfArray *array, size_t new_capacity)
+{
+  DfResult res = df_result_init();
+
+  size_t used = dfarray_page_round(new_capacity * array->stride);
+
+  if (used > array->mapped_bytes)
+  {
+    void *items = mremap(array->items, array->mapped_bytes, used, MREMAP_MAYMOVE);
+    if (items == MAP_FAILED)
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+
+    array->items = items;
+    array->mapped_bytes = used;
+  }
+  else if (new_capacity < array->capacity)
+  {
+    size_t old_used = dfarray_page_round(array->capacity * array->stride);
+    if (old_used > used)
+    {
+      madvise((char *)array->items + used, old_used - used, MADV_DONTNEED);
+    }
+  }
+
+  return res;
+}
+
+#else
+
+static bool dfarray_wants_mapping(const DfArray *array, size_t bytes)
+{
+  (void)array;
+  (void)bytes;
+  return false;
+}
+
+static size_t dfarray_page_round(size_t bytes)
+{
+  return bytes;
+}
+
+static void *dfarray_map(const DfArray *array, size_t bytes)
+{
+  (void)array;
+  (void)bytes;
+  return NULL;
+}
+
+static void dfarray_unmap(void *items, size_t bytes)
+{
+  (void)items;
+  (void)bytes;
+}
+
+static DfResult dfarray_remap(DfArray *array, size_t new_capacity)
+{
+  (void)array;
+  (void)new_capacity;
+  DfResult res = df_result_init();
+  res.error = DF_ERR_ALLOC_FAILED;
+  return res;
+}
+
+#endif
+
+static void dfarray_release_items(DfArray *array)
+{
+  if (dfarray_is_mapped(array))
+  {
+    dfarray_unmap(array->items, array->mapped_bytes);
+    array->flags &= ~DFARRAY_FLAG_MAPPED;
+    array->mapped_bytes = 0;
+  }
+  else if (!dfarray_is_inline(array))
+  {
+    free(array->items);
+  }
+}
+
+static void dfarray_init_header(DfArray *array, size_t elem_size, const DfArray_Policy *policy)
+{
+  array->items = NULL;
+  array->length = 0;
+  array->elem_size = elem_size;
+  array->capacity = 0;
+  array->stride = elem_size;
+  array->alignment = DFARRAY_MALLOC_ALIGNMENT;
+  array->policy = *policy;
+  array->stats = (DfArray_Stats){0};
+  array->inline_capacity = 0;
+  array->mapped_bytes = 0;
+  array->flags = 0;
+}
+
+static DfResult dfarray_policy_check(const DfArray_Policy *policy)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check((void *)policy, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (policy->growth_factor <= 1.0 || policy->shrink_divisor == 0 || policy->shrink_slack < 1.0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+  }
+
+  return res;
+}
+
+// Copies the elements into new storage of the kind the policy asks for: a
+// mapping above the mmap threshold, an aligned or plain heap block otherwise
+static DfResult dfarray_relocate(DfArray *array, size_t new_capacity)
+{
+  DfResult res = df_result_init();
+
+  size_t bytes = new_capacity * array->stride;
+  size_t mapped_bytes = 0;
+  void *items = NULL;
+
+  if (dfarray_wants_mapping(array, bytes))
+  {
+    mapped_bytes = dfarray_page_round(bytes);
+    items = dfarray_map(array, mapped_bytes);
+  }
+  else if (array->alignment > DFARRAY_MALLOC_ALIGNMENT)
+  {
+    if (posix_memalign(&items, array->alignment, bytes > 0 ? bytes : array->alignment) != 0)
+    {
+      items = NULL;
+    }
+  }
+  else
+  {
+    items = malloc(bytes);
+  }
+
+  if (!items)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  size_t kept = array->length < new_capacity ? array->length : new_capacity;
+  if (kept > 0)
+  {
+    memcpy(items, array->items, kept * array->stride);
+  }
+
+  dfarray_release_items(array);
+  array->items = items;
+  array->capacity = new_capacity;
+  if (mapped_bytes > 0)
+  {
+    array->flags |= DFARRAY_FLAG_MAPPED;
+    array->mapped_bytes = mapped_bytes;
+  }
+
+  return res;
+}
+
+// Every change of capacity goes through here so the stats stay accurate
+static DfResult dfarray_set_capacity(DfArray *array, size_t new_capacity)
 {
   DfResult res = df_result_init();
 
+  size_t old_capacity = array->capacity;
+  size_t bytes = new_capacity * array->stride;
+
+  if (array->inline_capacity > 0 && new_capacity <= array->inline_capacity)
+  {
+    if (dfarray_is_inline(array))
+    {
+      return res;
+    }
+
+    memcpy(array->inline_items, array->items, array->length * array->stride);
+    dfarray_release_items(array);
+    array->items = array->inline_items;
+    array->capacity = array->inline_capacity;
+  }
+  else if (new_capacity == 0)
+  {
+    dfarray_release_items(array);
+    array->items = NULL;
+    array->capacity = 0;
+  }
+  else if (dfarray_is_mapped(array) && dfarray_wants_mapping(array, bytes))
+  {
+    res = dfarray_remap(array, new_capacity);
+    if (res.error)
+    {
+      return res;
+    }
+
+    array->capacity = new_capacity;
+    array->stats.remaps++;
+  }
+  else if (dfarray_is_inline(array) || dfarray_is_mapped(array) || dfarray_wants_mapping(array, bytes) ||
+           array->alignment > DFARRAY_MALLOC_ALIGNMENT)
+  {
+    // realloc cannot keep an alignment above the malloc default
+    res = dfarray_relocate(array, new_capacity);
+    if (res.error)
+    {
+      return res;
+    }
+  }
+  else
+  {
+    void *resized_items = realloc(array->items, bytes);
+    if (!resized_items)
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+
+    array->items = resized_items;
+    array->capacity = new_capacity;
+  }
+
+  array->stats.reallocs++;
+  array->stats.grows += array->capacity > old_capacity;
+  array->stats.shrinks += array->capacity < old_capacity;
+
+  return res;
+}
+
+static size_t dfarray_next_capacity(const DfArray *array, size_t needed)
+{
+  size_t new_capacity = array->capacity;
+  if (new_capacity == 0)
+  {
+    new_capacity = array->policy.min_capacity > DFARRAY_DEFAULT_CAPACITY ? array->policy.min_capacity : DFARRAY_DEFAULT_CAPACITY;
+  }
+
+  while (new_capacity < needed)
+  {
+    size_t grown = (size_t)((double)new_capacity * array->policy.growth_factor);
+    new_capacity = grown > new_capacity ? grown : new_capacity + 1;
+  }
+
+  return new_capacity;
+}
+
+static DfResult dfarray_create_layout(size_t elem_size, size_t initial_capacity, const DfArray_Policy *policy, size_t alignment, size_t stride)
+{
+  DfResult res = dfarray_policy_check(policy);
+  if (res.error)
+  {
+    return res;
+  }
+
   DfArray *array = malloc(sizeof(DfArray));
   if (!array)
   {
@@ -27,72 +387,147 @@ DfResult dfarray_create(size_t elem_size, size_t initial_capacity)
     return res;
   }
 
-  array->items = malloc(initial_capacity * elem_size);
-  if (!array->items)
+  if (initial_capacity < policy->min_capacity)
+  {
+    initial_capacity = policy->min_capacity;
+  }
+
+  dfarray_init_header(array, elem_size, policy);
+  array->stride = stride;
+  array->alignment = alignment;
+
+  // Large initial capacities start out mapped
+  DfResult alloc_res = dfarray_relocate(array, initial_capacity);
+  if (alloc_res.error)
   {
     free(array);
+    return alloc_res;
+  }
+
+  res.value = array;
+  return res;
+}
+
+DfResult dfarray_create_with_policy(size_t elem_size, size_t initial_capacity, const DfArray_Policy *policy)
+{
+  return dfarray_create_layout(elem_size, initial_capacity, policy, DFARRAY_MALLOC_ALIGNMENT, elem_size);
+}
+
+DfResult dfarray_create(size_t elem_size, size_t initial_capacity)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  return dfarray_create_with_policy(elem_size, initial_capacity, &policy);
+}
+
+DfResult dfarray_create_aligned(size_t elem_size, size_t initial_capacity, size_t alignment, size_t stride)
+{
+  DfResult res = df_result_init();
+
+  if (stride == 0)
+  {
+    stride = elem_size;
+  }
+
+  if (elem_size == 0 || stride < elem_size || alignment == 0 || (alignment & (alignment - 1)) != 0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  if (alignment < DFARRAY_MALLOC_ALIGNMENT)
+  {
+    alignment = DFARRAY_MALLOC_ALIGNMENT;
+  }
+
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  return dfarray_create_layout(elem_size, initial_capacity, &policy, alignment, stride);
+}
+
+DfResult dfarray_create_inline(size_t elem_size, size_t inline_count)
+{
+  DfResult res = df_result_init();
+
+  DfArray *array = malloc(offsetof(DfArray, inline_items) + inline_count * elem_size);
+  if (!array)
+  {
     res.error = DF_ERR_ALLOC_FAILED;
     return res;
   }
 
-  array->length = 0;
-  array->elem_size = elem_size;
-  array->capacity = initial_capacity;
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  dfarray_init_header(array, elem_size, &policy);
+  array->inline_capacity = inline_count;
+  array->items = inline_count > 0 ? (void *)array->inline_items : NULL;
+  array->capacity = inline_count;
 
   res.value = array;
   return res;
 }
 
-DfResult dfarray_destroy(DfArray *array)
+DfResult dfarray_init_inline(void *storage, size_t storage_size, size_t elem_size)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(array, &res);
+  df_null_ptr_check(storage, &res);
   if (res.error)
   {
     return res;
   }
 
-  free(array->items);
-  free(array);
+  if (storage_size < sizeof(DfArray) || elem_size == 0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  DfArray *array = (DfArray *)storage;
+  size_t inline_count = (storage_size - offsetof(DfArray, inline_items)) / elem_size;
 
-  res.error = DF_OK;
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  dfarray_init_header(array, elem_size, &policy);
+  array->inline_capacity = inline_count;
+  array->items = inline_count > 0 ? (void *)array->inline_items : NULL;
+  array->capacity = inline_count;
+  array->flags = DFARRAY_FLAG_EMBEDDED;
+
+  res.value = array;
   return res;
 }
 
-DfResult dfarray_resize(DfArray *array)
+DfResult dfarray_destroy(DfArray *array)
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(array, &res);
-
-  size_t new_capacity;
-  void *resized_items;
-
-  if (array->capacity == 0)
+  if (res.error)
   {
-    new_capacity = 5;
-    resized_items = malloc(new_capacity * array->elem_size);
+    return res;
   }
-  else
+
+  dfarray_release_items(array);
+  if (!(array->flags & DFARRAY_FLAG_EMBEDDED))
   {
-    new_capacity = array->capacity * 2;
-    resized_items = realloc(array->items, new_capacity * array->elem_size);
+    free(array);
   }
 
-  if (!resized_items)
+  res.error = DF_OK;
+  return res;
+}
+
+DfResult dfarray_resize(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
   {
-    res.error = DF_ERR_ALLOC_FAILED;
     return res;
   }
 
-  array->items = resized_items;
-  array->capacity = new_capacity;
-
-  return res;
+  return dfarray_set_capacity(array, dfarray_next_capacity(array, array->capacity + 1));
 }
 
-DfResult dfarray_shrink(DfArray *array)
+DfResult dfarray_ensure_capacity(DfArray *array, size_t needed)
 {
   DfResult res = df_result_init();
 
@@ -102,81 +537,662 @@ DfResult dfarray_shrink(DfArray *array)
     return res;
   }
 
-  if (array->length == 0)
+  if (needed <= array->capacity)
   {
-    free(array->items);
-    array->items = NULL;
-    array->capacity = 0;
+    return res;
+  }
+
+  // Grow following the policy, but in a single reallocation
+  return dfarray_set_capacity(array, dfarray_next_capacity(array, needed));
+}
+
+DfResult dfarray_shrink(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dfarray_set_capacity(array, array->length);
+}
+
+DfResult dfarray_maybe_shrink(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfArray_Policy *policy = &array->policy;
+  if (policy->never_shrink || array->length > array->capacity / policy->shrink_divisor)
+  {
+    return res;
+  }
+
+  // Keep slack above length so the next push does not immediately grow again
+  size_t target = (size_t)((double)array->length * policy->shrink_slack);
+  if (target < policy->min_capacity)
+  {
+    target = policy->min_capacity;
+  }
+
+  if (target >= array->capacity)
+  {
+    return res;
+  }
+
+  return dfarray_set_capacity(array, target);
+}
+
+// Capacity policy
+
+DfResult dfarray_set_policy(DfArray *array, const DfArray_Policy *policy)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res = dfarray_policy_check(policy);
+  if (res.error)
+  {
+    return res;
+  }
+
+  array->policy = *policy;
+
+  if (array->capacity < policy->min_capacity)
+  {
+    return dfarray_set_capacity(array, policy->min_capacity);
+  }
+
+  return res;
+}
+
+DfResult dfarray_get_policy(DfArray *array, DfArray_Policy *policy)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(policy, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  *policy = array->policy;
+
+  res.value = policy;
+  return res;
+}
+
+DfResult dfarray_reserve(DfArray *array, size_t capacity)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (capacity <= array->capacity)
+  {
+    return res;
+  }
+
+  return dfarray_set_capacity(array, capacity);
+}
+
+DfResult dfarray_shrink_to_fit(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t target = array->length > array->policy.min_capacity ? array->length : array->policy.min_capacity;
+  if (target >= array->capacity)
+  {
+    return res;
+  }
+
+  return dfarray_set_capacity(array, target);
+}
+
+DfResult dfarray_stats(DfArray *array, DfArray_Stats *stats)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(stats, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  *stats = array->stats;
+
+  res.value = stats;
+  return res;
+}
+
+DfResult dfarray_get(DfArray *array, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, array->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  void *dest = malloc(array->elem_size);
+  if (!dest)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  memcpy(dest, dfarray_slot(array, index), array->elem_size);
+
+  res.value = dest;
+  return res;
+}
+
+DfResult dfarray_set(DfArray *array, size_t index, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, array->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  memcpy(dfarray_slot(array, index), value, array->elem_size);
+
+  return res;
+}
+
+DfResult dfarray_push(DfArray *array, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (array->length >= array->capacity)
+  {
+    DfResult resize_res = dfarray_resize(array);
+    if (resize_res.error != DF_OK)
+    {
+      return resize_res;
+    }
+  }
+
+  memcpy(dfarray_slot(array, array->length), value, array->elem_size);
+  array->length++;
+
+  return res;
+}
+
+DfResult dfarray_pop_into(DfArray *array, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(dest, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (array->length < 1)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  memcpy(dest, dfarray_slot(array, array->length - 1), array->elem_size);
+  array->length--;
 
+  DfResult shrink_res = dfarray_maybe_shrink(array);
+  if (shrink_res.error != DF_OK)
+  {
+    return shrink_res;
+  }
+
+  return res;
+}
+
+DfResult dfarray_pop(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (array->length < 1)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  void *dest = malloc(array->elem_size);
+  if (!dest)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfResult pop_res = dfarray_pop_into(array, dest);
+  if (pop_res.error != DF_OK)
+  {
+    free(dest);
+    return pop_res;
+  }
+
+  res.value = dest;
+  return res;
+}
+
+DfResult dfarray_shift_into(DfArray *array, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(dest, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (array->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  memcpy(dest, array->items, array->elem_size);
+  memmove(array->items, dfarray_slot(array, 1), (array->length - 1) * array->stride);
+  array->length--;
+
+  DfResult shrink_res = dfarray_maybe_shrink(array);
+  if (shrink_res.error != DF_OK)
+  {
+    return shrink_res;
+  }
+
+  return res;
+}
+
+DfResult dfarray_shift(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (array->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  void *dest = malloc(array->elem_size);
+  if (!dest)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfResult shift_res = dfarray_shift_into(array, dest);
+  if (shift_res.error != DF_OK)
+  {
+    free(dest);
+    return shift_res;
+  }
+
+  res.value = dest;
+  return res;
+}
+
+DfResult dfarray_unshift(DfArray *array, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (array->length >= array->capacity)
+  {
+    DfResult resize_res = dfarray_resize(array);
+    if (resize_res.error != DF_OK)
+    {
+      return resize_res;
+    }
+  }
+
+  memmove(dfarray_slot(array, 1), array->items, array->length * array->stride);
+  memcpy(array->items, value, array->elem_size);
+
+  array->length++;
+
+  return res;
+}
+
+DfResult dfarray_insert_at(DfArray *array, size_t index, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, array->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (index < array->length)
+  {
+    if (array->length >= array->capacity)
+    {
+      DfResult resize_res = dfarray_resize(array);
+      if (resize_res.error != DF_OK)
+      {
+        return resize_res;
+      }
+    }
+
+    memmove(
+        dfarray_slot(array, index + 1),
+        dfarray_slot(array, index),
+        (array->length - index) * array->stride);
+
+    memcpy(dfarray_slot(array, index), value, array->elem_size);
+    array->length++;
+  }
+  else // index == array->length
+  {
+    DfResult push_res = dfarray_push(array, value);
+    if (push_res.error != DF_OK)
+    {
+      return push_res;
+    }
+  }
+
+  return res;
+}
+
+DfResult dfarray_remove_at(DfArray *array, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, array->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  memmove(
+      dfarray_slot(array, index),
+      dfarray_slot(array, index + 1),
+      (array->length - index - 1) * array->stride);
+
+  array->length--;
+
+  DfResult shrink_res = dfarray_maybe_shrink(array);
+  if (shrink_res.error != DF_OK)
+  {
+    return shrink_res;
+  }
+
+  return res;
+}
+
+DfResult dfarray_length(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)array->length;
+  return res;
+}
+
+// Range operations
+
+DfResult dfarray_append_n(DfArray *array, void *values, size_t count)
+{
+  return dfarray_insert_range(array, array ? array->length : 0, values, count);
+}
+
+DfResult dfarray_insert_range(DfArray *array, size_t index, void *values, size_t count)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check(values, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, array->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (count == 0)
+  {
+    return res;
+  }
+
+  DfResult grow_res = dfarray_ensure_capacity(array, array->length + count);
+  if (grow_res.error != DF_OK)
+  {
+    return grow_res;
+  }
+
+  if (index < array->length)
+  {
+    memmove(
+        dfarray_slot(array, index + count),
+        dfarray_slot(array, index),
+        (array->length - index) * array->stride);
+  }
+
+  dfarray_copy_elements(dfarray_slot(array, index), array->stride, values, array->elem_size, array->elem_size, count);
+  array->length += count;
+
+  return res;
+}
+
+DfResult dfarray_remove_range(DfArray *array, size_t index, size_t count)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, array->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (count > array->length - index)
+  {
+    res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;
+    return res;
+  }
+
+  if (count == 0)
+  {
     return res;
   }
 
-  size_t new_capacity = array->length;
-  void *shrunk_items = realloc(array->items, new_capacity * array->elem_size);
+  memmove(
+      dfarray_slot(array, index),
+      dfarray_slot(array, index + count),
+      (array->length - index - count) * array->stride);
+
+  array->length -= count;
 
-  if (!shrunk_items)
+  DfResult shrink_res = dfarray_maybe_shrink(array);
+  if (shrink_res.error != DF_OK)
   {
-    res.error = DF_ERR_ALLOC_FAILED;
-    return res;
+    return shrink_res;
   }
 
-  array->items = shrunk_items;
-  array->capacity = new_capacity;
-
   return res;
 }
 
-DfResult dfarray_get(DfArray *array, size_t index)
+static DfResult dfarray_extend_from_array(DfArray *array, DfArray_Iterator *arr_it);
+
+DfResult dfarray_extend(DfArray *array, Iterator *it)
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(array, &res);
+  df_null_ptr_check(it, &res);
   if (res.error)
   {
     return res;
   }
 
-  df_index_check_access(index, array->length, &res);
-  if (res.error)
+  // Another DfArray can be copied over in one block without per-element copies
+  if (it->next == dfarray_iterator_next)
   {
-    return res;
+    return dfarray_extend_from_array(array, (DfArray_Iterator *)it->current);
   }
 
-  void *dest = malloc(array->elem_size);
-  if (!dest)
+  // Random-access sources know their length, so the storage grows once up front
+  if (it->remaining)
   {
-    res.error = DF_ERR_ALLOC_FAILED;
-    return res;
+    DfResult grow_res = dfarray_ensure_capacity(array, array->length + it->remaining(it));
+    if (grow_res.error)
+    {
+      return grow_res;
+    }
   }
 
-  memcpy(dest, (char *)array->items + index * array->elem_size, array->elem_size);
+  if (it->next_batch)
+  {
+    DfSpan span;
+    for (;;)
+    {
+      DfResult batch_res = it->next_batch(it, &span, DF_ITERATOR_BATCH);
+      if (batch_res.error)
+      {
+        return batch_res;
+      }
 
-  res.value = dest;
-  return res;
-}
+      if (span.count == 0)
+      {
+        return res;
+      }
 
-DfResult dfarray_set(DfArray *array, size_t index, void *value)
-{
-  DfResult res = df_result_init();
+      // Otherwise reserve a batch at a time; ensure_capacity still grows by the policy
+      DfResult grow_res = dfarray_ensure_capacity(array, array->length + span.count);
+      if (grow_res.error)
+      {
+        return grow_res;
+      }
 
-  df_null_ptr_check(array, &res);
-  if (res.error)
-  {
-    return res;
+      if (span.stride)
+      {
+        dfarray_copy_elements(dfarray_slot(array, array->length), array->stride, span.items, span.stride, array->elem_size, span.count);
+      }
+      else
+      {
+        for (size_t i = 0; i < span.count; i++)
+        {
+          memcpy(dfarray_slot(array, array->length + i), df_span_at(&span, i), array->elem_size);
+        }
+      }
+      array->length += span.count;
+    }
   }
 
-  df_index_check_access(index, array->length, &res);
-  if (res.error)
+  while (it->has_next(it))
   {
-    return res;
-  }
+    DfResult element_res = it->next(it);
+    if (element_res.error)
+    {
+      return element_res;
+    }
 
-  memcpy((char *)array->items + index * array->elem_size, value, array->elem_size);
+    DfResult push_res = dfarray_push(array, element_res.value);
+    if (push_res.error)
+    {
+      return push_res;
+    }
+  }
 
   return res;
 }
 
-DfResult dfarray_push(DfArray *array, void *value)
+// Borrowed access
+
+DfResult dfarray_at(DfArray *array, size_t index)
 {
   DfResult res = df_result_init();
 
@@ -186,22 +1202,17 @@ DfResult dfarray_push(DfArray *array, void *value)
     return res;
   }
 
-  if (array->length >= array->capacity)
+  df_index_check_access(index, array->length, &res);
+  if (res.error)
   {
-    DfResult resize_res = dfarray_resize(array);
-    if (resize_res.error != DF_OK)
-    {
-      return resize_res;
-    }
+    return res;
   }
 
-  memcpy((char *)array->items + array->length * array->elem_size, value, array->elem_size);
-  array->length++;
-
+  res.value = dfarray_slot(array, index);
   return res;
 }
 
-DfResult dfarray_pop(DfArray *array)
+DfResult dfarray_front(DfArray *array)
 {
   DfResult res = df_result_init();
 
@@ -211,37 +1222,17 @@ DfResult dfarray_pop(DfArray *array)
     return res;
   }
 
-  if (array->length < 1)
+  if (array->length == 0)
   {
     res.error = DF_ERR_EMPTY;
     return res;
   }
 
-  void *dest = malloc(array->elem_size);
-  if (!dest)
-  {
-    res.error = DF_ERR_ALLOC_FAILED;
-    return res;
-  }
-
-  memcpy(dest, (char *)array->items + (array->length - 1) * array->elem_size, array->elem_size);
-  array->length--;
-
-  if (array->length <= array->capacity / 2 || array->length == 0)
-  {
-    DfResult shrink_res = dfarray_shrink(array);
-    if (shrink_res.error != DF_OK)
-    {
-      free(dest);
-      return shrink_res;
-    }
-  }
-
-  res.value = dest;
+  res.value = array->items;
   return res;
 }
 
-DfResult dfarray_shift(DfArray *array)
+DfResult dfarray_back(DfArray *array)
 {
   DfResult res = df_result_init();
 
@@ -257,200 +1248,194 @@ DfResult dfarray_shift(DfArray *array)
     return res;
   }
 
-  void *dest = malloc(array->elem_size);
-  if (!dest)
-  {
-    res.error = DF_ERR_ALLOC_FAILED;
-    return res;
-  }
-
-  memcpy(dest, array->items, array->elem_size);
-  memmove(array->items, (char *)array->items + array->elem_size, (array->length - 1) * array->elem_size);
-  array->length--;
-
-  if (array->length <= array->capacity / 2 || array->length == 0)
-  {
-    DfResult shrink_res = dfarray_shrink(array);
-    if (shrink_res.error != DF_OK)
-    {
-      free(dest);
-      return shrink_res;
-    }
-  }
-
-  res.value = dest;
+  res.value = dfarray_slot(array, array->length - 1);
   return res;
 }
 
-DfResult dfarray_unshift(DfArray *array, void *value)
+DfResult dfarray_span(DfArray *array, DfArray_Span *span)
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(array, &res);
-  df_null_ptr_check(value, &res);
+  df_null_ptr_check(span, &res);
   if (res.error)
   {
     return res;
   }
 
-  if (array->length >= array->capacity)
-  {
-    DfResult resize_res = dfarray_resize(array);
-    if (resize_res.error != DF_OK)
-    {
-      return resize_res;
-    }
-  }
-
-  memmove((char *)array->items + array->elem_size, array->items, array->length * array->elem_size);
-  memcpy(array->items, value, array->elem_size);
-
-  array->length++;
+  span->data = array->items;
+  span->length = array->length;
+  span->elem_size = array->elem_size;
+  span->stride = array->stride;
 
+  res.value = span;
   return res;
 }
 
-DfResult dfarray_insert_at(DfArray *array, size_t index, void *value)
+// Iterator
+
+typedef struct DfArray_Iterator
+{
+  DfArray *array;
+  size_t index;
+} DfArray_Iterator;
+
+_Static_assert(sizeof(DfArray_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfArray_Iterator must fit in the embedded iterator state");
+
+static DfResult dfarray_extend_from_array(DfArray *array, DfArray_Iterator *arr_it)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(array, &res);
-  df_null_ptr_check(value, &res);
+  df_null_ptr_check(arr_it, &res);
   if (res.error)
   {
     return res;
   }
 
-  df_index_check_insert(index, array->length, &res);
-  if (res.error)
+  DfArray *source = arr_it->array;
+  if (source->elem_size != array->elem_size)
   {
+    res.error = DF_ERR_SIZE_MISMATCH;
     return res;
   }
 
-  if (index < array->length)
+  size_t remaining = source->length - arr_it->index;
+  if (remaining == 0)
   {
-    if (array->length >= array->capacity)
-    {
-      DfResult resize_res = dfarray_resize(array);
-      if (resize_res.error != DF_OK)
-      {
-        return resize_res;
-      }
-    }
-
-    memmove(
-        (char *)array->items + (index + 1) * array->elem_size,
-        (char *)array->items + index * array->elem_size,
-        (array->length - index) * array->elem_size);
-
-    memcpy((char *)array->items + index * array->elem_size, value, array->elem_size);
-    array->length++;
+    return res;
   }
-  else // index == array->length
+
+  DfResult grow_res = dfarray_ensure_capacity(array, array->length + remaining);
+  if (grow_res.error != DF_OK)
   {
-    DfResult push_res = dfarray_push(array, value);
-    if (push_res.error != DF_OK)
-    {
-      return push_res;
-    }
+    return grow_res;
   }
 
+  dfarray_copy_elements(dfarray_slot(array, array->length), array->stride, dfarray_slot(source, arr_it->index), source->stride, array->elem_size, remaining);
+  array->length += remaining;
+  arr_it->index += remaining;
+
   return res;
 }
 
-DfResult dfarray_remove_at(DfArray *array, size_t index)
+int dfarray_iterator_has_next(Iterator *it)
+{
+  DfArray_Iterator *arr_it = (DfArray_Iterator *)it->current;
+  return arr_it->index < arr_it->array->length;
+}
+
+DfResult dfarray_iterator_next(Iterator *it)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(array, &res);
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
   if (res.error)
   {
     return res;
   }
 
-  df_index_check_access(index, array->length, &res);
+  DfArray_Iterator *arr_it = (DfArray_Iterator *)it->current;
+
+  df_index_check_access(arr_it->index, arr_it->array->length, &res);
   if (res.error)
   {
     return res;
   }
 
-  memmove(
-      (char *)array->items + index * array->elem_size,
-      (char *)array->items + (index + 1) * array->elem_size,
-      (array->length - index - 1) * array->elem_size);
-
-  array->length--;
-
-  if (array->length < array->capacity / 2)
+  void *elem_ptr = dfarray_slot(arr_it->array, arr_it->index++);
+  void *copied_elem = malloc(arr_it->array->elem_size);
+  if (!copied_elem)
   {
-    DfResult shrink_res = dfarray_shrink(array);
-    if (shrink_res.error != DF_OK)
-    {
-      return shrink_res;
-    }
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
   }
 
+  memcpy(copied_elem, elem_ptr, arr_it->array->elem_size);
+
+  res.value = copied_elem;
   return res;
 }
 
-DfResult dfarray_length(DfArray *array)
+// Hands out the array's own storage, so unlike next() there is no copy to free
+DfResult dfarray_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(array, &res);
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
   if (res.error)
   {
     return res;
   }
 
-  res.value = (void *)array->length;
-  return res;
-}
+  DfArray_Iterator *arr_it = (DfArray_Iterator *)it->current;
+  DfArray *array = arr_it->array;
 
-// Iterator
+  size_t remaining = array->length - arr_it->index;
+  span->count = remaining < max ? remaining : max;
+  span->stride = array->stride;
+  span->items = span->count ? dfarray_slot(array, arr_it->index) : NULL;
 
-typedef struct DfArray_Iterator
-{
-  DfArray *array;
-  size_t index;
-} DfArray_Iterator;
+  arr_it->index += span->count;
+  return res;
+}
 
-int dfarray_iterator_has_next(Iterator *it)
+size_t dfarray_iterator_remaining(Iterator *it)
 {
   DfArray_Iterator *arr_it = (DfArray_Iterator *)it->current;
-  return arr_it->index < arr_it->array->length;
+  return arr_it->array->length - arr_it->index;
 }
 
-DfResult dfarray_iterator_next(Iterator *it)
+// Read-only, so several threads may take spans from one iterator at once
+DfResult dfarray_iterator_span_at(Iterator *it, size_t offset, DfSpan *span, size_t max)
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(it, &res);
   df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
   if (res.error)
   {
     return res;
   }
 
   DfArray_Iterator *arr_it = (DfArray_Iterator *)it->current;
+  DfArray *array = arr_it->array;
 
-  df_index_check_access(arr_it->index, arr_it->array->length, &res);
-  if (res.error)
+  size_t remaining = array->length - arr_it->index;
+  if (offset > remaining)
   {
+    res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;
     return res;
   }
 
-  void *elem_ptr = (char *)arr_it->array->items + (arr_it->index++ * arr_it->array->elem_size);
-  void *copied_elem = malloc(arr_it->array->elem_size);
-  if (!copied_elem)
+  remaining -= offset;
+  span->count = remaining < max ? remaining : max;
+  span->stride = array->stride;
+  span->items = span->count ? dfarray_slot(array, arr_it->index + offset) : NULL;
+  return res;
+}
+
+// Sets the length directly; slots past the old length are left uninitialized for the caller to fill
+DfResult dfarray_set_length(DfArray *array, size_t length)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
   {
-    res.error = DF_ERR_ALLOC_FAILED;
     return res;
   }
 
-  memcpy(copied_elem, elem_ptr, arr_it->array->elem_size);
+  DfResult grow_res = dfarray_ensure_capacity(array, length);
+  if (grow_res.error != DF_OK)
+  {
+    return grow_res;
+  }
 
-  res.value = copied_elem;
+  array->length = length;
   return res;
 }
 
@@ -467,7 +1452,8 @@ DfResult dfarray_create_new(Iterator *it)
 
   DfArray_Iterator *arr_it = (DfArray_Iterator *)it->current;
 
-  DfResult new_array_res = dfarray_create(arr_it->array->elem_size, arr_it->array->capacity);
+  DfArray *source = arr_it->array;
+  DfResult new_array_res = dfarray_create_layout(source->elem_size, source->capacity, &source->policy, source->alignment, source->stride);
   DfArray *new_array = (DfArray *)new_array_res.value;
 
   res.value = new_array;
@@ -521,52 +1507,72 @@ DfResult dfarray_free_all(Iterator *it)
     return res;
   }
 
-  free(array->items);
+  dfarray_release_items(array);
+  array->length = 0;
+
+  // Arrays with inline storage fall back to it instead of being left without items
+  if (array->inline_capacity > 0)
+  {
+    array->items = array->inline_items;
+    array->capacity = array->inline_capacity;
+    return res;
+  }
+
   array->items = NULL;
   array->capacity = 0;
-  array->length = 0;
 
   return res;
 }
 
-DfResult dfarray_iterator_create(DfArray *array)
+DfResult dfarray_iterator_init(Iterator *it, DfArray *array)
 {
   DfResult res = df_result_init();
 
+  df_null_ptr_check(it, &res);
   df_null_ptr_check(array, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfArray_Iterator *array_it = malloc(sizeof(DfArray_Iterator));
-  if (!array_it)
-  {
-    res.error = DF_ERR_ALLOC_FAILED;
-    return res;
-  }
-
+  DfArray_Iterator *array_it = (DfArray_Iterator *)iterator_prepare(it, array);
   array_it->array = array;
   array_it->index = 0;
 
-  DfResult it_res = iterator_create();
-  if (it_res.error)
-  {
-    free(array_it);
-    return it_res;
-  }
-
-  Iterator *it = (Iterator *)it_res.value;
-
-  it->structure = array;
-  it->current = array_it;
   it->next = dfarray_iterator_next;
   it->has_next = dfarray_iterator_has_next;
   it->create_new = dfarray_create_new;
   it->insert_new = dfarray_insert_new;
   it->elem_size = dfarray_elem_size;
   it->free_all = dfarray_free_all;
+  it->next_batch = dfarray_iterator_next_batch;
+  it->remaining = dfarray_iterator_remaining;
+  it->span_at = dfarray_iterator_span_at;
 
   res.value = it;
   return res;
 }
+
+DfResult dfarray_iterator_create(DfArray *array)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dfarray_iterator_init((Iterator *)it_res.value, array);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
@@ -0,0 +1,699 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../includes/df_array.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+
+// Sorting and searching over the storage exposed by dfarray_span
+
+// Ranges at or below this size are finished with insertion sort
+#define DFSORT_INSERTION_THRESHOLD 16
+
+// Elements up to this many bytes use a stack buffer for the pivot copy
+#define DFSORT_STACK_ELEM_SIZE 64
+
+typedef struct DfSort_Ctx
+{
+  char *base;
+  size_t size;   // Bytes swapped per element
+  size_t stride; // Bytes between elements, larger than size for padded arrays
+  int (*cmp)(const void *a, const void *b);
+  void *pivot; // Scratch for one element
+} DfSort_Ctx;
+
+static inline char *dfsort_at(const DfSort_Ctx *ctx, size_t index)
+{
+  return ctx->base + index * ctx->stride;
+}
+
+static inline void dfsort_swap(const DfSort_Ctx *ctx, char *a, char *b)
+{
+  switch (ctx->size)
+  {
+  case 4:
+  {
+    uint32_t tmp;
+    memcpy(&tmp, a, 4);
+    memcpy(a, b, 4);
+    memcpy(b, &tmp, 4);
+    return;
+  }
+  case 8:
+  {
+    uint64_t tmp;
+    memcpy(&tmp, a, 8);
+    memcpy(a, b, 8);
+    memcpy(b, &tmp, 8);
+    return;
+  }
+  default:
+  {
+    char tmp[DFSORT_STACK_ELEM_SIZE];
+    for (size_t offset = 0; offset < ctx->size; offset += sizeof(tmp))
+    {
+      size_t chunk = ctx->size - offset < sizeof(tmp) ? ctx->size - offset : sizeof(tmp);
+      memcpy(tmp, a + offset, chunk);
+      memcpy(a + offset, b + offset, chunk);
+      memcpy(b + offset, tmp, chunk);
+    }
+    return;
+  }
+  }
+}
+
+static void dfsort_insertion(const DfSort_Ctx *ctx, size_t lo, size_t hi)
+{
+  for (size_t i = lo + 1; i < hi; i++)
+  {
+    if (ctx->cmp(dfsort_at(ctx, i - 1), dfsort_at(ctx, i)) <= 0)
+    {
+      continue;
+    }
+
+    memcpy(ctx->pivot, dfsort_at(ctx, i), ctx->size);
+    size_t j = i;
+    while (j > lo && ctx->cmp(dfsort_at(ctx, j - 1), ctx->pivot) > 0)
+    {
+      memcpy(dfsort_at(ctx, j), dfsort_at(ctx, j - 1), ctx->size);
+      j--;
+    }
+    memcpy(dfsort_at(ctx, j), ctx->pivot, ctx->size);
+  }
+}
+
+static void dfsort_sift_down(const DfSort_Ctx *ctx, size_t lo, size_t root, size_t count)
+{
+  for (;;)
+  {
+    size_t child = 2 * root + 1;
+    if (child >= count)
+    {
+      return;
+    }
+
+    if (child + 1 < count && ctx->cmp(dfsort_at(ctx, lo + child), dfsort_at(ctx, lo + child + 1)) < 0)
+    {
+      child++;
+    }
+
+    if (ctx->cmp(dfsort_at(ctx, lo + root), dfsort_at(ctx, lo + child)) >= 0)
+    {
+      return;
+    }
+
+    dfsort_swap(ctx, dfsort_at(ctx, lo + root), dfsort_at(ctx, lo + child));
+    root = child;
+  }
+}
+
+static void dfsort_heap(const DfSort_Ctx *ctx, size_t lo, size_t hi)
+{
+  size_t count = hi - lo;
+  for (size_t i = count / 2; i-- > 0;)
+  {
+    dfsort_sift_down(ctx, lo, i, count);
+  }
+
+  for (size_t end = count - 1; end > 0; end--)
+  {
+    dfsort_swap(ctx, dfsort_at(ctx, lo), dfsort_at(ctx, lo + end));
+    dfsort_sift_down(ctx, lo, 0, end);
+  }
+}
+
+// Hoare partition of [lo, hi) around the median of three, returns the last index of the left part
+static size_t dfsort_partition(const DfSort_Ctx *ctx, size_t lo, size_t hi)
+{
+  char *first = dfsort_at(ctx, lo);
+  char *middle = dfsort_at(ctx, lo + (hi - lo) / 2);
+  char *last = dfsort_at(ctx, hi - 1);
+
+  if (ctx->cmp(middle, first) < 0)
+  {
+    dfsort_swap(ctx, middle, first);
+  }
+  if (ctx->cmp(last, middle) < 0)
+  {
+    dfsort_swap(ctx, last, middle);
+    if (ctx->cmp(middle, first) < 0)
+    {
+      dfsort_swap(ctx, middle, first);
+    }
+  }
+
+  memcpy(ctx->pivot, middle, ctx->size);
+
+  size_t i = lo;
+  size_t j = hi - 1;
+  for (;;)
+  {
+    while (ctx->cmp(dfsort_at(ctx, i), ctx->pivot) < 0)
+    {
+      i++;
+    }
+    while (ctx->cmp(dfsort_at(ctx, j), ctx->pivot) > 0)
+    {
+      j--;
+    }
+    if (i >= j)
+    {
+      return j;
+    }
+
+    dfsort_swap(ctx, dfsort_at(ctx, i), dfsort_at(ctx, j));
+    i++;
+    j--;
+  }
+}
+
+static void dfsort_intro(const DfSort_Ctx *ctx, size_t lo, size_t hi, size_t depth)
+{
+  while (hi - lo > DFSORT_INSERTION_THRESHOLD)
+  {
+    if (depth == 0)
+    {
+      dfsort_heap(ctx, lo, hi);
+      return;
+    }
+    depth--;
+
+    size_t split = dfsort_partition(ctx, lo, hi) + 1;
+
+    // Recurse into the smaller side to bound stack depth
+    if (split - lo < hi - split)
+    {
+      dfsort_intro(ctx, lo, split, depth);
+      lo = split;
+    }
+    else
+    {
+      dfsort_intro(ctx, split, hi, depth);
+      hi = split;
+    }
+  }
+
+  dfsort_insertion(ctx, lo, hi);
+}
+
+DfResult dfarray_sort(DfArray *array, int (*cmp)(const void *a, const void *b))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check((void *)cmp, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfArray_Span span;
+  dfarray_span(array, &span);
+  if (span.length < 2)
+  {
+    return res;
+  }
+
+  char stack_pivot[DFSORT_STACK_ELEM_SIZE];
+  DfSort_Ctx ctx = {.base = span.data, .size = span.elem_size, .stride = span.stride, .cmp = cmp, .pivot = stack_pivot};
+  if (span.elem_size > sizeof(stack_pivot))
+  {
+    ctx.pivot = malloc(span.elem_size);
+    if (!ctx.pivot)
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+  }
+
+  size_t depth = 0;
+  for (size_t n = span.length; n > 1; n >>= 1)
+  {
+    depth += 2;
+  }
+
+  dfsort_intro(&ctx, 0, span.length, depth);
+
+  if (ctx.pivot != stack_pivot)
+  {
+    free(ctx.pivot);
+  }
+
+  return res;
+}
+
+// Radix sort
+
+// Order-preserving maps from signed and floating point keys to unsigned keys
+static inline uint32_t dfsort_key32_in(uint32_t bits, DfKey_Type type)
+{
+  if (type == DF_KEY_I32)
+  {
+    return bits ^ 0x80000000u;
+  }
+  if (type == DF_KEY_F32)
+  {
+    return bits ^ ((uint32_t)-(int32_t)(bits >> 31) | 0x80000000u);
+  }
+  return bits;
+}
+
+static inline uint32_t dfsort_key32_out(uint32_t bits, DfKey_Type type)
+{
+  if (type == DF_KEY_I32)
+  {
+    return bits ^ 0x80000000u;
+  }
+  if (type == DF_KEY_F32)
+  {
+    return bits ^ (((bits >> 31) - 1) | 0x80000000u);
+  }
+  return bits;
+}
+
+static inline uint64_t dfsort_key64_in(uint64_t bits, DfKey_Type type)
+{
+  if (type == DF_KEY_I64)
+  {
+    return bits ^ 0x8000000000000000ull;
+  }
+  if (type == DF_KEY_F64)
+  {
+    return bits ^ ((uint64_t)-(int64_t)(bits >> 63) | 0x8000000000000000ull);
+  }
+  return bits;
+}
+
+static inline uint64_t dfsort_key64_out(uint64_t bits, DfKey_Type type)
+{
+  if (type == DF_KEY_I64)
+  {
+    return bits ^ 0x8000000000000000ull;
+  }
+  if (type == DF_KEY_F64)
+  {
+    return bits ^ (((bits >> 63) - 1) | 0x8000000000000000ull);
+  }
+  return bits;
+}
+
+static void dfsort_radix_u32(uint32_t *data, uint32_t *tmp, size_t n)
+{
+  size_t counts[4][256] = {{0}};
+  for (size_t i = 0; i < n; i++)
+  {
+    for (int d = 0; d < 4; d++)
+    {
+      counts[d][(data[i] >> (d * 8)) & 0xff]++;
+    }
+  }
+
+  uint32_t *src = data;
+  uint32_t *dst = tmp;
+  for (int d = 0; d < 4; d++)
+  {
+    // A digit shared by every key leaves the order unchanged
+    if (counts[d][(src[0] >> (d * 8)) & 0xff] == n)
+    {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (int b = 0; b < 256; b++)
+    {
+      size_t count = counts[d][b];
+      counts[d][b] = offset;
+      offset += count;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+      dst[counts[d][(src[i] >> (d * 8)) & 0xff]++] = src[i];
+    }
+
+    uint32_t *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != data)
+  {
+    memcpy(data, src, n * sizeof(uint32_t));
+  }
+}
+
+static void dfsort_radix_u64(uint64_t *data, uint64_t *tmp, size_t n)
+{
+  size_t counts[8][256] = {{0}};
+  for (size_t i = 0; i < n; i++)
+  {
+    for (int d = 0; d < 8; d++)
+    {
+      counts[d][(data[i] >> (d * 8)) & 0xff]++;
+    }
+  }
+
+  uint64_t *src = data;
+  uint64_t *dst = tmp;
+  for (int d = 0; d < 8; d++)
+  {
+    if (counts[d][(src[0] >> (d * 8)) & 0xff] == n)
+    {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (int b = 0; b < 256; b++)
+    {
+      size_t count = counts[d][b];
+      counts[d][b] = offset;
+      offset += count;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+      dst[counts[d][(src[i] >> (d * 8)) & 0xff]++] = src[i];
+    }
+
+    uint64_t *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != data)
+  {
+    memcpy(data, src, n * sizeof(uint64_t));
+  }
+}
+
+typedef struct DfSort_Pair
+{
+  uint64_t key;
+  size_t index;
+} DfSort_Pair;
+
+// Sorts (key, index) pairs on the low key_bytes bytes of the key, stable
+static void dfsort_radix_pairs(DfSort_Pair *data, DfSort_Pair *tmp, size_t n, int key_bytes)
+{
+  size_t counts[8][256] = {{0}};
+  for (size_t i = 0; i < n; i++)
+  {
+    for (int d = 0; d < key_bytes; d++)
+    {
+      counts[d][(data[i].key >> (d * 8)) & 0xff]++;
+    }
+  }
+
+  DfSort_Pair *src = data;
+  DfSort_Pair *dst = tmp;
+  for (int d = 0; d < key_bytes; d++)
+  {
+    if (counts[d][(src[0].key >> (d * 8)) & 0xff] == n)
+    {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (int b = 0; b < 256; b++)
+    {
+      size_t count = counts[d][b];
+      counts[d][b] = offset;
+      offset += count;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+      dst[counts[d][(src[i].key >> (d * 8)) & 0xff]++] = src[i];
+    }
+
+    DfSort_Pair *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != data)
+  {
+    memcpy(data, src, n * sizeof(DfSort_Pair));
+  }
+}
+
+// Reorders records to follow sorted pairs, using one gather into a scratch buffer
+static DfResult dfsort_apply_pairs(DfArray_Span *span, DfSort_Pair *pairs)
+{
+  DfResult res = df_result_init();
+
+  char *records = malloc(span->length * span->stride);
+  if (!records)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  char *base = span->data;
+  for (size_t i = 0; i < span->length; i++)
+  {
+    memcpy(records + i * span->stride, base + pairs[i].index * span->stride, span->elem_size);
+  }
+  memcpy(base, records, span->length * span->stride);
+
+  free(records);
+  return res;
+}
+
+static DfResult dfsort_radix_records(DfArray_Span *span, DfKey_Type key_type, size_t key_offset, size_t key_size)
+{
+  DfResult res = df_result_init();
+
+  DfSort_Pair *pairs = malloc(2 * span->length * sizeof(DfSort_Pair));
+  if (!pairs)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  const char *base = span->data;
+  for (size_t i = 0; i < span->length; i++)
+  {
+    const char *key = base + i * span->stride + key_offset;
+    if (key_size == 4)
+    {
+      uint32_t bits;
+      memcpy(&bits, key, 4);
+      pairs[i].key = dfsort_key32_in(bits, key_type);
+    }
+    else
+    {
+      uint64_t bits;
+      memcpy(&bits, key, 8);
+      pairs[i].key = dfsort_key64_in(bits, key_type);
+    }
+    pairs[i].index = i;
+  }
+
+  dfsort_radix_pairs(pairs, pairs + span->length, span->length, (int)key_size);
+  res = dfsort_apply_pairs(span, pairs);
+
+  free(pairs);
+  return res;
+}
+
+static DfResult dfsort_radix_scalars(DfArray_Span *span, DfKey_Type key_type)
+{
+  DfResult res = df_result_init();
+
+  void *tmp = malloc(span->length * span->elem_size);
+  if (!tmp)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  if (span->elem_size == 4)
+  {
+    uint32_t *data = span->data;
+    for (size_t i = 0; i < span->length; i++)
+    {
+      data[i] = dfsort_key32_in(data[i], key_type);
+    }
+    dfsort_radix_u32(data, tmp, span->length);
+    for (size_t i = 0; i < span->length; i++)
+    {
+      data[i] = dfsort_key32_out(data[i], key_type);
+    }
+  }
+  else
+  {
+    uint64_t *data = span->data;
+    for (size_t i = 0; i < span->length; i++)
+    {
+      data[i] = dfsort_key64_in(data[i], key_type);
+    }
+    dfsort_radix_u64(data, tmp, span->length);
+    for (size_t i = 0; i < span->length; i++)
+    {
+      data[i] = dfsort_key64_out(data[i], key_type);
+    }
+  }
+
+  free(tmp);
+  return res;
+}
+
+DfResult dfarray_radix_sort(DfArray *array, DfKey_Type key_type, size_t key_offset)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t key_size;
+  switch (key_type)
+  {
+  case DF_KEY_U32:
+  case DF_KEY_I32:
+  case DF_KEY_F32:
+    key_size = 4;
+    break;
+  case DF_KEY_U64:
+  case DF_KEY_I64:
+  case DF_KEY_F64:
+    key_size = 8;
+    break;
+  default:
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  DfArray_Span span;
+  dfarray_span(array, &span);
+
+  if (key_offset > span.elem_size || key_size > span.elem_size - key_offset)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  if (span.length < 2)
+  {
+    return res;
+  }
+
+  // Plain key arrays are sorted directly, records are sorted through (key, index) pairs
+  if (span.elem_size == key_size && span.stride == key_size)
+  {
+    return dfsort_radix_scalars(&span, key_type);
+  }
+
+  return dfsort_radix_records(&span, key_type, key_offset, key_size);
+}
+
+DfResult dfarray_radix_sort_by(DfArray *array, uint64_t (*key)(const void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check((void *)key, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfArray_Span span;
+  dfarray_span(array, &span);
+  if (span.length < 2)
+  {
+    return res;
+  }
+
+  DfSort_Pair *pairs = malloc(2 * span.length * sizeof(DfSort_Pair));
+  if (!pairs)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  const char *base = span.data;
+  for (size_t i = 0; i < span.length; i++)
+  {
+    pairs[i].key = key(base + i * span.stride);
+    pairs[i].index = i;
+  }
+
+  dfsort_radix_pairs(pairs, pairs + span.length, span.length, 8);
+  res = dfsort_apply_pairs(&span, pairs);
+
+  free(pairs);
+  return res;
+}
+
+// Binary search
+
+static DfResult dfsort_bound(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b), int upper)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(array, &res);
+  df_null_ptr_check((void *)key, &res);
+  df_null_ptr_check((void *)cmp, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfArray_Span span;
+  dfarray_span(array, &span);
+
+  const char *base = span.data;
+  size_t lo = 0;
+  size_t hi = span.length;
+  while (lo < hi)
+  {
+    size_t mid = lo + (hi - lo) / 2;
+    int order = cmp(base + mid * span.stride, key);
+    if (order < 0 || (upper && order == 0))
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  res.value = (void *)lo;
+  return res;
+}
+
+DfResult dfarray_lower_bound(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b))
+{
+  return dfsort_bound(array, key, cmp, 0);
+}
+
+DfResult dfarray_upper_bound(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b))
+{
+  return dfsort_bound(array, key, cmp, 1);
+}
+
+DfResult dfarray_binary_search(DfArray *array, const void *key, int (*cmp)(const void *a, const void *b))
+{
+  DfResult res = dfsort_bound(array, key, cmp, 0);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t index = (size_t)res.value;
+  DfArray_Span span;
+  dfarray_span(array, &span);
+
+  if (index >= span.length || cmp((char *)span.data + index * span.stride, key) != 0)
+  {
+    res.value = NULL;
+    res.error = DF_ERR_ELEMENT_NOT_FOUND;
+  }
+
+  return res;
+}
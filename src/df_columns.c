@@ -0,0 +1,429 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../includes/df_columns.h"
+#include "../includes/df_array.h"
+#include "../includes/df_iterator.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+
+// Rows handed to dfarray_append_n at a time while building a selection
+#define DFCOLUMNS_SELECTION_CHUNK 256
+
+typedef struct DfColumns
+{
+  DfArray **columns;
+  size_t column_count;
+  size_t length;
+} DfColumns;
+
+static void dfcolumns_check_column(DfColumns *columns, size_t column, DfResult *res)
+{
+  if (!res->error && column >= columns->column_count)
+  {
+    res->error = DF_ERR_INDEX_OUT_OF_BOUNDS;
+  }
+}
+
+static void dfcolumns_check_selection(DfArray *selection, DfResult *res)
+{
+  if (!selection || res->error)
+  {
+    return;
+  }
+
+  DfArray_Span span;
+  dfarray_span(selection, &span);
+  if (span.elem_size != sizeof(size_t) || span.stride != sizeof(size_t))
+  {
+    res->error = DF_ERR_SIZE_MISMATCH;
+  }
+}
+
+DfResult dfcolumns_create(const size_t *elem_sizes, size_t column_count, size_t initial_capacity)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check((void *)elem_sizes, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (column_count == 0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  for (size_t i = 0; i < column_count; i++)
+  {
+    if (elem_sizes[i] == 0)
+    {
+      res.error = DF_ERR_OUT_OF_RANGE;
+      return res;
+    }
+  }
+
+  DfColumns *columns = malloc(sizeof(DfColumns));
+  if (!columns)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  columns->columns = calloc(column_count, sizeof(DfArray *));
+  if (!columns->columns)
+  {
+    free(columns);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  columns->column_count = column_count;
+  columns->length = 0;
+
+  for (size_t i = 0; i < column_count; i++)
+  {
+    DfResult array_res = dfarray_create(elem_sizes[i], initial_capacity);
+    if (array_res.error)
+    {
+      dfcolumns_destroy(columns);
+      return array_res;
+    }
+    columns->columns[i] = array_res.value;
+  }
+
+  res.value = columns;
+  return res;
+}
+
+DfResult dfcolumns_destroy(DfColumns *columns)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  for (size_t i = 0; i < columns->column_count; i++)
+  {
+    if (columns->columns[i])
+    {
+      dfarray_destroy(columns->columns[i]);
+    }
+  }
+
+  free(columns->columns);
+  free(columns);
+
+  return res;
+}
+
+DfResult dfcolumns_reserve(DfColumns *columns, size_t rows)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  for (size_t i = 0; i < columns->column_count; i++)
+  {
+    DfResult reserve_res = dfarray_reserve(columns->columns[i], rows);
+    if (reserve_res.error)
+    {
+      return reserve_res;
+    }
+  }
+
+  return res;
+}
+
+DfResult dfcolumns_append_row(DfColumns *columns, const void *const *values)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  df_null_ptr_check((void *)values, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  for (size_t i = 0; i < columns->column_count; i++)
+  {
+    df_null_ptr_check((void *)values[i], &res);
+  }
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Grow every column first so a failed allocation leaves all columns the same length
+  for (size_t i = 0; i < columns->column_count; i++)
+  {
+    DfResult grow_res = dfarray_ensure_capacity(columns->columns[i], columns->length + 1);
+    if (grow_res.error)
+    {
+      return grow_res;
+    }
+  }
+
+  for (size_t i = 0; i < columns->column_count; i++)
+  {
+    dfarray_push(columns->columns[i], (void *)values[i]);
+  }
+  columns->length++;
+
+  return res;
+}
+
+DfResult dfcolumns_length(DfColumns *columns)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)columns->length;
+  return res;
+}
+
+DfResult dfcolumns_column_count(DfColumns *columns)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)columns->column_count;
+  return res;
+}
+
+DfResult dfcolumns_column(DfColumns *columns, size_t column)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  dfcolumns_check_column(columns, column, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = columns->columns[column];
+  return res;
+}
+
+DfResult dfcolumns_at(DfColumns *columns, size_t column, size_t row)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  dfcolumns_check_column(columns, column, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dfarray_at(columns->columns[column], row);
+}
+
+DfResult dfcolumns_span(DfColumns *columns, size_t column, DfArray_Span *span)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  dfcolumns_check_column(columns, column, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dfarray_span(columns->columns[column], span);
+}
+
+DfResult dfcolumns_data(DfColumns *columns, size_t column, size_t elem_size)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  dfcolumns_check_column(columns, column, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfArray_Span span;
+  dfarray_span(columns->columns[column], &span);
+  if (span.elem_size != elem_size)
+  {
+    res.error = DF_ERR_SIZE_MISMATCH;
+    return res;
+  }
+
+  res.value = span.data;
+  return res;
+}
+
+DfResult dfcolumns_filter(DfColumns *columns, size_t column, DfArray *selection, bool (*func)(const void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  df_null_ptr_check((void *)func, &res);
+  dfcolumns_check_column(columns, column, &res);
+  dfcolumns_check_selection(selection, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult selected_res = dfarray_create(sizeof(size_t), 0);
+  if (selected_res.error)
+  {
+    return selected_res;
+  }
+  DfArray *selected = selected_res.value;
+
+  DfArray_Span span;
+  dfarray_span(columns->columns[column], &span);
+  const char *data = span.data;
+
+  DfArray_Span rows = {NULL, span.length, sizeof(size_t), sizeof(size_t)};
+  if (selection)
+  {
+    dfarray_span(selection, &rows);
+  }
+  const size_t *row_ids = rows.data;
+
+  // Matches are buffered locally and appended in chunks to keep the scan loop tight
+  size_t chunk[DFCOLUMNS_SELECTION_CHUNK];
+  size_t pending = 0;
+
+  for (size_t i = 0; i < rows.length; i++)
+  {
+    size_t row = row_ids ? row_ids[i] : i;
+    if (row >= span.length)
+    {
+      dfarray_destroy(selected);
+      res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;
+      return res;
+    }
+
+    if (func(data + row * span.stride))
+    {
+      chunk[pending++] = row;
+    }
+
+    if (pending == DFCOLUMNS_SELECTION_CHUNK)
+    {
+      DfResult append_res = dfarray_append_n(selected, chunk, pending);
+      if (append_res.error)
+      {
+        dfarray_destroy(selected);
+        return append_res;
+      }
+      pending = 0;
+    }
+  }
+
+  if (pending)
+  {
+    DfResult append_res = dfarray_append_n(selected, chunk, pending);
+    if (append_res.error)
+    {
+      dfarray_destroy(selected);
+      return append_res;
+    }
+  }
+
+  res.value = selected;
+  return res;
+}
+
+DfResult dfcolumns_reduce(DfColumns *columns, size_t column, DfArray *selection, void *accumulator, void (*func)(void *accumulator, const void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  df_null_ptr_check(accumulator, &res);
+  df_null_ptr_check((void *)func, &res);
+  dfcolumns_check_column(columns, column, &res);
+  dfcolumns_check_selection(selection, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfArray_Span span;
+  dfarray_span(columns->columns[column], &span);
+  const char *data = span.data;
+
+  if (!selection)
+  {
+    for (size_t row = 0; row < span.length; row++)
+    {
+      func(accumulator, data + row * span.stride);
+    }
+  }
+  else
+  {
+    DfArray_Span rows;
+    dfarray_span(selection, &rows);
+    const size_t *row_ids = rows.data;
+
+    for (size_t i = 0; i < rows.length; i++)
+    {
+      if (row_ids[i] >= span.length)
+      {
+        res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;
+        return res;
+      }
+      func(accumulator, data + row_ids[i] * span.stride);
+    }
+  }
+
+  res.value = accumulator;
+  return res;
+}
+
+DfResult dfcolumns_iterator_create(DfColumns *columns, size_t column)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  dfcolumns_check_column(columns, column, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Columns are plain DfArrays, so the array iterator and its df_map/df_filter support carry over
+  return dfarray_iterator_create(columns->columns[column]);
+}
+
+DfResult dfcolumns_iterator_init(Iterator *it, DfColumns *columns, size_t column)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(columns, &res);
+  dfcolumns_check_column(columns, column, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dfarray_iterator_init(it, columns->columns[column]);
+}
@@ -18,6 +18,16 @@ const char *df_error_to_string(DfError err)
         return "Structure is empty";
     case DF_ERR_ALREADY_FREED:
         return "Memory has already been freed";
+    case DF_ERR_ELEMENT_NOT_FOUND:
+        return "Element not found";
+    case DF_ERR_END_OF_LIST:
+        return "End of list";
+    case DF_ERR_SIZE_MISMATCH:
+        return "Element sizes do not match";
+    case DF_ERR_FULL:
+        return "Structure is full";
+    case DF_ERR_INCOMPATIBLE:
+        return "Structures are incompatible";
     default:
         return "Unknown error";
     }
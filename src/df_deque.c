@@ -0,0 +1,604 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../includes/df_deque.h"
+#include "../includes/df_iterator.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+
+// Circular buffer, capacity is always a power of two so positions wrap with a mask
+
+typedef struct DfDeque
+{
+  void *items;
+  size_t head; // Physical slot of the front element
+  size_t length;
+  size_t capacity;
+  size_t elem_size;
+} DfDeque;
+
+static inline void *dfdeque_slot(const DfDeque *deque, size_t index)
+{
+  size_t physical = (deque->head + index) & (deque->capacity - 1);
+  return (char *)deque->items + physical * deque->elem_size;
+}
+
+// Smallest power of two that holds capacity, or 0 when there is none below SIZE_MAX
+static size_t dfdeque_round_capacity(size_t capacity)
+{
+  if (capacity > SIZE_MAX / 2 + 1)
+  {
+    return 0;
+  }
+
+  size_t rounded = DFDEQUE_MIN_CAPACITY;
+  while (rounded < capacity)
+  {
+    rounded <<= 1;
+  }
+  return rounded;
+}
+
+DfResult dfdeque_create(size_t elem_size, size_t initial_capacity)
+{
+  DfResult res = df_result_init();
+
+  if (elem_size == 0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  size_t capacity = dfdeque_round_capacity(initial_capacity);
+  if (capacity == 0 || capacity > SIZE_MAX / elem_size)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  DfDeque *deque = malloc(sizeof(DfDeque));
+  if (!deque)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  deque->capacity = capacity;
+  deque->items = malloc(deque->capacity * elem_size);
+  if (!deque->items)
+  {
+    free(deque);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  deque->head = 0;
+  deque->length = 0;
+  deque->elem_size = elem_size;
+
+  res.value = deque;
+  return res;
+}
+
+DfResult dfdeque_destroy(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  free(deque->items);
+  free(deque);
+
+  return res;
+}
+
+// Doubles the buffer and unwraps the elements so the front sits at slot 0
+static DfResult dfdeque_grow(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  if (deque->capacity > SIZE_MAX / 2 / deque->elem_size)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  size_t new_capacity = deque->capacity * 2;
+  void *new_items = malloc(new_capacity * deque->elem_size);
+  if (!new_items)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  size_t first = deque->capacity - deque->head;
+  if (first > deque->length)
+  {
+    first = deque->length;
+  }
+
+  memcpy(new_items, (char *)deque->items + deque->head * deque->elem_size, first * deque->elem_size);
+  memcpy((char *)new_items + first * deque->elem_size, deque->items, (deque->length - first) * deque->elem_size);
+
+  free(deque->items);
+  deque->items = new_items;
+  deque->capacity = new_capacity;
+  deque->head = 0;
+
+  return res;
+}
+
+DfResult dfdeque_push_back(DfDeque *deque, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == deque->capacity)
+  {
+    DfResult grow_res = dfdeque_grow(deque);
+    if (grow_res.error)
+    {
+      return grow_res;
+    }
+  }
+
+  memcpy(dfdeque_slot(deque, deque->length), value, deque->elem_size);
+  deque->length++;
+
+  return res;
+}
+
+DfResult dfdeque_push_front(DfDeque *deque, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == deque->capacity)
+  {
+    DfResult grow_res = dfdeque_grow(deque);
+    if (grow_res.error)
+    {
+      return grow_res;
+    }
+  }
+
+  deque->head = (deque->head - 1) & (deque->capacity - 1);
+  memcpy(dfdeque_slot(deque, 0), value, deque->elem_size);
+  deque->length++;
+
+  return res;
+}
+
+DfResult dfdeque_pop_back_into(DfDeque *deque, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  df_null_ptr_check(dest, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  memcpy(dest, dfdeque_slot(deque, deque->length - 1), deque->elem_size);
+  deque->length--;
+
+  return res;
+}
+
+DfResult dfdeque_pop_front_into(DfDeque *deque, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  df_null_ptr_check(dest, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  memcpy(dest, dfdeque_slot(deque, 0), deque->elem_size);
+  deque->head = (deque->head + 1) & (deque->capacity - 1);
+  deque->length--;
+
+  return res;
+}
+
+static DfResult dfdeque_pop_copy(DfDeque *deque, DfResult (*pop_into)(DfDeque *, void *))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  void *dest = malloc(deque->elem_size);
+  if (!dest)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfResult pop_res = pop_into(deque, dest);
+  if (pop_res.error)
+  {
+    free(dest);
+    return pop_res;
+  }
+
+  res.value = dest;
+  return res;
+}
+
+DfResult dfdeque_pop_back(DfDeque *deque)
+{
+  return dfdeque_pop_copy(deque, dfdeque_pop_back_into);
+}
+
+DfResult dfdeque_pop_front(DfDeque *deque)
+{
+  return dfdeque_pop_copy(deque, dfdeque_pop_front_into);
+}
+
+DfResult dfdeque_peek_front(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = dfdeque_slot(deque, 0);
+  return res;
+}
+
+DfResult dfdeque_peek_back(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (deque->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = dfdeque_slot(deque, deque->length - 1);
+  return res;
+}
+
+DfResult dfdeque_at(DfDeque *deque, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, deque->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = dfdeque_slot(deque, index);
+  return res;
+}
+
+DfResult dfdeque_set(DfDeque *deque, size_t index, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, deque->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  memcpy(dfdeque_slot(deque, index), value, deque->elem_size);
+
+  return res;
+}
+
+DfResult dfdeque_length(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)deque->length;
+  return res;
+}
+
+DfResult dfdeque_capacity(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)deque->capacity;
+  return res;
+}
+
+// Iterator
+
+typedef struct DfDeque_Iterator
+{
+  DfDeque *deque;
+  size_t index;
+} DfDeque_Iterator;
+
+_Static_assert(sizeof(DfDeque_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfDeque_Iterator must fit in the embedded iterator state");
+
+int dfdeque_iterator_has_next(Iterator *it)
+{
+  DfDeque_Iterator *deque_it = (DfDeque_Iterator *)it->current;
+  return deque_it->index < deque_it->deque->length;
+}
+
+DfResult dfdeque_iterator_next(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfDeque_Iterator *deque_it = (DfDeque_Iterator *)it->current;
+
+  df_index_check_access(deque_it->index, deque_it->deque->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Elements are handed out in place, no copy is made
+  res.value = dfdeque_slot(deque_it->deque, deque_it->index++);
+  return res;
+}
+
+// Spans stop at the end of the ring buffer, so a wrapped deque takes two batches
+DfResult dfdeque_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfDeque_Iterator *deque_it = (DfDeque_Iterator *)it->current;
+  DfDeque *deque = deque_it->deque;
+
+  size_t remaining = deque->length - deque_it->index;
+  size_t count = remaining < max ? remaining : max;
+  if (count > 0)
+  {
+    size_t physical = (deque->head + deque_it->index) & (deque->capacity - 1);
+    size_t until_wrap = deque->capacity - physical;
+    count = count < until_wrap ? count : until_wrap;
+  }
+
+  span->count = count;
+  span->stride = deque->elem_size;
+  span->items = count ? dfdeque_slot(deque, deque_it->index) : NULL;
+
+  deque_it->index += count;
+  return res;
+}
+
+size_t dfdeque_iterator_remaining(Iterator *it)
+{
+  DfDeque_Iterator *deque_it = (DfDeque_Iterator *)it->current;
+  return deque_it->deque->length - deque_it->index;
+}
+
+// Read-only, and like next_batch stops at the end of the ring buffer
+DfResult dfdeque_iterator_span_at(Iterator *it, size_t offset, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfDeque_Iterator *deque_it = (DfDeque_Iterator *)it->current;
+  DfDeque *deque = deque_it->deque;
+
+  size_t remaining = deque->length - deque_it->index;
+  if (offset > remaining)
+  {
+    res.error = DF_ERR_INDEX_OUT_OF_BOUNDS;
+    return res;
+  }
+
+  size_t index = deque_it->index + offset;
+  size_t count = remaining - offset < max ? remaining - offset : max;
+  if (count > 0)
+  {
+    size_t physical = (deque->head + index) & (deque->capacity - 1);
+    size_t until_wrap = deque->capacity - physical;
+    count = count < until_wrap ? count : until_wrap;
+  }
+
+  span->count = count;
+  span->stride = deque->elem_size;
+  span->items = count ? dfdeque_slot(deque, index) : NULL;
+  return res;
+}
+
+DfResult dfdeque_create_new(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfDeque *deque = (DfDeque *)it->structure;
+  return dfdeque_create(deque->elem_size, deque->length);
+}
+
+DfResult dfdeque_insert_new(void *new_ds, void *element)
+{
+  return dfdeque_push_back((DfDeque *)new_ds, element);
+}
+
+size_t dfdeque_elem_size(Iterator *it)
+{
+  DfDeque *deque = (DfDeque *)it->structure;
+  return deque->elem_size;
+}
+
+DfResult dfdeque_free_all(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfDeque *deque = (DfDeque *)it->structure;
+
+  // Elements are stored by value, so emptying the deque releases them
+  deque->head = 0;
+  deque->length = 0;
+
+  return res;
+}
+
+DfResult dfdeque_iterator_init(Iterator *it, DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfDeque_Iterator *deque_it = (DfDeque_Iterator *)iterator_prepare(it, deque);
+  deque_it->deque = deque;
+  deque_it->index = 0;
+
+  it->next = dfdeque_iterator_next;
+  it->has_next = dfdeque_iterator_has_next;
+  it->create_new = dfdeque_create_new;
+  it->insert_new = dfdeque_insert_new;
+  it->elem_size = dfdeque_elem_size;
+  it->free_all = dfdeque_free_all;
+  it->next_batch = dfdeque_iterator_next_batch;
+  it->remaining = dfdeque_iterator_remaining;
+  it->span_at = dfdeque_iterator_span_at;
+
+  res.value = it;
+  return res;
+}
+
+DfResult dfdeque_iterator_create(DfDeque *deque)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(deque, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dfdeque_iterator_init((Iterator *)it_res.value, deque);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
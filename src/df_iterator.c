@@ -14,6 +14,9 @@ DfResult iterator_create()
         return res;
     }
 
+    // Callbacks a structure does not provide read as NULL; the state buffer is left uninitialized
+    iterator_prepare(it, NULL);
+
     res.value = it;
     return res;
 }
@@ -28,11 +31,41 @@ DfResult iterator_destroy(Iterator *it)
         return res;
     }
 
-    if (it->current)
+    // State placed in the embedded buffer goes away with the Iterator
+    if (it->current && it->current != (void *)it->state)
     {
         free(it->current);
-        it->current = NULL;
+    }
+    it->current = NULL;
+
+    return res;
+}
+
+DfResult iterator_free(Iterator *it)
+{
+    DfResult res = iterator_destroy(it);
+    if (res.error)
+    {
+        return res;
     }
 
+    free(it);
     return res;
 }
+
+void *iterator_prepare(Iterator *it, void *structure)
+{
+    it->structure = structure;
+    it->current = it->state;
+    it->next = NULL;
+    it->has_next = NULL;
+    it->create_new = NULL;
+    it->insert_new = NULL;
+    it->elem_size = NULL;
+    it->free_all = NULL;
+    it->next_batch = NULL;
+    it->remaining = NULL;
+    it->span_at = NULL;
+
+    return it->state;
+}
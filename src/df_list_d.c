@@ -0,0 +1,666 @@
+#include "../includes/df_list_d.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Doubly Linked
+typedef struct DfList_D
+{
+  DfList_D_Node *head;
+  DfList_D_Node *tail;
+  size_t length;
+  size_t prefetch_distance; // Nodes the traversal runner stays ahead, 0 when prefetching is off
+  bool prefetch_elements;   // Runner also prefetches the elements it passes
+} DfList_D;
+
+typedef struct DfList_D_Node
+{
+  void *element;
+  struct DfList_D_Node *next;
+  struct DfList_D_Node *prev;
+} DfList_D_Node;
+
+// Links a new node between prev and next, either of which may be NULL at the ends
+static DfResult dflist_d_link(DfList_D *list, DfList_D_Node *prev, DfList_D_Node *next, void *element)
+{
+  DfResult res = df_result_init();
+
+  DfList_D_Node *node = malloc(sizeof(DfList_D_Node));
+  if (!node)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  node->element = element;
+  node->prev = prev;
+  node->next = next;
+
+  if (prev)
+  {
+    prev->next = node;
+  }
+  else
+  {
+    list->head = node;
+  }
+
+  if (next)
+  {
+    next->prev = node;
+  }
+  else
+  {
+    list->tail = node;
+  }
+
+  list->length++;
+
+  res.value = node;
+  return res;
+}
+
+static void *dflist_d_unlink_node(DfList_D *list, DfList_D_Node *node)
+{
+  if (node->prev)
+  {
+    node->prev->next = node->next;
+  }
+  else
+  {
+    list->head = node->next;
+  }
+
+  if (node->next)
+  {
+    node->next->prev = node->prev;
+  }
+  else
+  {
+    list->tail = node->prev;
+  }
+
+  void *element = node->element;
+  free(node);
+  list->length--;
+
+  return element;
+}
+
+// Walks from whichever end is closer to index
+static DfList_D_Node *dflist_d_locate(DfList_D *list, size_t index)
+{
+  DfList_D_Node *node;
+
+  if (index < list->length / 2)
+  {
+    node = list->head;
+    for (size_t i = 0; i < index; i++)
+    {
+      node = node->next;
+    }
+  }
+  else
+  {
+    node = list->tail;
+    for (size_t i = list->length - 1; i > index; i--)
+    {
+      node = node->prev;
+    }
+  }
+
+  return node;
+}
+
+DfResult dflist_d_create()
+{
+  DfResult res = df_result_init();
+
+  DfList_D *list = malloc(sizeof(DfList_D));
+  if (!list)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  list->head = list->tail = NULL;
+  list->length = 0;
+  list->prefetch_distance = 0;
+  list->prefetch_elements = false;
+
+  res.value = list;
+  return res;
+}
+
+// Moves the prefetch runner one node on in the given direction; see dflist_s_prefetch_step
+static DfList_D_Node *dflist_d_prefetch_step(DfList_D *list, DfList_D_Node *ahead, bool reverse)
+{
+  if (!ahead)
+  {
+    return NULL;
+  }
+
+  if (list->prefetch_elements)
+  {
+    DF_PREFETCH(ahead->element);
+  }
+
+  ahead = reverse ? ahead->prev : ahead->next;
+  if (ahead)
+  {
+    DF_PREFETCH(ahead);
+  }
+  return ahead;
+}
+
+static DfList_D_Node *dflist_d_prefetch_start(DfList_D *list, DfList_D_Node *from, bool reverse)
+{
+  if (list->prefetch_distance == 0)
+  {
+    return NULL;
+  }
+
+  DfList_D_Node *ahead = from;
+  for (size_t i = 0; i < list->prefetch_distance && ahead; i++)
+  {
+    ahead = dflist_d_prefetch_step(list, ahead, reverse);
+  }
+  return ahead;
+}
+
+static void dflist_d_release_nodes(DfList_D *list, void (*cleanup)(void *element))
+{
+  DfList_D_Node *current = list->head;
+  DfList_D_Node *ahead = dflist_d_prefetch_start(list, current, false);
+  while (current)
+  {
+    DfList_D_Node *next = current->next;
+    if (cleanup)
+    {
+      cleanup(current->element);
+    }
+    free(current);
+    current = next;
+    ahead = dflist_d_prefetch_step(list, ahead, false);
+  }
+
+  list->head = list->tail = NULL;
+  list->length = 0;
+}
+
+DfResult dflist_d_destroy(DfList_D *list, void (*cleanup)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  dflist_d_release_nodes(list, cleanup);
+  free(list);
+
+  return res;
+}
+
+DfResult dflist_d_push_back(DfList_D *list, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dflist_d_link(list, list->tail, NULL, element);
+}
+
+DfResult dflist_d_push_front(DfList_D *list, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dflist_d_link(list, NULL, list->head, element);
+}
+
+DfResult dflist_d_pop_front(DfList_D *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = dflist_d_unlink_node(list, list->head);
+  return res;
+}
+
+DfResult dflist_d_pop_back(DfList_D *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->tail)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = dflist_d_unlink_node(list, list->tail);
+  return res;
+}
+
+DfResult dflist_d_insert_at(DfList_D *list, void *element, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (index == list->length)
+  {
+    return dflist_d_link(list, list->tail, NULL, element);
+  }
+
+  DfList_D_Node *next = dflist_d_locate(list, index);
+  return dflist_d_link(list, next->prev, next, element);
+}
+
+DfResult dflist_d_remove_at(DfList_D *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = dflist_d_unlink_node(list, dflist_d_locate(list, index));
+  return res;
+}
+
+DfResult dflist_d_get(DfList_D *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = dflist_d_locate(list, index)->element;
+  return res;
+}
+
+DfResult dflist_d_peek_front(DfList_D *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->head->element;
+  return res;
+}
+
+DfResult dflist_d_peek_back(DfList_D *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->tail)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->tail->element;
+  return res;
+}
+
+DfResult dflist_d_set_prefetch(DfList_D *list, size_t distance, bool elements)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  list->prefetch_distance = distance;
+  list->prefetch_elements = distance > 0 && elements;
+
+  return res;
+}
+
+DfResult dflist_d_length(DfList_D *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)list->length;
+  return res;
+}
+
+// Node handles
+
+DfResult dflist_d_insert_before(DfList_D *list, DfList_D_Node *node, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(node, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dflist_d_link(list, node->prev, node, element);
+}
+
+DfResult dflist_d_insert_after(DfList_D *list, DfList_D_Node *node, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(node, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dflist_d_link(list, node, node->next, element);
+}
+
+DfResult dflist_d_unlink(DfList_D *list, DfList_D_Node *node)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(node, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = dflist_d_unlink_node(list, node);
+  return res;
+}
+
+DfResult dflist_d_node_element(DfList_D_Node *node)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(node, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = node->element;
+  return res;
+}
+
+// Iterator
+
+typedef struct DfList_D_Iterator
+{
+  DfList_D *list;
+  DfList_D_Node *cur;
+  DfList_D_Node *ahead; // Prefetch runner, NULL when the list does not prefetch
+  bool reverse;
+  void *batch[DF_ITERATOR_BATCH];
+} DfList_D_Iterator;
+
+_Static_assert(sizeof(DfList_D_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfList_D_Iterator must fit in the embedded iterator state");
+
+int dflist_d_iterator_has_next(Iterator *it)
+{
+  DfList_D_Iterator *list_it = (DfList_D_Iterator *)it->current;
+  return list_it->cur != NULL;
+}
+
+DfResult dflist_d_iterator_next(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_D_Iterator *list_it = (DfList_D_Iterator *)it->current;
+
+  if (!list_it->cur)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = list_it->cur->element;
+  list_it->cur = list_it->reverse ? list_it->cur->prev : list_it->cur->next;
+  list_it->ahead = dflist_d_prefetch_step(list_it->list, list_it->ahead, list_it->reverse);
+  return res;
+}
+
+DfResult dflist_d_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_D_Iterator *list_it = (DfList_D_Iterator *)it->current;
+
+  size_t count = 0;
+  max = max < DF_ITERATOR_BATCH ? max : DF_ITERATOR_BATCH;
+  while (count < max && list_it->cur)
+  {
+    list_it->batch[count++] = list_it->cur->element;
+    list_it->cur = list_it->reverse ? list_it->cur->prev : list_it->cur->next;
+    list_it->ahead = dflist_d_prefetch_step(list_it->list, list_it->ahead, list_it->reverse);
+  }
+
+  span->items = list_it->batch;
+  span->count = count;
+  span->stride = 0;
+  return res;
+}
+
+DfResult dflist_d_create_new(Iterator *it)
+{
+  (void)it;
+  return dflist_d_create();
+}
+
+DfResult dflist_d_insert_new(void *new_ds, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(new_ds, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult push_res = dflist_d_push_back((DfList_D *)new_ds, element);
+  if (push_res.error)
+  {
+    return push_res;
+  }
+
+  return res;
+}
+
+DfResult dflist_d_free_all(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_D *list = (DfList_D *)it->structure;
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_ALREADY_FREED;
+    return res;
+  }
+
+  dflist_d_release_nodes(list, NULL);
+  return res;
+}
+
+static DfResult dflist_d_iterator_init_dir(Iterator *it, DfList_D *list, bool reverse)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_D_Iterator *list_it = (DfList_D_Iterator *)iterator_prepare(it, list);
+  list_it->list = list;
+  list_it->cur = reverse ? list->tail : list->head;
+  list_it->ahead = dflist_d_prefetch_start(list, list_it->cur, reverse);
+  list_it->reverse = reverse;
+
+  it->next = dflist_d_iterator_next;
+  it->has_next = dflist_d_iterator_has_next;
+  it->create_new = dflist_d_create_new;
+  it->insert_new = dflist_d_insert_new;
+  it->elem_size = NULL; // Elements are caller-owned pointers of unknown size
+  it->free_all = dflist_d_free_all;
+  it->next_batch = dflist_d_iterator_next_batch;
+
+  res.value = it;
+  return res;
+}
+
+static DfResult dflist_d_iterator_create_dir(DfList_D *list, bool reverse)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dflist_d_iterator_init_dir((Iterator *)it_res.value, list, reverse);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
+
+DfResult dflist_d_iterator_init(Iterator *it, DfList_D *list)
+{
+  return dflist_d_iterator_init_dir(it, list, false);
+}
+
+DfResult dflist_d_iterator_init_reverse(Iterator *it, DfList_D *list)
+{
+  return dflist_d_iterator_init_dir(it, list, true);
+}
+
+DfResult dflist_d_iterator_create(DfList_D *list)
+{
+  return dflist_d_iterator_create_dir(list, false);
+}
+
+DfResult dflist_d_iterator_create_reverse(DfList_D *list)
+{
+  return dflist_d_iterator_create_dir(list, true);
+}
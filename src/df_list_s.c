@@ -1,4 +1,5 @@
 #include "../includes/df_list_s.h"
+#include "../includes/df_slab.h"
 #include "../includes/df_common.h"
 #include "../internal/df_internal.h"
 #include <stdio.h>
@@ -10,6 +11,10 @@ typedef struct DfList_S
   DfList_S_Node *head;
   DfList_S_Node *tail;
   size_t length;
+  DfSlab *pool;             // Node allocator, NULL for malloc per node
+  bool owns_pool;           // Pool was created with the list and is released with it
+  size_t prefetch_distance; // Nodes the traversal runner stays ahead, 0 when prefetching is off
+  bool prefetch_elements;   // Runner also prefetches the elements it passes
 } DfList_S;
 
 typedef struct DfList_S_Node
@@ -31,12 +36,112 @@ DfResult dflist_s_create()
 
   list->head = list->tail = NULL;
   list->length = 0;
+  list->pool = NULL;
+  list->owns_pool = false;
+  list->prefetch_distance = 0;
+  list->prefetch_elements = false;
 
   res.value = list;
   return res;
 }
 
-DfResult dflist_s_destroy(DfList_S *list, void (*cleanup)(void *element))
+// Node size is private to this file, so shared pools are created here
+DfResult dflist_s_pool_create(size_t nodes_per_chunk)
+{
+  return dfslab_create(sizeof(DfList_S_Node), nodes_per_chunk ? nodes_per_chunk : DFLIST_S_POOL_CHUNK_NODES);
+}
+
+DfResult dflist_s_create_pooled(DfSlab *pool)
+{
+  DfResult res = df_result_init();
+
+  if (pool && (size_t)dfslab_object_size(pool).value < sizeof(DfList_S_Node))
+  {
+    res.error = DF_ERR_SIZE_MISMATCH;
+    return res;
+  }
+
+  DfSlab *own_pool = NULL;
+  if (!pool)
+  {
+    DfResult pool_res = dflist_s_pool_create(0);
+    if (pool_res.error)
+    {
+      return pool_res;
+    }
+    own_pool = pool_res.value;
+  }
+
+  res = dflist_s_create();
+  if (res.error)
+  {
+    if (own_pool)
+    {
+      dfslab_destroy(own_pool);
+    }
+    return res;
+  }
+
+  DfList_S *list = (DfList_S *)res.value;
+  list->pool = own_pool ? own_pool : pool;
+  list->owns_pool = own_pool != NULL;
+
+  return res;
+}
+
+DfResult dflist_s_pool(DfList_S *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = list->pool;
+  return res;
+}
+
+// Moves the prefetch runner one node on. The node it leaves was requested a step earlier, so
+// reading its link is cheap and its element can be requested now.
+static DfList_S_Node *dflist_s_prefetch_step(DfList_S *list, DfList_S_Node *ahead)
+{
+  if (!ahead)
+  {
+    return NULL;
+  }
+
+  if (list->prefetch_elements)
+  {
+    DF_PREFETCH(ahead->element);
+  }
+
+  ahead = ahead->next;
+  if (ahead)
+  {
+    DF_PREFETCH(ahead);
+  }
+  return ahead;
+}
+
+// Places a runner prefetch_distance nodes past from, or returns NULL when prefetching is off
+static DfList_S_Node *dflist_s_prefetch_start(DfList_S *list, DfList_S_Node *from)
+{
+  if (list->prefetch_distance == 0)
+  {
+    return NULL;
+  }
+
+  DfList_S_Node *ahead = from;
+  for (size_t i = 0; i < list->prefetch_distance && ahead; i++)
+  {
+    ahead = dflist_s_prefetch_step(list, ahead);
+  }
+  return ahead;
+}
+
+DfResult dflist_s_set_prefetch(DfList_S *list, size_t distance, bool elements)
 {
   DfResult res = df_result_init();
 
@@ -46,16 +151,76 @@ DfResult dflist_s_destroy(DfList_S *list, void (*cleanup)(void *element))
     return res;
   }
 
-  DfList_S_Node *current = list->head;
-  while (current)
+  list->prefetch_distance = distance;
+  list->prefetch_elements = distance > 0 && elements;
+
+  return res;
+}
+
+static void dflist_s_free_node(DfList_S *list, DfList_S_Node *node)
+{
+  if (list->pool)
+  {
+    dfslab_free(list->pool, node);
+  }
+  else
+  {
+    free(node);
+  }
+}
+
+// Releases every node; a private pool drops its chunks wholesale instead of taking nodes back one by one
+static void dflist_s_release_nodes(DfList_S *list, void (*cleanup)(void *element))
+{
+  if (list->owns_pool)
   {
-    DfList_S_Node *next = current->next;
     if (cleanup)
     {
-      cleanup(current->element);
+      DfList_S_Node *ahead = dflist_s_prefetch_start(list, list->head);
+      for (DfList_S_Node *cur = list->head; cur; cur = cur->next)
+      {
+        cleanup(cur->element);
+        ahead = dflist_s_prefetch_step(list, ahead);
+      }
+    }
+    dfslab_reset(list->pool);
+  }
+  else
+  {
+    DfList_S_Node *current = list->head;
+    DfList_S_Node *ahead = dflist_s_prefetch_start(list, current);
+    while (current)
+    {
+      DfList_S_Node *next = current->next;
+      if (cleanup)
+      {
+        cleanup(current->element);
+      }
+      dflist_s_free_node(list, current);
+      current = next;
+      ahead = dflist_s_prefetch_step(list, ahead);
     }
-    free(current);
-    current = next;
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+}
+
+DfResult dflist_s_destroy(DfList_S *list, void (*cleanup)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  dflist_s_release_nodes(list, cleanup);
+  if (list->owns_pool)
+  {
+    dfslab_destroy(list->pool);
   }
 
   free(list);
@@ -63,7 +228,7 @@ DfResult dflist_s_destroy(DfList_S *list, void (*cleanup)(void *element))
   return res;
 }
 
-DfResult dflist_s_create_node(void *element)
+DfResult dflist_s_create_node(DfList_S *list, void *element)
 {
   DfResult res = df_result_init();
 
@@ -73,7 +238,7 @@ DfResult dflist_s_create_node(void *element)
     return res;
   }
 
-  DfList_S_Node *new_node = malloc(sizeof(DfList_S_Node));
+  DfList_S_Node *new_node = list->pool ? dfslab_alloc(list->pool).value : malloc(sizeof(DfList_S_Node));
   if (!new_node)
   {
     res.error = DF_ERR_ALLOC_FAILED;
@@ -98,7 +263,7 @@ DfResult dflist_s_push_back(DfList_S *list, void *element)
     return res;
   }
 
-  DfResult new_node_res = dflist_s_create_node(element);
+  DfResult new_node_res = dflist_s_create_node(list, element);
   if (new_node_res.error)
   {
     return new_node_res;
@@ -133,7 +298,7 @@ DfResult dflist_s_push_front(DfList_S *list, void *element)
     return res;
   }
 
-  DfResult new_node_res = dflist_s_create_node(element);
+  DfResult new_node_res = dflist_s_create_node(list, element);
   if (new_node_res.error)
   {
     return new_node_res;
@@ -176,7 +341,11 @@ DfResult dflist_s_pop_front(DfList_S *list)
   DfList_S_Node *old_head = list->head;
   void *dest = old_head->element;
   list->head = old_head->next;
-  free(old_head);
+  if (!list->head)
+  {
+    list->tail = NULL;
+  }
+  dflist_s_free_node(list, old_head);
   list->length--;
 
   res.value = dest;
@@ -205,7 +374,7 @@ DfResult dflist_s_pop_back(DfList_S *list)
   if (list->head == list->tail)
   {
     dest = list->head->element;
-    free(list->head);
+    dflist_s_free_node(list, list->head);
     list->head = NULL;
     list->tail = NULL;
   }
@@ -219,7 +388,7 @@ DfResult dflist_s_pop_back(DfList_S *list)
     }
 
     dest = list->tail->element;
-    free(list->tail);
+    dflist_s_free_node(list, list->tail);
     list->tail = cur;
     list->tail->next = NULL;
   }
@@ -260,7 +429,7 @@ DfResult dflist_s_insert_at(DfList_S *list, void *element, size_t index)
     return push_back_res;
   }
 
-  DfResult new_node_res = dflist_s_create_node(element);
+  DfResult new_node_res = dflist_s_create_node(list, element);
   if (new_node_res.error != DF_OK)
   {
     return new_node_res;
@@ -318,7 +487,7 @@ DfResult dflist_s_remove_at(DfList_S *list, size_t index)
   DfList_S_Node *old = cur->next;
   cur->next = old->next;
   res.value = old->element;
-  free(old);
+  dflist_s_free_node(list, old);
   list->length--;
 
   return res;
@@ -404,136 +573,818 @@ DfResult dflist_s_length(DfList_S *list)
   return res;
 }
 
-// Iterator
+// Relinking
 
-typedef struct DfList_S_Iterator
+// Nodes can only change lists when both sides free them the same way
+static bool dflist_s_can_share_nodes(DfList_S *list, DfList_S *other)
 {
-  DfList_S *list;
-  DfList_S_Node *cur;
-} DfList_S_Iterator;
+  return list != other && list->pool == other->pool && !list->owns_pool && !other->owns_pool;
+}
 
-int dflist_s_iterator_has_next(Iterator *it)
+// Walks to the node before index; index must be in 1..length
+static DfList_S_Node *dflist_s_node_before(DfList_S *list, size_t index)
 {
-  DfList_S_Iterator *list_it = (DfList_S_Iterator *)it->current;
-  return list_it->cur != NULL && list_it->cur->next != NULL;
+  DfList_S_Node *cur = list->head;
+  for (size_t i = 0; i < index - 1; i++)
+  {
+    cur = cur->next;
+  }
+  return cur;
 }
 
-DfResult dflist_s_iterator_next(Iterator *it)
+// Creates an empty list that frees nodes the same way as list
+static DfResult dflist_s_create_sibling(DfList_S *list)
+{
+  DfResult res = dflist_s_create();
+  if (!res.error)
+  {
+    DfList_S *sibling = (DfList_S *)res.value;
+    sibling->pool = list->pool;
+    sibling->prefetch_distance = list->prefetch_distance;
+    sibling->prefetch_elements = list->prefetch_elements;
+  }
+  return res;
+}
+
+// Moves the nodes after prev (or all nodes when prev is NULL) into a new list holding length - kept elements
+static DfResult dflist_s_detach_after(DfList_S *list, DfList_S_Node *prev, size_t kept)
+{
+  DfResult res = dflist_s_create_sibling(list);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S *rest = (DfList_S *)res.value;
+  DfList_S_Node *first = prev ? prev->next : list->head;
+
+  if (first)
+  {
+    rest->head = first;
+    rest->tail = list->tail;
+    rest->length = list->length - kept;
+
+    if (prev)
+    {
+      prev->next = NULL;
+      list->tail = prev;
+    }
+    else
+    {
+      list->head = list->tail = NULL;
+    }
+    list->length = kept;
+  }
+
+  return res;
+}
+
+DfResult dflist_s_concat(DfList_S *list, DfList_S *other)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(it, &res);
-  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(other, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfList_S_Iterator *list_it = (DfList_S_Iterator *)it->current;
+  if (!dflist_s_can_share_nodes(list, other))
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
 
-  if (!list_it->cur || !list_it->cur->next)
+  if (!other->head)
   {
-    res.error = DF_ERR_END_OF_LIST;
     return res;
   }
 
-  list_it->cur = list_it->cur->next;
-  res.value = list_it->cur->element;
+  if (list->tail)
+  {
+    list->tail->next = other->head;
+  }
+  else
+  {
+    list->head = other->head;
+  }
+  list->tail = other->tail;
+  list->length += other->length;
+
+  other->head = other->tail = NULL;
+  other->length = 0;
+
   return res;
 }
 
-DfResult dflist_s_insert_new(void *new_ds, void *element)
+DfResult dflist_s_splice_at(DfList_S *list, DfList_S *other, size_t index)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(new_ds, &res);
-  df_null_ptr_check(element, &res);
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(other, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfList_S *list = (DfList_S *)new_ds;
+  df_index_check_insert(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
 
-  DfResult push_res = dflist_s_push_back(list, element);
-  if (push_res.error)
+  if (!dflist_s_can_share_nodes(list, other))
   {
-    return push_res;
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
+  if (!other->head)
+  {
+    return res;
+  }
+
+  if (index == list->length)
+  {
+    return dflist_s_concat(list, other);
+  }
+
+  if (index == 0)
+  {
+    other->tail->next = list->head;
+    list->head = other->head;
+  }
+  else
+  {
+    DfList_S_Node *prev = dflist_s_node_before(list, index);
+    other->tail->next = prev->next;
+    prev->next = other->head;
   }
+  list->length += other->length;
+
+  other->head = other->tail = NULL;
+  other->length = 0;
 
   return res;
 }
 
-DfResult dflist_s_free_all(Iterator *it)
+DfResult dflist_s_split_at(DfList_S *list, size_t index)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(it, &res);
-  df_null_ptr_check(it->structure, &res);
+  df_null_ptr_check(list, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfList_S *list = (DfList_S *)it->structure;
+  df_index_check_insert(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
 
-  if (!list->head)
+  if (list->owns_pool)
   {
-    res.error = DF_ERR_ALREADY_FREED;
+    res.error = DF_ERR_INCOMPATIBLE;
     return res;
   }
 
-  DfList_S_Node *cur = list->head;
-  while (cur)
+  DfList_S_Node *prev = index == 0 ? NULL : dflist_s_node_before(list, index);
+  return dflist_s_detach_after(list, prev, index);
+}
+
+// Sorting
+
+// Run slots for the bottom-up sort; slot i holds a sorted run of 2^i nodes, so 64 covers any list
+#define DFLIST_S_SORT_SLOTS 64
+
+// Stable: on ties the node from a, which came first, wins
+static DfList_S_Node *dflist_s_merge_runs(DfList_S_Node *a, DfList_S_Node *b, int (*cmp)(const void *a, const void *b))
+{
+  DfList_S_Node head;
+  DfList_S_Node *tail = &head;
+
+  while (a && b)
   {
-    DfList_S_Node *temp = cur->next;
-    free(cur);
-    cur = temp;
+    if (cmp(b->element, a->element) < 0)
+    {
+      tail->next = b;
+      b = b->next;
+    }
+    else
+    {
+      tail->next = a;
+      a = a->next;
+    }
+    tail = tail->next;
   }
+  tail->next = a ? a : b;
 
-  list->head = NULL;
-  list->tail = NULL;
-  list->length = 0;
-  return res;
+  return head.next;
 }
 
-DfResult dflist_s_iterator_create(DfList_S *list)
+static void dflist_s_fix_tail(DfList_S *list)
+{
+  DfList_S_Node *tail = list->head;
+  while (tail && tail->next)
+  {
+    tail = tail->next;
+  }
+  list->tail = tail;
+}
+
+DfResult dflist_s_sort(DfList_S *list, int (*cmp)(const void *a, const void *b))
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(list, &res);
+  df_null_ptr_check(cmp, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfList_S_Iterator *list_it = malloc(sizeof(DfList_S_Iterator));
-  if (!list_it)
+  if (list->length < 2)
   {
-    res.error = DF_ERR_ALLOC_FAILED;
     return res;
   }
 
-  list_it->list = list;
-  list_it->cur = list->head;
+  // Each node is carried up the slots like a binary counter; slots always hold earlier
+  // elements than the run being merged into them, which keeps the sort stable
+  DfList_S_Node *slots[DFLIST_S_SORT_SLOTS] = {NULL};
+  DfList_S_Node *node = list->head;
 
-  DfResult it_res = iterator_create();
-  if (it_res.error)
+  while (node)
   {
-    free(list_it);
-    return it_res;
+    DfList_S_Node *next = node->next;
+    DfList_S_Node *run = node;
+    size_t i = 0;
+
+    run->next = NULL;
+    for (; slots[i]; i++)
+    {
+      run = dflist_s_merge_runs(slots[i], run, cmp);
+      slots[i] = NULL;
+    }
+    slots[i] = run;
+
+    node = next;
   }
 
-  Iterator *it = (Iterator *)it_res.value;
+  DfList_S_Node *sorted = NULL;
+  for (size_t i = 0; i < DFLIST_S_SORT_SLOTS; i++)
+  {
+    if (slots[i])
+    {
+      sorted = dflist_s_merge_runs(slots[i], sorted, cmp);
+    }
+  }
 
-  it->structure = list;
-  it->current = list_it;
-  it->next = dflist_s_iterator_next;
-  it->has_next = dflist_s_iterator_has_next;
-  it->create_new = dflist_s_create;
-  it->insert_new = dflist_s_insert_new;
-  it->free_all = dflist_s_free_all;
+  list->head = sorted;
+  dflist_s_fix_tail(list);
 
-  res.value = it;
   return res;
-}
\ No newline at end of file
+}
+
+// Merges the sorted other into the sorted list in one linear pass; other is left empty
+DfResult dflist_s_merge(DfList_S *list, DfList_S *other, int (*cmp)(const void *a, const void *b))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(other, &res);
+  df_null_ptr_check(cmp, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!dflist_s_can_share_nodes(list, other))
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
+  if (!other->head)
+  {
+    return res;
+  }
+
+  // Everything in other sorts after list, so the merge is a concat
+  if (!list->tail || cmp(other->head->element, list->tail->element) >= 0)
+  {
+    return dflist_s_concat(list, other);
+  }
+
+  list->head = dflist_s_merge_runs(list->head, other->head, cmp);
+  list->length += other->length;
+
+  // The tail is whichever old tail sorts last; ties keep list's elements first
+  if (cmp(other->tail->element, list->tail->element) >= 0)
+  {
+    list->tail = other->tail;
+  }
+
+  other->head = other->tail = NULL;
+  other->length = 0;
+
+  return res;
+}
+
+// Iterator
+
+typedef struct DfList_S_Iterator
+{
+  DfList_S *list;
+  DfList_S_Node *prev;  // Last node returned, NULL before the first
+  DfList_S_Node *cur;   // Next node to return
+  size_t position;      // Index of cur, so a split at the iterator needs no walk
+  DfList_S_Node *ahead; // Prefetch runner, NULL when the list does not prefetch
+  void *batch[DF_ITERATOR_BATCH];
+} DfList_S_Iterator;
+
+_Static_assert(sizeof(DfList_S_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfList_S_Iterator must fit in the embedded iterator state");
+
+int dflist_s_iterator_has_next(Iterator *it)
+{
+  DfList_S_Iterator *list_it = (DfList_S_Iterator *)it->current;
+  return list_it->cur != NULL;
+}
+
+DfResult dflist_s_iterator_next(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Iterator *list_it = (DfList_S_Iterator *)it->current;
+
+  if (!list_it->cur)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = list_it->cur->element;
+  list_it->prev = list_it->cur;
+  list_it->cur = list_it->cur->next;
+  list_it->position++;
+  list_it->ahead = dflist_s_prefetch_step(list_it->list, list_it->ahead);
+  return res;
+}
+
+// Gathers element pointers into the iterator's buffer, following the same path as next()
+DfResult dflist_s_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Iterator *list_it = (DfList_S_Iterator *)it->current;
+
+  size_t count = 0;
+  max = max < DF_ITERATOR_BATCH ? max : DF_ITERATOR_BATCH;
+  while (count < max && list_it->cur)
+  {
+    list_it->batch[count++] = list_it->cur->element;
+    list_it->prev = list_it->cur;
+    list_it->cur = list_it->cur->next;
+    list_it->ahead = dflist_s_prefetch_step(list_it->list, list_it->ahead);
+  }
+  list_it->position += count;
+
+  span->items = list_it->batch;
+  span->count = count;
+  span->stride = 0;
+  return res;
+}
+
+DfResult dflist_s_insert_new(void *new_ds, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(new_ds, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S *list = (DfList_S *)new_ds;
+
+  DfResult push_res = dflist_s_push_back(list, element);
+  if (push_res.error)
+  {
+    return push_res;
+  }
+
+  return res;
+}
+
+DfResult dflist_s_free_all(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S *list = (DfList_S *)it->structure;
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_ALREADY_FREED;
+    return res;
+  }
+
+  dflist_s_release_nodes(list, NULL);
+  return res;
+}
+
+DfResult dflist_s_iterator_init(Iterator *it, DfList_S *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Iterator *list_it = (DfList_S_Iterator *)iterator_prepare(it, list);
+  list_it->list = list;
+  list_it->prev = NULL;
+  list_it->cur = list->head;
+  list_it->position = 0;
+  list_it->ahead = dflist_s_prefetch_start(list, list->head);
+
+  it->next = dflist_s_iterator_next;
+  it->has_next = dflist_s_iterator_has_next;
+  it->create_new = dflist_s_create;
+  it->insert_new = dflist_s_insert_new;
+  it->free_all = dflist_s_free_all;
+  it->next_batch = dflist_s_iterator_next_batch;
+
+  res.value = it;
+  return res;
+}
+
+DfResult dflist_s_iterator_create(DfList_S *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dflist_s_iterator_init((Iterator *)it_res.value, list);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
+
+// Splits off everything the iterator has not returned yet; the iterator is exhausted afterwards
+DfResult dflist_s_split_at_iterator(DfList_S *list, Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(it, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (it->next != dflist_s_iterator_next || it->structure != list || list->owns_pool)
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
+  DfList_S_Iterator *list_it = (DfList_S_Iterator *)it->current;
+  if (!list_it->cur)
+  {
+    return dflist_s_create_sibling(list);
+  }
+
+  res = dflist_s_detach_after(list, list_it->prev, list_it->position);
+  list_it->cur = NULL;
+  return res;
+}
+
+// Cursor
+
+// The cursor stores the node before its position, so the current node is always prev->next
+// (or head) and removing it needs no walk
+typedef struct DfList_S_Cursor
+{
+  DfList_S *list;
+  DfList_S_Node *prev;
+} DfList_S_Cursor;
+
+static DfList_S_Node *dflist_s_cursor_node(DfList_S_Cursor *cursor)
+{
+  return cursor->prev ? cursor->prev->next : cursor->list->head;
+}
+
+// Unlinks the node after prev (or the head) and fixes up tail and length
+static void *dflist_s_unlink_after(DfList_S *list, DfList_S_Node *prev)
+{
+  DfList_S_Node *node = prev ? prev->next : list->head;
+
+  if (prev)
+  {
+    prev->next = node->next;
+  }
+  else
+  {
+    list->head = node->next;
+  }
+
+  if (node == list->tail)
+  {
+    list->tail = prev;
+  }
+
+  void *element = node->element;
+  dflist_s_free_node(list, node);
+  list->length--;
+
+  return element;
+}
+
+DfResult dflist_s_cursor_create(DfList_S *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Cursor *cursor = malloc(sizeof(DfList_S_Cursor));
+  if (!cursor)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  cursor->list = list;
+  cursor->prev = NULL;
+
+  res.value = cursor;
+  return res;
+}
+
+DfResult dflist_s_cursor_destroy(DfList_S_Cursor *cursor)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  free(cursor);
+  return res;
+}
+
+DfResult dflist_s_cursor_reset(DfList_S_Cursor *cursor)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  cursor->prev = NULL;
+  return res;
+}
+
+bool dflist_s_cursor_at_end(DfList_S_Cursor *cursor)
+{
+  return !cursor || !dflist_s_cursor_node(cursor);
+}
+
+DfResult dflist_s_cursor_get(DfList_S_Cursor *cursor)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Node *node = dflist_s_cursor_node(cursor);
+  if (!node)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = node->element;
+  return res;
+}
+
+DfResult dflist_s_cursor_advance(DfList_S_Cursor *cursor)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Node *node = dflist_s_cursor_node(cursor);
+  if (!node)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  cursor->prev = node;
+  return res;
+}
+
+// Swaps the element at the cursor and returns the old one
+DfResult dflist_s_cursor_replace(DfList_S_Cursor *cursor, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Node *node = dflist_s_cursor_node(cursor);
+  if (!node)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = node->element;
+  node->element = element;
+  return res;
+}
+
+// Inserts in front of the cursor (appends when it is at the end); the cursor stays on the same element
+DfResult dflist_s_cursor_insert_before(DfList_S_Cursor *cursor, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S *list = cursor->list;
+
+  DfResult new_node_res = dflist_s_create_node(list, element);
+  if (new_node_res.error)
+  {
+    return new_node_res;
+  }
+
+  DfList_S_Node *new_node = (DfList_S_Node *)new_node_res.value;
+  new_node->next = dflist_s_cursor_node(cursor);
+
+  if (cursor->prev)
+  {
+    cursor->prev->next = new_node;
+  }
+  else
+  {
+    list->head = new_node;
+  }
+
+  if (!new_node->next)
+  {
+    list->tail = new_node;
+  }
+
+  cursor->prev = new_node;
+  list->length++;
+
+  return res;
+}
+
+// Inserts behind the cursor; the cursor stays on the same element
+DfResult dflist_s_cursor_insert_after(DfList_S_Cursor *cursor, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S *list = cursor->list;
+  DfList_S_Node *node = dflist_s_cursor_node(cursor);
+  if (!node)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  DfResult new_node_res = dflist_s_create_node(list, element);
+  if (new_node_res.error)
+  {
+    return new_node_res;
+  }
+
+  DfList_S_Node *new_node = (DfList_S_Node *)new_node_res.value;
+  new_node->next = node->next;
+  node->next = new_node;
+
+  if (node == list->tail)
+  {
+    list->tail = new_node;
+  }
+  list->length++;
+
+  return res;
+}
+
+// Removes the element at the cursor and returns it; the cursor moves on to the next element
+DfResult dflist_s_cursor_remove(DfList_S_Cursor *cursor)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!dflist_s_cursor_node(cursor))
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = dflist_s_unlink_after(cursor->list, cursor->prev);
+  return res;
+}
+
+// Removes the element behind the cursor and returns it
+DfResult dflist_s_cursor_remove_after(DfList_S_Cursor *cursor)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(cursor, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_S_Node *node = dflist_s_cursor_node(cursor);
+  if (!node || !node->next)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = dflist_s_unlink_after(cursor->list, node);
+  return res;
+}
@@ -0,0 +1,699 @@
+#include "../includes/df_list_u.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Unrolled
+typedef struct DfList_U
+{
+  DfList_U_Node *head;
+  DfList_U_Node *tail;
+  size_t length;
+  size_t node_count;
+} DfList_U;
+
+typedef struct DfList_U_Node
+{
+  struct DfList_U_Node *next;
+  struct DfList_U_Node *prev;
+  size_t count;
+  void *elements[DFLIST_U_NODE_CAPACITY];
+} DfList_U_Node;
+
+_Static_assert(sizeof(DfList_U_Node) <= 256, "DfList_U_Node should fit in four cache lines");
+
+// Nodes that drop below this fill are merged with their successor when both fit in one node
+#define DFLIST_U_MERGE_THRESHOLD (DFLIST_U_NODE_CAPACITY / 2)
+
+static DfList_U_Node *dflist_u_new_node(void)
+{
+  DfList_U_Node *node = malloc(sizeof(DfList_U_Node));
+  if (node)
+  {
+    node->next = NULL;
+    node->prev = NULL;
+    node->count = 0;
+  }
+  return node;
+}
+
+static void dflist_u_link_after(DfList_U *list, DfList_U_Node *node, DfList_U_Node *new_node)
+{
+  new_node->prev = node;
+  new_node->next = node ? node->next : list->head;
+  if (new_node->next)
+  {
+    new_node->next->prev = new_node;
+  }
+  else
+  {
+    list->tail = new_node;
+  }
+
+  if (node)
+  {
+    node->next = new_node;
+  }
+  else
+  {
+    list->head = new_node;
+  }
+
+  list->node_count++;
+}
+
+static void dflist_u_unlink(DfList_U *list, DfList_U_Node *node)
+{
+  if (node->prev)
+  {
+    node->prev->next = node->next;
+  }
+  else
+  {
+    list->head = node->next;
+  }
+
+  if (node->next)
+  {
+    node->next->prev = node->prev;
+  }
+  else
+  {
+    list->tail = node->prev;
+  }
+
+  list->node_count--;
+  free(node);
+}
+
+// Finds the node holding index, walking from whichever end is closer
+static DfList_U_Node *dflist_u_locate(DfList_U *list, size_t index, size_t *offset)
+{
+  if (index < list->length / 2)
+  {
+    DfList_U_Node *node = list->head;
+    while (index >= node->count)
+    {
+      index -= node->count;
+      node = node->next;
+    }
+    *offset = index;
+    return node;
+  }
+
+  size_t from_back = list->length - index;
+  DfList_U_Node *node = list->tail;
+  while (from_back > node->count)
+  {
+    from_back -= node->count;
+    node = node->prev;
+  }
+  *offset = node->count - from_back;
+  return node;
+}
+
+// Moves the upper half of a full node into a new node after it
+static DfResult dflist_u_split(DfList_U *list, DfList_U_Node *node)
+{
+  DfResult res = df_result_init();
+
+  DfList_U_Node *new_node = dflist_u_new_node();
+  if (!new_node)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  size_t keep = node->count / 2;
+  new_node->count = node->count - keep;
+  memcpy(new_node->elements, node->elements + keep, new_node->count * sizeof(void *));
+  node->count = keep;
+  dflist_u_link_after(list, node, new_node);
+
+  res.value = new_node;
+  return res;
+}
+
+// Appends the elements of node->next to node and frees the emptied successor
+static void dflist_u_merge_next(DfList_U *list, DfList_U_Node *node)
+{
+  DfList_U_Node *next = node->next;
+  memcpy(node->elements + node->count, next->elements, next->count * sizeof(void *));
+  node->count += next->count;
+  dflist_u_unlink(list, next);
+}
+
+// Merges an underfull node with a neighbour when both fit in one node, or frees it once empty
+static void dflist_u_rebalance(DfList_U *list, DfList_U_Node *node)
+{
+  if (node->count == 0)
+  {
+    dflist_u_unlink(list, node);
+    return;
+  }
+
+  if (node->count >= DFLIST_U_MERGE_THRESHOLD)
+  {
+    return;
+  }
+
+  if (node->next && node->count + node->next->count <= DFLIST_U_NODE_CAPACITY)
+  {
+    dflist_u_merge_next(list, node);
+  }
+  else if (node->prev && node->prev->count + node->count <= DFLIST_U_NODE_CAPACITY)
+  {
+    dflist_u_merge_next(list, node->prev);
+  }
+}
+
+DfResult dflist_u_create()
+{
+  DfResult res = df_result_init();
+
+  DfList_U *list = malloc(sizeof(DfList_U));
+  if (!list)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  list->head = list->tail = NULL;
+  list->length = 0;
+  list->node_count = 0;
+
+  res.value = list;
+  return res;
+}
+
+static void dflist_u_release_nodes(DfList_U *list, void (*cleanup)(void *element))
+{
+  DfList_U_Node *current = list->head;
+  while (current)
+  {
+    DfList_U_Node *next = current->next;
+    if (cleanup)
+    {
+      for (size_t i = 0; i < current->count; i++)
+      {
+        cleanup(current->elements[i]);
+      }
+    }
+    free(current);
+    current = next;
+  }
+
+  list->head = list->tail = NULL;
+  list->length = 0;
+  list->node_count = 0;
+}
+
+DfResult dflist_u_destroy(DfList_U *list, void (*cleanup)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  dflist_u_release_nodes(list, cleanup);
+  free(list);
+
+  return res;
+}
+
+DfResult dflist_u_push_back(DfList_U *list, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Appending to a full tail starts a new node so earlier nodes stay full
+  if (!list->tail || list->tail->count == DFLIST_U_NODE_CAPACITY)
+  {
+    DfList_U_Node *node = dflist_u_new_node();
+    if (!node)
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+    dflist_u_link_after(list, list->tail, node);
+  }
+
+  list->tail->elements[list->tail->count++] = element;
+  list->length++;
+
+  return res;
+}
+
+DfResult dflist_u_push_front(DfList_U *list, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->head || list->head->count == DFLIST_U_NODE_CAPACITY)
+  {
+    DfList_U_Node *node = dflist_u_new_node();
+    if (!node)
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+    dflist_u_link_after(list, NULL, node);
+  }
+
+  DfList_U_Node *head = list->head;
+  memmove(head->elements + 1, head->elements, head->count * sizeof(void *));
+  head->elements[0] = element;
+  head->count++;
+  list->length++;
+
+  return res;
+}
+
+DfResult dflist_u_pop_front(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  DfList_U_Node *head = list->head;
+  res.value = head->elements[0];
+  head->count--;
+  memmove(head->elements, head->elements + 1, head->count * sizeof(void *));
+  list->length--;
+
+  if (head->count == 0)
+  {
+    dflist_u_unlink(list, head);
+  }
+
+  return res;
+}
+
+DfResult dflist_u_pop_back(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->tail)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  DfList_U_Node *tail = list->tail;
+  res.value = tail->elements[--tail->count];
+  list->length--;
+
+  if (tail->count == 0)
+  {
+    dflist_u_unlink(list, tail);
+  }
+
+  return res;
+}
+
+DfResult dflist_u_insert_at(DfList_U *list, void *element, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (index == list->length)
+  {
+    return dflist_u_push_back(list, element);
+  }
+
+  size_t offset;
+  DfList_U_Node *node = dflist_u_locate(list, index, &offset);
+
+  if (node->count == DFLIST_U_NODE_CAPACITY)
+  {
+    DfResult split_res = dflist_u_split(list, node);
+    if (split_res.error)
+    {
+      return split_res;
+    }
+
+    if (offset > node->count)
+    {
+      offset -= node->count;
+      node = split_res.value;
+    }
+  }
+
+  memmove(node->elements + offset + 1, node->elements + offset, (node->count - offset) * sizeof(void *));
+  node->elements[offset] = element;
+  node->count++;
+  list->length++;
+
+  return res;
+}
+
+DfResult dflist_u_remove_at(DfList_U *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t offset;
+  DfList_U_Node *node = dflist_u_locate(list, index, &offset);
+
+  res.value = node->elements[offset];
+  node->count--;
+  memmove(node->elements + offset, node->elements + offset + 1, (node->count - offset) * sizeof(void *));
+  list->length--;
+
+  dflist_u_rebalance(list, node);
+
+  return res;
+}
+
+DfResult dflist_u_get(DfList_U *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t offset;
+  DfList_U_Node *node = dflist_u_locate(list, index, &offset);
+
+  res.value = node->elements[offset];
+  return res;
+}
+
+DfResult dflist_u_peek_front(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->head->elements[0];
+  return res;
+}
+
+DfResult dflist_u_peek_back(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!list->tail)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->tail->elements[list->tail->count - 1];
+  return res;
+}
+
+DfResult dflist_u_length(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)list->length;
+  return res;
+}
+
+DfResult dflist_u_node_count(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)list->node_count;
+  return res;
+}
+
+// Iterator
+
+typedef struct DfList_U_Iterator
+{
+  DfList_U *list;
+  DfList_U_Node *node;
+  size_t offset;
+} DfList_U_Iterator;
+
+_Static_assert(sizeof(DfList_U_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfList_U_Iterator must fit in the embedded iterator state");
+
+int dflist_u_iterator_has_next(Iterator *it)
+{
+  DfList_U_Iterator *list_it = (DfList_U_Iterator *)it->current;
+  return list_it->node != NULL && list_it->offset < list_it->node->count;
+}
+
+DfResult dflist_u_iterator_next(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_U_Iterator *list_it = (DfList_U_Iterator *)it->current;
+
+  if (!list_it->node || list_it->offset >= list_it->node->count)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = list_it->node->elements[list_it->offset++];
+
+  if (list_it->offset == list_it->node->count)
+  {
+    list_it->node = list_it->node->next;
+    list_it->offset = 0;
+  }
+
+  return res;
+}
+
+// Hands out the rest of the current node's element array, so spans never cross nodes
+DfResult dflist_u_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_U_Iterator *list_it = (DfList_U_Iterator *)it->current;
+
+  span->items = NULL;
+  span->count = 0;
+  span->stride = 0;
+
+  if (!list_it->node || list_it->offset >= list_it->node->count)
+  {
+    return res;
+  }
+
+  size_t remaining = list_it->node->count - list_it->offset;
+  span->items = &list_it->node->elements[list_it->offset];
+  span->count = remaining < max ? remaining : max;
+
+  list_it->offset += span->count;
+  if (list_it->offset == list_it->node->count)
+  {
+    list_it->node = list_it->node->next;
+    list_it->offset = 0;
+  }
+
+  return res;
+}
+
+DfResult dflist_u_create_new(Iterator *it)
+{
+  (void)it;
+  return dflist_u_create();
+}
+
+DfResult dflist_u_insert_new(void *new_ds, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(new_ds, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult push_res = dflist_u_push_back((DfList_U *)new_ds, element);
+  if (push_res.error)
+  {
+    return push_res;
+  }
+
+  return res;
+}
+
+DfResult dflist_u_free_all(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_U *list = (DfList_U *)it->structure;
+
+  if (!list->head)
+  {
+    res.error = DF_ERR_ALREADY_FREED;
+    return res;
+  }
+
+  dflist_u_release_nodes(list, NULL);
+  return res;
+}
+
+DfResult dflist_u_iterator_init(Iterator *it, DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_U_Iterator *list_it = (DfList_U_Iterator *)iterator_prepare(it, list);
+  list_it->list = list;
+  list_it->node = list->head;
+  list_it->offset = 0;
+
+  it->next = dflist_u_iterator_next;
+  it->has_next = dflist_u_iterator_has_next;
+  it->create_new = dflist_u_create_new;
+  it->insert_new = dflist_u_insert_new;
+  it->elem_size = NULL; // Elements are caller-owned pointers of unknown size
+  it->free_all = dflist_u_free_all;
+  it->next_batch = dflist_u_iterator_next_batch;
+
+  res.value = it;
+  return res;
+}
+
+DfResult dflist_u_iterator_create(DfList_U *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dflist_u_iterator_init((Iterator *)it_res.value, list);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
@@ -0,0 +1,679 @@
+#include "../includes/df_list_v.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Value-storing, singly linked
+typedef struct DfList_V
+{
+  DfList_V_Node *head;
+  DfList_V_Node *tail;
+  size_t length;
+  size_t elem_size;
+  size_t prefetch_distance; // Nodes the traversal runner stays ahead, 0 when prefetching is off
+  size_t prefetch_lines;    // Cache lines the runner requests per node: 1, or the whole payload
+} DfList_V;
+
+typedef struct DfList_V_Node
+{
+  struct DfList_V_Node *next;
+  max_align_t payload[]; // elem_size bytes, aligned for any element type
+} DfList_V_Node;
+
+static DfList_V_Node *dflist_v_new_node(DfList_V *list, void *value)
+{
+  DfList_V_Node *node = malloc(offsetof(DfList_V_Node, payload) + list->elem_size);
+  if (node)
+  {
+    node->next = NULL;
+    memcpy(node->payload, value, list->elem_size);
+  }
+  return node;
+}
+
+// Walks to the node at index; index must be below length
+static DfList_V_Node *dflist_v_locate(DfList_V *list, size_t index)
+{
+  if (index == list->length - 1)
+  {
+    return list->tail;
+  }
+
+  DfList_V_Node *node = list->head;
+  for (size_t i = 0; i < index; i++)
+  {
+    node = node->next;
+  }
+  return node;
+}
+
+// Unlinks the node after prev (or the head), copies its payload out if dest is set and frees it
+static void dflist_v_unlink_after(DfList_V *list, DfList_V_Node *prev, void *dest)
+{
+  DfList_V_Node *node = prev ? prev->next : list->head;
+
+  if (prev)
+  {
+    prev->next = node->next;
+  }
+  else
+  {
+    list->head = node->next;
+  }
+
+  if (node == list->tail)
+  {
+    list->tail = prev;
+  }
+
+  if (dest)
+  {
+    memcpy(dest, node->payload, list->elem_size);
+  }
+  free(node);
+  list->length--;
+}
+
+// Moves the prefetch runner one node on; see dflist_s_prefetch_step. The payload is inside the
+// node, so asking for elements means requesting every line the node covers.
+static DfList_V_Node *dflist_v_prefetch_step(DfList_V *list, DfList_V_Node *ahead)
+{
+  if (!ahead)
+  {
+    return NULL;
+  }
+
+  ahead = ahead->next;
+  if (ahead)
+  {
+    for (size_t line = 0; line < list->prefetch_lines; line++)
+    {
+      DF_PREFETCH((char *)ahead + line * DF_CACHE_LINE);
+    }
+  }
+  return ahead;
+}
+
+// Places a runner prefetch_distance nodes past from, or returns NULL when prefetching is off
+static DfList_V_Node *dflist_v_prefetch_start(DfList_V *list, DfList_V_Node *from)
+{
+  if (list->prefetch_distance == 0)
+  {
+    return NULL;
+  }
+
+  DfList_V_Node *ahead = from;
+  for (size_t i = 0; i < list->prefetch_distance && ahead; i++)
+  {
+    ahead = dflist_v_prefetch_step(list, ahead);
+  }
+  return ahead;
+}
+
+static void dflist_v_release_nodes(DfList_V *list)
+{
+  DfList_V_Node *current = list->head;
+  DfList_V_Node *ahead = dflist_v_prefetch_start(list, current);
+  while (current)
+  {
+    DfList_V_Node *next = current->next;
+    free(current);
+    current = next;
+    ahead = dflist_v_prefetch_step(list, ahead);
+  }
+
+  list->head = NULL;
+  list->tail = NULL;
+  list->length = 0;
+}
+
+DfResult dflist_v_create(size_t elem_size)
+{
+  DfResult res = df_result_init();
+
+  if (elem_size == 0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  DfList_V *list = malloc(sizeof(DfList_V));
+  if (!list)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  list->head = list->tail = NULL;
+  list->length = 0;
+  list->elem_size = elem_size;
+  list->prefetch_distance = 0;
+  list->prefetch_lines = 0;
+
+  res.value = list;
+  return res;
+}
+
+DfResult dflist_v_set_prefetch(DfList_V *list, size_t distance, bool elements)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t node_size = offsetof(DfList_V_Node, payload) + list->elem_size;
+  list->prefetch_distance = distance;
+  list->prefetch_lines = elements ? (node_size + DF_CACHE_LINE - 1) / DF_CACHE_LINE : 1;
+
+  return res;
+}
+
+DfResult dflist_v_destroy(DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Elements live inside the nodes, so freeing the nodes releases them
+  dflist_v_release_nodes(list);
+  free(list);
+
+  return res;
+}
+
+DfResult dflist_v_push_back(DfList_V *list, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_V_Node *node = dflist_v_new_node(list, value);
+  if (!node)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  if (list->tail)
+  {
+    list->tail->next = node;
+  }
+  else
+  {
+    list->head = node;
+  }
+  list->tail = node;
+  list->length++;
+
+  return res;
+}
+
+DfResult dflist_v_push_front(DfList_V *list, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_V_Node *node = dflist_v_new_node(list, value);
+  if (!node)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  node->next = list->head;
+  list->head = node;
+  if (!list->tail)
+  {
+    list->tail = node;
+  }
+  list->length++;
+
+  return res;
+}
+
+DfResult dflist_v_pop_front_into(DfList_V *list, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(dest, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  dflist_v_unlink_after(list, NULL, dest);
+  return res;
+}
+
+DfResult dflist_v_pop_back_into(DfList_V *list, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(dest, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  DfList_V_Node *prev = list->length == 1 ? NULL : dflist_v_locate(list, list->length - 2);
+  dflist_v_unlink_after(list, prev, dest);
+  return res;
+}
+
+static DfResult dflist_v_pop_copy(DfList_V *list, DfResult (*pop_into)(DfList_V *, void *))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  void *dest = malloc(list->elem_size);
+  if (!dest)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfResult pop_res = pop_into(list, dest);
+  if (pop_res.error)
+  {
+    free(dest);
+    return pop_res;
+  }
+
+  res.value = dest;
+  return res;
+}
+
+DfResult dflist_v_pop_front(DfList_V *list)
+{
+  return dflist_v_pop_copy(list, dflist_v_pop_front_into);
+}
+
+DfResult dflist_v_pop_back(DfList_V *list)
+{
+  return dflist_v_pop_copy(list, dflist_v_pop_back_into);
+}
+
+DfResult dflist_v_insert_at(DfList_V *list, void *value, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (index == 0)
+  {
+    return dflist_v_push_front(list, value);
+  }
+
+  if (index == list->length)
+  {
+    return dflist_v_push_back(list, value);
+  }
+
+  DfList_V_Node *node = dflist_v_new_node(list, value);
+  if (!node)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfList_V_Node *prev = dflist_v_locate(list, index - 1);
+  node->next = prev->next;
+  prev->next = node;
+  list->length++;
+
+  return res;
+}
+
+// Removes the element at index; its value is copied to dest unless dest is NULL
+DfResult dflist_v_remove_at(DfList_V *list, size_t index, void *dest)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_V_Node *prev = index == 0 ? NULL : dflist_v_locate(list, index - 1);
+  dflist_v_unlink_after(list, prev, dest);
+  return res;
+}
+
+DfResult dflist_v_get(DfList_V *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = dflist_v_locate(list, index)->payload;
+  return res;
+}
+
+DfResult dflist_v_set(DfList_V *list, size_t index, void *value)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(value, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  memcpy(dflist_v_locate(list, index)->payload, value, list->elem_size);
+  return res;
+}
+
+DfResult dflist_v_peek_front(DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->head->payload;
+  return res;
+}
+
+DfResult dflist_v_peek_back(DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->tail->payload;
+  return res;
+}
+
+DfResult dflist_v_length(DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)list->length;
+  return res;
+}
+
+DfResult dflist_v_elem_size(DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)list->elem_size;
+  return res;
+}
+
+// Iterator
+
+typedef struct DfList_V_Iterator
+{
+  DfList_V *list;
+  DfList_V_Node *cur;
+  DfList_V_Node *ahead; // Prefetch runner, NULL when the list does not prefetch
+  void *batch[DF_ITERATOR_BATCH];
+} DfList_V_Iterator;
+
+_Static_assert(sizeof(DfList_V_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfList_V_Iterator must fit in the embedded iterator state");
+
+int dflist_v_iterator_has_next(Iterator *it)
+{
+  DfList_V_Iterator *list_it = (DfList_V_Iterator *)it->current;
+  return list_it->cur != NULL;
+}
+
+DfResult dflist_v_iterator_next(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_V_Iterator *list_it = (DfList_V_Iterator *)it->current;
+
+  if (!list_it->cur)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  // Elements are handed out in place, no copy is made
+  res.value = list_it->cur->payload;
+  list_it->cur = list_it->cur->next;
+  list_it->ahead = dflist_v_prefetch_step(list_it->list, list_it->ahead);
+  return res;
+}
+
+DfResult dflist_v_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_V_Iterator *list_it = (DfList_V_Iterator *)it->current;
+
+  size_t count = 0;
+  max = max < DF_ITERATOR_BATCH ? max : DF_ITERATOR_BATCH;
+  while (count < max && list_it->cur)
+  {
+    list_it->batch[count++] = list_it->cur->payload;
+    list_it->cur = list_it->cur->next;
+    list_it->ahead = dflist_v_prefetch_step(list_it->list, list_it->ahead);
+  }
+
+  span->items = list_it->batch;
+  span->count = count;
+  span->stride = 0;
+  return res;
+}
+
+DfResult dflist_v_create_new(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dflist_v_create(((DfList_V *)it->structure)->elem_size);
+}
+
+DfResult dflist_v_insert_new(void *new_ds, void *element)
+{
+  return dflist_v_push_back((DfList_V *)new_ds, element);
+}
+
+size_t dflist_v_iterator_elem_size(Iterator *it)
+{
+  DfList_V *list = (DfList_V *)it->structure;
+  return list->elem_size;
+}
+
+DfResult dflist_v_free_all(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  dflist_v_release_nodes((DfList_V *)it->structure);
+  return res;
+}
+
+DfResult dflist_v_iterator_init(Iterator *it, DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfList_V_Iterator *list_it = (DfList_V_Iterator *)iterator_prepare(it, list);
+  list_it->list = list;
+  list_it->cur = list->head;
+  list_it->ahead = dflist_v_prefetch_start(list, list->head);
+
+  it->next = dflist_v_iterator_next;
+  it->has_next = dflist_v_iterator_has_next;
+  it->create_new = dflist_v_create_new;
+  it->insert_new = dflist_v_insert_new;
+  it->elem_size = dflist_v_iterator_elem_size;
+  it->free_all = dflist_v_free_all;
+  it->next_batch = dflist_v_iterator_next_batch;
+
+  res.value = it;
+  return res;
+}
+
+DfResult dflist_v_iterator_create(DfList_V *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dflist_v_iterator_init((Iterator *)it_res.value, list);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
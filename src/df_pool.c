@@ -0,0 +1,752 @@
+#include "../includes/df_pool.h"
+#include "../includes/df_queue.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define DFPOOL_CACHE_LINE 64
+
+// Starting slots in a worker deque, doubled whenever it fills
+#define DFPOOL_DEQUE_CAPACITY 64
+
+// Rounds of failed searches a worker spins through before it sleeps
+#define DFPOOL_SPIN_ROUNDS 64
+
+typedef struct DfPool_Task
+{
+  void (*run)(void *arg);
+  void *arg;
+  DfWait_Group *group;
+} DfPool_Task;
+
+// Circular buffer under a Chase-Lev deque; replaced, never resized, when it fills
+typedef struct DfPool_Ring
+{
+  size_t capacity; // Power of two
+  struct DfPool_Ring *retired; // Older rings, kept until destroy since thieves may still read them
+  _Atomic(DfPool_Task *) slots[];
+} DfPool_Ring;
+
+typedef struct DfPool_Worker
+{
+  _Alignas(DFPOOL_CACHE_LINE) atomic_llong top; // Thieves take from here
+  _Alignas(DFPOOL_CACHE_LINE) atomic_llong bottom; // The owner pushes and pops here
+  _Atomic(DfPool_Ring *) ring;
+
+  DfPool *pool;
+  size_t index;
+  uint64_t seed; // Victim selection
+  pthread_t thread;
+
+  atomic_size_t executed;
+  atomic_size_t steals;
+  atomic_size_t failed_steals;
+  atomic_size_t idle_sleeps;
+} DfPool_Worker;
+
+typedef struct DfPool
+{
+  DfPool_Worker *workers;
+  size_t worker_count;
+  DfQueue *injected; // Tasks submitted from threads outside the pool
+
+  _Alignas(DFPOOL_CACHE_LINE) atomic_size_t pending; // Submitted and not yet taken
+  atomic_size_t submitted;
+  atomic_size_t external_executed; // Tasks run by helping threads outside the pool
+  atomic_bool stopping;
+
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  atomic_size_t sleepers;
+} DfPool;
+
+typedef struct DfWait_Group
+{
+  atomic_size_t count;
+  pthread_mutex_t lock;
+  pthread_cond_t zero;
+} DfWait_Group;
+
+// The worker running on this thread, if any
+static _Thread_local DfPool_Worker *dfpool_current;
+
+// Chase-Lev deque, after Le, Pop, Cohen and Zappa Nardelli's C11 formulation
+
+static DfPool_Ring *dfpool_ring_create(size_t capacity)
+{
+  DfPool_Ring *ring = malloc(sizeof(DfPool_Ring) + capacity * sizeof(_Atomic(DfPool_Task *)));
+  if (!ring)
+  {
+    return NULL;
+  }
+
+  ring->capacity = capacity;
+  ring->retired = NULL;
+  return ring;
+}
+
+static bool dfpool_deque_push(DfPool_Worker *worker, DfPool_Task *task)
+{
+  long long bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed);
+  long long top = atomic_load_explicit(&worker->top, memory_order_acquire);
+  DfPool_Ring *ring = atomic_load_explicit(&worker->ring, memory_order_relaxed);
+
+  if (bottom - top > (long long)ring->capacity - 1)
+  {
+    DfPool_Ring *grown = dfpool_ring_create(ring->capacity * 2);
+    if (!grown)
+    {
+      return false;
+    }
+
+    for (long long i = top; i < bottom; i++)
+    {
+      DfPool_Task *moved = atomic_load_explicit(&ring->slots[i & (ring->capacity - 1)], memory_order_relaxed);
+      atomic_store_explicit(&grown->slots[i & (grown->capacity - 1)], moved, memory_order_relaxed);
+    }
+
+    grown->retired = ring;
+    atomic_store_explicit(&worker->ring, grown, memory_order_release);
+    ring = grown;
+  }
+
+  atomic_store_explicit(&ring->slots[bottom & (ring->capacity - 1)], task, memory_order_relaxed);
+  atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_release);
+  return true;
+}
+
+static DfPool_Task *dfpool_deque_pop(DfPool_Worker *worker)
+{
+  long long bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed) - 1;
+  DfPool_Ring *ring = atomic_load_explicit(&worker->ring, memory_order_relaxed);
+  // Seq_cst store and load rather than a fence: the store must be visible before top is read
+  atomic_store_explicit(&worker->bottom, bottom, memory_order_seq_cst);
+  long long top = atomic_load_explicit(&worker->top, memory_order_seq_cst);
+
+  if (top > bottom)
+  {
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+    return NULL;
+  }
+
+  DfPool_Task *task = atomic_load_explicit(&ring->slots[bottom & (ring->capacity - 1)], memory_order_relaxed);
+  if (top == bottom)
+  {
+    // Last task: race thieves for it
+    if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+    {
+      task = NULL;
+    }
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+  }
+
+  return task;
+}
+
+// NULL with *lost set when another thread won the race for the task
+static DfPool_Task *dfpool_deque_steal(DfPool_Worker *victim, bool *lost)
+{
+  long long top = atomic_load_explicit(&victim->top, memory_order_seq_cst);
+  long long bottom = atomic_load_explicit(&victim->bottom, memory_order_seq_cst);
+
+  *lost = false;
+  if (top >= bottom)
+  {
+    return NULL;
+  }
+
+  DfPool_Ring *ring = atomic_load_explicit(&victim->ring, memory_order_acquire);
+  DfPool_Task *task = atomic_load_explicit(&ring->slots[top & (ring->capacity - 1)], memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit(&victim->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+  {
+    *lost = true;
+    return NULL;
+  }
+
+  return task;
+}
+
+// Scheduling
+
+static uint64_t dfpool_next_random(uint64_t *seed)
+{
+  *seed ^= *seed << 13;
+  *seed ^= *seed >> 7;
+  *seed ^= *seed << 17;
+  return *seed;
+}
+
+// Own deque first, then the shared queue, then the other workers starting at a random one.
+// self is NULL for threads outside the pool, which can still take shared tasks and steal.
+static DfPool_Task *dfpool_find_task(DfPool *pool, DfPool_Worker *self)
+{
+  DfPool_Task *task = self ? dfpool_deque_pop(self) : NULL;
+
+  if (!task)
+  {
+    DfResult injected_res = dfqueue_pop(pool->injected);
+    task = injected_res.error ? NULL : (DfPool_Task *)injected_res.value;
+  }
+
+  if (!task)
+  {
+    static _Thread_local uint64_t outside_seed = 0x9E3779B97F4A7C15ULL;
+    size_t start = (size_t)(dfpool_next_random(self ? &self->seed : &outside_seed) % pool->worker_count);
+
+    for (size_t i = 0; i < pool->worker_count && !task; i++)
+    {
+      DfPool_Worker *victim = &pool->workers[(start + i) % pool->worker_count];
+      if (victim == self)
+      {
+        continue;
+      }
+
+      bool lost;
+      task = dfpool_deque_steal(victim, &lost);
+      if (self)
+      {
+        atomic_fetch_add_explicit(task ? &self->steals : &self->failed_steals, 1, memory_order_relaxed);
+      }
+    }
+  }
+
+  if (task)
+  {
+    atomic_fetch_sub(&pool->pending, 1);
+  }
+  return task;
+}
+
+static void dfpool_run_task(DfPool *pool, DfPool_Worker *self, DfPool_Task *task)
+{
+  DfWait_Group *group = task->group;
+
+  task->run(task->arg);
+  free(task);
+
+  atomic_fetch_add_explicit(self ? &self->executed : &pool->external_executed, 1, memory_order_relaxed);
+  if (group)
+  {
+    dfwaitgroup_done(group);
+  }
+}
+
+static void *dfpool_worker_main(void *arg)
+{
+  DfPool_Worker *self = (DfPool_Worker *)arg;
+  DfPool *pool = self->pool;
+  dfpool_current = self;
+
+  size_t idle_rounds = 0;
+  for (;;)
+  {
+    DfPool_Task *task = dfpool_find_task(pool, self);
+    if (task)
+    {
+      dfpool_run_task(pool, self, task);
+      idle_rounds = 0;
+      continue;
+    }
+
+    if (atomic_load(&pool->pending) > 0 || ++idle_rounds < DFPOOL_SPIN_ROUNDS)
+    {
+      sched_yield();
+      continue;
+    }
+    idle_rounds = 0;
+
+    // Submitters read sleepers after bumping pending, so one of the two sides sees the other
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add(&pool->sleepers, 1);
+    bool stop = false;
+    while (atomic_load(&pool->pending) == 0 && !(stop = atomic_load(&pool->stopping)))
+    {
+      atomic_fetch_add_explicit(&self->idle_sleeps, 1, memory_order_relaxed);
+      pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+    atomic_fetch_sub(&pool->sleepers, 1);
+    pthread_mutex_unlock(&pool->lock);
+
+    // Tasks still running can submit more, so only stop once nothing is pending
+    if (stop)
+    {
+      break;
+    }
+  }
+
+  dfpool_current = NULL;
+  return NULL;
+}
+
+static void dfpool_wake(DfPool *pool, bool all)
+{
+  if (atomic_load(&pool->sleepers) == 0)
+  {
+    return;
+  }
+
+  pthread_mutex_lock(&pool->lock);
+  if (all)
+  {
+    pthread_cond_broadcast(&pool->wake);
+  }
+  else
+  {
+    pthread_cond_signal(&pool->wake);
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+// Pool
+
+DfResult dfpool_create(size_t workers)
+{
+  DfResult res = df_result_init();
+
+  if (workers == 0)
+  {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    workers = online > 0 ? (size_t)online : 1;
+  }
+
+  size_t size = (sizeof(DfPool) + DFPOOL_CACHE_LINE - 1) & ~(size_t)(DFPOOL_CACHE_LINE - 1);
+  DfPool *pool = aligned_alloc(DFPOOL_CACHE_LINE, size);
+  if (!pool)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+  memset(pool, 0, size);
+
+  DfResult queue_res = dfqueue_create(0);
+  pool->workers = aligned_alloc(DFPOOL_CACHE_LINE, workers * sizeof(DfPool_Worker));
+  if (queue_res.error || !pool->workers)
+  {
+    if (!queue_res.error)
+    {
+      dfqueue_destroy(queue_res.value, NULL);
+    }
+    free(pool->workers);
+    free(pool);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  pool->injected = (DfQueue *)queue_res.value;
+  pool->worker_count = workers;
+  atomic_init(&pool->pending, 0);
+  atomic_init(&pool->submitted, 0);
+  atomic_init(&pool->external_executed, 0);
+  atomic_init(&pool->stopping, false);
+  atomic_init(&pool->sleepers, 0);
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->wake, NULL);
+
+  // Rings are set up for every worker before any thread starts, since threads steal from all of them
+  size_t ready = 0;
+  for (; ready < workers; ready++)
+  {
+    DfPool_Worker *worker = &pool->workers[ready];
+    memset(worker, 0, sizeof(*worker));
+
+    DfPool_Ring *ring = dfpool_ring_create(DFPOOL_DEQUE_CAPACITY);
+    if (!ring)
+    {
+      break;
+    }
+
+    atomic_init(&worker->top, 0);
+    atomic_init(&worker->bottom, 0);
+    atomic_init(&worker->ring, ring);
+    worker->pool = pool;
+    worker->index = ready;
+    worker->seed = 0x9E3779B97F4A7C15ULL * (ready + 1);
+    atomic_init(&worker->executed, 0);
+    atomic_init(&worker->steals, 0);
+    atomic_init(&worker->failed_steals, 0);
+    atomic_init(&worker->idle_sleeps, 0);
+  }
+
+  size_t started = 0;
+  if (ready == workers)
+  {
+    for (; started < workers; started++)
+    {
+      if (pthread_create(&pool->workers[started].thread, NULL, dfpool_worker_main, &pool->workers[started]) != 0)
+      {
+        break;
+      }
+    }
+  }
+
+  if (started < workers)
+  {
+    atomic_store(&pool->stopping, true);
+    dfpool_wake(pool, true);
+    for (size_t i = 0; i < started; i++)
+    {
+      pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (size_t i = 0; i < ready; i++)
+    {
+      free(atomic_load(&pool->workers[i].ring));
+    }
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    dfqueue_destroy(pool->injected, NULL);
+    free(pool->workers);
+    free(pool);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  res.value = pool;
+  return res;
+}
+
+DfResult dfpool_destroy(DfPool *pool)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(pool, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  atomic_store(&pool->stopping, true);
+  pthread_mutex_lock(&pool->lock);
+  pthread_cond_broadcast(&pool->wake);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (size_t i = 0; i < pool->worker_count; i++)
+  {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+
+  for (size_t i = 0; i < pool->worker_count; i++)
+  {
+    DfPool_Ring *ring = atomic_load(&pool->workers[i].ring);
+    while (ring)
+    {
+      DfPool_Ring *older = ring->retired;
+      free(ring);
+      ring = older;
+    }
+  }
+
+  pthread_cond_destroy(&pool->wake);
+  pthread_mutex_destroy(&pool->lock);
+  dfqueue_destroy(pool->injected, NULL);
+  free(pool->workers);
+  free(pool);
+
+  return res;
+}
+
+DfResult dfpool_submit(DfPool *pool, void (*task)(void *arg), void *arg, DfWait_Group *group)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(pool, &res);
+  df_null_ptr_check(task, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfPool_Task *queued = malloc(sizeof(DfPool_Task));
+  if (!queued)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  queued->run = task;
+  queued->arg = arg;
+  queued->group = group;
+
+  if (group)
+  {
+    dfwaitgroup_add(group, 1);
+  }
+
+  // Counted before it becomes visible so a worker never takes a task pending does not include
+  atomic_fetch_add(&pool->pending, 1);
+
+  DfPool_Worker *self = dfpool_current;
+  bool pushed = self && self->pool == pool && dfpool_deque_push(self, queued);
+  if (!pushed)
+  {
+    DfResult push_res = dfqueue_push(pool->injected, queued);
+    if (push_res.error)
+    {
+      atomic_fetch_sub(&pool->pending, 1);
+      if (group)
+      {
+        dfwaitgroup_done(group);
+      }
+      free(queued);
+      return push_res;
+    }
+  }
+
+  atomic_fetch_add_explicit(&pool->submitted, 1, memory_order_relaxed);
+  dfpool_wake(pool, false);
+  return res;
+}
+
+// Waits for group while running the pool's tasks on this thread, so a worker never blocks its own
+// queue and an outside caller lends a hand instead of idling
+static void dfpool_wait_helping(DfPool *pool, DfWait_Group *group)
+{
+  DfPool_Worker *self = dfpool_current && dfpool_current->pool == pool ? dfpool_current : NULL;
+
+  while (atomic_load(&group->count) > 0)
+  {
+    DfPool_Task *task = dfpool_find_task(pool, self);
+    if (task)
+    {
+      dfpool_run_task(pool, self, task);
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+
+  // The last dfwaitgroup_done may still hold the lock; taking it makes destroying the group safe
+  pthread_mutex_lock(&group->lock);
+  pthread_mutex_unlock(&group->lock);
+}
+
+typedef struct DfPool_Range
+{
+  DfPool *pool;
+  size_t begin;
+  size_t end;
+  size_t grain;
+  void (*body)(size_t begin, size_t end, void *arg);
+  void *arg;
+  DfWait_Group *group;
+} DfPool_Range;
+
+// Splits off right halves for others to steal until the range is down to grain, then runs it
+static void dfpool_range_task(void *arg)
+{
+  DfPool_Range *range = (DfPool_Range *)arg;
+
+  while (range->end - range->begin > range->grain)
+  {
+    DfPool_Range *right = malloc(sizeof(DfPool_Range));
+    if (!right)
+    {
+      break;
+    }
+
+    // right belongs to whoever runs it once submitted, so the split point is kept here
+    size_t middle = range->begin + (range->end - range->begin) / 2;
+    *right = *range;
+    right->begin = middle;
+    if (dfpool_submit(range->pool, dfpool_range_task, right, range->group).error)
+    {
+      free(right);
+      break;
+    }
+    range->end = middle;
+  }
+
+  range->body(range->begin, range->end, range->arg);
+  free(range);
+}
+
+DfResult dfpool_parallel_for(DfPool *pool, size_t begin, size_t end, size_t grain, void (*body)(size_t begin, size_t end, void *arg), void *arg)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(pool, &res);
+  df_null_ptr_check(body, &res);
+  if (res.error || begin >= end)
+  {
+    return res;
+  }
+
+  if (grain == 0)
+  {
+    grain = (end - begin) / (pool->worker_count * DFPOOL_CHUNKS_PER_WORKER);
+    grain = grain ? grain : 1;
+  }
+
+  DfResult group_res = dfwaitgroup_create();
+  if (group_res.error)
+  {
+    return group_res;
+  }
+  DfWait_Group *group = (DfWait_Group *)group_res.value;
+
+  DfPool_Range *range = malloc(sizeof(DfPool_Range));
+  if (!range)
+  {
+    dfwaitgroup_destroy(group);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+  *range = (DfPool_Range){pool, begin, end, grain, body, arg, group};
+
+  DfResult submit_res = dfpool_submit(pool, dfpool_range_task, range, group);
+  if (submit_res.error)
+  {
+    free(range);
+    dfwaitgroup_destroy(group);
+    return submit_res;
+  }
+
+  dfpool_wait_helping(pool, group);
+  dfwaitgroup_destroy(group);
+
+  return res;
+}
+
+DfResult dfpool_stats(DfPool *pool, DfPool_Stats *stats)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(pool, &res);
+  df_null_ptr_check(stats, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  memset(stats, 0, sizeof(*stats));
+  stats->workers = pool->worker_count;
+  stats->submitted = atomic_load_explicit(&pool->submitted, memory_order_relaxed);
+  stats->executed = atomic_load_explicit(&pool->external_executed, memory_order_relaxed);
+
+  for (size_t i = 0; i < pool->worker_count; i++)
+  {
+    DfPool_Worker *worker = &pool->workers[i];
+    stats->executed += atomic_load_explicit(&worker->executed, memory_order_relaxed);
+    stats->steals += atomic_load_explicit(&worker->steals, memory_order_relaxed);
+    stats->failed_steals += atomic_load_explicit(&worker->failed_steals, memory_order_relaxed);
+    stats->idle_sleeps += atomic_load_explicit(&worker->idle_sleeps, memory_order_relaxed);
+  }
+
+  res.value = stats;
+  return res;
+}
+
+// Wait group
+
+DfResult dfwaitgroup_create()
+{
+  DfResult res = df_result_init();
+
+  DfWait_Group *group = malloc(sizeof(DfWait_Group));
+  if (!group)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  atomic_init(&group->count, 0);
+  pthread_mutex_init(&group->lock, NULL);
+  pthread_cond_init(&group->zero, NULL);
+
+  res.value = group;
+  return res;
+}
+
+DfResult dfwaitgroup_destroy(DfWait_Group *group)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(group, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  pthread_cond_destroy(&group->zero);
+  pthread_mutex_destroy(&group->lock);
+  free(group);
+
+  return res;
+}
+
+DfResult dfwaitgroup_add(DfWait_Group *group, size_t count)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(group, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  atomic_fetch_add(&group->count, count);
+  return res;
+}
+
+DfResult dfwaitgroup_done(DfWait_Group *group)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(group, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Decrementing under the lock keeps a waiter from destroying the group mid-broadcast
+  pthread_mutex_lock(&group->lock);
+  size_t before = atomic_load(&group->count);
+  if (before == 0)
+  {
+    pthread_mutex_unlock(&group->lock);
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  if (atomic_fetch_sub(&group->count, 1) == 1)
+  {
+    pthread_cond_broadcast(&group->zero);
+  }
+  pthread_mutex_unlock(&group->lock);
+
+  return res;
+}
+
+DfResult dfwaitgroup_wait(DfWait_Group *group)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(group, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Blocking a worker could leave the tasks the group waits on queued behind it
+  if (dfpool_current)
+  {
+    dfpool_wait_helping(dfpool_current->pool, group);
+    return res;
+  }
+
+  pthread_mutex_lock(&group->lock);
+  while (atomic_load(&group->count) > 0)
+  {
+    pthread_cond_wait(&group->zero, &group->lock);
+  }
+  pthread_mutex_unlock(&group->lock);
+
+  return res;
+}
@@ -0,0 +1,381 @@
+#include "../includes/df_queue.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define DFQUEUE_CACHE_LINE 64
+
+typedef struct DfQueue_Node
+{
+  void *element;
+  _Atomic(struct DfQueue_Node *) next;
+} DfQueue_Node;
+
+// A thread slot: the hazard pointers it publishes and the nodes it has retired.
+// Only the thread holding the slot touches the retired list.
+typedef struct DfQueue_Hazard
+{
+  _Alignas(DFQUEUE_CACHE_LINE) _Atomic(DfQueue_Node *) pointers[2];
+  atomic_bool active;
+  DfQueue_Node **retired;
+  size_t retired_count;
+} DfQueue_Hazard;
+
+typedef struct DfQueue
+{
+  _Alignas(DFQUEUE_CACHE_LINE) _Atomic(DfQueue_Node *) head;
+  _Alignas(DFQUEUE_CACHE_LINE) _Atomic(DfQueue_Node *) tail;
+  _Alignas(DFQUEUE_CACHE_LINE) atomic_size_t length;
+  size_t capacity;
+  DfQueue_Hazard hazards[DFQUEUE_MAX_THREADS];
+} DfQueue;
+
+// Each thread starts its slot search at its own offset so slots are rarely contended
+static atomic_size_t dfqueue_next_hint;
+static _Thread_local size_t dfqueue_hint = SIZE_MAX;
+
+static DfQueue_Hazard *dfqueue_acquire(DfQueue *queue)
+{
+  if (dfqueue_hint == SIZE_MAX)
+  {
+    dfqueue_hint = atomic_fetch_add(&dfqueue_next_hint, 1) % DFQUEUE_MAX_THREADS;
+  }
+
+  for (;;)
+  {
+    for (size_t i = 0; i < DFQUEUE_MAX_THREADS; i++)
+    {
+      size_t slot = (dfqueue_hint + i) % DFQUEUE_MAX_THREADS;
+      DfQueue_Hazard *hazard = &queue->hazards[slot];
+      bool expected = false;
+
+      if (!atomic_load_explicit(&hazard->active, memory_order_relaxed) &&
+          atomic_compare_exchange_strong(&hazard->active, &expected, true))
+      {
+        dfqueue_hint = slot;
+        return hazard;
+      }
+    }
+    sched_yield();
+  }
+}
+
+static void dfqueue_release(DfQueue_Hazard *hazard)
+{
+  atomic_store(&hazard->pointers[0], NULL);
+  atomic_store(&hazard->pointers[1], NULL);
+  atomic_store_explicit(&hazard->active, false, memory_order_release);
+}
+
+// Publishes *source as hazardous and returns it once it is known to still be current
+static DfQueue_Node *dfqueue_protect(_Atomic(DfQueue_Node *) *pointer, _Atomic(DfQueue_Node *) *source)
+{
+  DfQueue_Node *node = atomic_load(source);
+  for (;;)
+  {
+    atomic_store(pointer, node);
+    DfQueue_Node *current = atomic_load(source);
+    if (current == node)
+    {
+      return node;
+    }
+    node = current;
+  }
+}
+
+static bool dfqueue_is_hazard(DfQueue_Node **hazards, size_t count, DfQueue_Node *node)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if (hazards[i] == node)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Frees every retired node that no thread currently has published
+static void dfqueue_scan(DfQueue *queue, DfQueue_Hazard *hazard)
+{
+  DfQueue_Node *hazards[2 * DFQUEUE_MAX_THREADS];
+  size_t hazard_count = 0;
+
+  for (size_t i = 0; i < DFQUEUE_MAX_THREADS; i++)
+  {
+    for (size_t j = 0; j < 2; j++)
+    {
+      DfQueue_Node *node = atomic_load(&queue->hazards[i].pointers[j]);
+      if (node)
+      {
+        hazards[hazard_count++] = node;
+      }
+    }
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < hazard->retired_count; i++)
+  {
+    DfQueue_Node *node = hazard->retired[i];
+    if (dfqueue_is_hazard(hazards, hazard_count, node))
+    {
+      hazard->retired[kept++] = node;
+    }
+    else
+    {
+      free(node);
+    }
+  }
+  hazard->retired_count = kept;
+}
+
+static void dfqueue_retire(DfQueue *queue, DfQueue_Hazard *hazard, DfQueue_Node *node)
+{
+  hazard->retired[hazard->retired_count++] = node;
+  if (hazard->retired_count == DFQUEUE_RETIRE_THRESHOLD)
+  {
+    dfqueue_scan(queue, hazard);
+  }
+}
+
+DfResult dfqueue_create(size_t capacity)
+{
+  DfResult res = df_result_init();
+
+  size_t size = (sizeof(DfQueue) + DFQUEUE_CACHE_LINE - 1) & ~(size_t)(DFQUEUE_CACHE_LINE - 1);
+  DfQueue *queue = aligned_alloc(DFQUEUE_CACHE_LINE, size);
+  if (!queue)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfQueue_Node *dummy = malloc(sizeof(DfQueue_Node));
+  if (!dummy)
+  {
+    free(queue);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  dummy->element = NULL;
+  atomic_init(&dummy->next, NULL);
+
+  atomic_init(&queue->head, dummy);
+  atomic_init(&queue->tail, dummy);
+  atomic_init(&queue->length, 0);
+  queue->capacity = capacity;
+
+  for (size_t i = 0; i < DFQUEUE_MAX_THREADS; i++)
+  {
+    atomic_init(&queue->hazards[i].pointers[0], NULL);
+    atomic_init(&queue->hazards[i].pointers[1], NULL);
+    atomic_init(&queue->hazards[i].active, false);
+    queue->hazards[i].retired = NULL;
+    queue->hazards[i].retired_count = 0;
+  }
+
+  res.value = queue;
+  return res;
+}
+
+DfResult dfqueue_destroy(DfQueue *queue, void (*cleanup)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(queue, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // The head is the dummy; every node after it still holds a live element
+  DfQueue_Node *node = atomic_load(&queue->head);
+  DfQueue_Node *next = atomic_load(&node->next);
+  free(node);
+
+  while (next)
+  {
+    node = next;
+    next = atomic_load(&node->next);
+    if (cleanup)
+    {
+      cleanup(node->element);
+    }
+    free(node);
+  }
+
+  for (size_t i = 0; i < DFQUEUE_MAX_THREADS; i++)
+  {
+    DfQueue_Hazard *hazard = &queue->hazards[i];
+    for (size_t j = 0; j < hazard->retired_count; j++)
+    {
+      free(hazard->retired[j]);
+    }
+    free(hazard->retired);
+  }
+
+  free(queue);
+  return res;
+}
+
+DfResult dfqueue_push(DfQueue *queue, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(queue, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Reserve room first so a full queue never grows past its capacity
+  size_t length = atomic_fetch_add(&queue->length, 1);
+  if (queue->capacity && length >= queue->capacity)
+  {
+    atomic_fetch_sub(&queue->length, 1);
+    res.error = DF_ERR_FULL;
+    return res;
+  }
+
+  DfQueue_Node *node = malloc(sizeof(DfQueue_Node));
+  if (!node)
+  {
+    atomic_fetch_sub(&queue->length, 1);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  node->element = element;
+  atomic_init(&node->next, NULL);
+
+  DfQueue_Hazard *hazard = dfqueue_acquire(queue);
+
+  for (;;)
+  {
+    DfQueue_Node *tail = dfqueue_protect(&hazard->pointers[0], &queue->tail);
+    DfQueue_Node *next = atomic_load(&tail->next);
+
+    if (tail != atomic_load(&queue->tail))
+    {
+      continue;
+    }
+
+    // Another push linked a node but has not swung the tail yet; help it along
+    if (next)
+    {
+      atomic_compare_exchange_weak(&queue->tail, &tail, next);
+      continue;
+    }
+
+    DfQueue_Node *expected = NULL;
+    if (atomic_compare_exchange_weak(&tail->next, &expected, node))
+    {
+      atomic_compare_exchange_strong(&queue->tail, &tail, node);
+      break;
+    }
+  }
+
+  dfqueue_release(hazard);
+  return res;
+}
+
+DfResult dfqueue_pop(DfQueue *queue)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(queue, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfQueue_Hazard *hazard = dfqueue_acquire(queue);
+
+  if (!hazard->retired)
+  {
+    hazard->retired = malloc(DFQUEUE_RETIRE_THRESHOLD * sizeof(DfQueue_Node *));
+    if (!hazard->retired)
+    {
+      dfqueue_release(hazard);
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+  }
+
+  DfQueue_Node *head;
+  for (;;)
+  {
+    head = dfqueue_protect(&hazard->pointers[0], &queue->head);
+    DfQueue_Node *tail = atomic_load(&queue->tail);
+    DfQueue_Node *next = atomic_load(&head->next);
+    atomic_store(&hazard->pointers[1], next);
+
+    if (head != atomic_load(&queue->head))
+    {
+      continue;
+    }
+
+    if (!next)
+    {
+      dfqueue_release(hazard);
+      res.error = DF_ERR_EMPTY;
+      return res;
+    }
+
+    if (head == tail)
+    {
+      atomic_compare_exchange_weak(&queue->tail, &tail, next);
+      continue;
+    }
+
+    // next becomes the new dummy, so its element has to be read before the swing
+    void *element = next->element;
+    if (atomic_compare_exchange_weak(&queue->head, &head, next))
+    {
+      res.value = element;
+      break;
+    }
+  }
+
+  atomic_store(&hazard->pointers[0], NULL);
+  atomic_store(&hazard->pointers[1], NULL);
+  dfqueue_retire(queue, hazard, head);
+  dfqueue_release(hazard);
+
+  atomic_fetch_sub(&queue->length, 1);
+  return res;
+}
+
+DfResult dfqueue_length(DfQueue *queue)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(queue, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)atomic_load(&queue->length);
+  return res;
+}
+
+DfResult dfqueue_capacity(DfQueue *queue)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(queue, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)queue->capacity;
+  return res;
+}
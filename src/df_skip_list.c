@@ -0,0 +1,653 @@
+#include "../includes/df_skip_list.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Positions are 1-based with the head at 0. A link's width is the distance to the
+// node it points at; a NULL link measures the distance to position length + 1.
+typedef struct DfSkipList_Link
+{
+  struct DfSkipList_Node *next;
+  size_t width;
+} DfSkipList_Link;
+
+typedef struct DfSkipList_Node
+{
+  void *element;
+  size_t level;
+  DfSkipList_Link links[];
+} DfSkipList_Node;
+
+typedef struct DfSkipList
+{
+  DfSkipList_Node *head;
+  DfSkipList_Node *tail;
+  size_t length;
+  size_t level;
+  uint64_t rng;
+  size_t prefetch_distance; // Nodes the bottom-level runner stays ahead, 0 when prefetching is off
+  bool prefetch_elements;   // Runner also prefetches the elements it passes
+} DfSkipList;
+
+static DfSkipList_Node *dfskiplist_new_node(void *element, size_t level)
+{
+  DfSkipList_Node *node = malloc(sizeof(DfSkipList_Node) + level * sizeof(DfSkipList_Link));
+  if (node)
+  {
+    node->element = element;
+    node->level = level;
+  }
+  return node;
+}
+
+// xorshift64; promotes with probability 1/4 per level
+static size_t dfskiplist_random_level(DfSkipList *list)
+{
+  uint64_t x = list->rng;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  list->rng = x;
+
+  size_t level = 1;
+  while ((x & 3) == 0 && level < DFSKIPLIST_MAX_LEVEL)
+  {
+    level++;
+    x >>= 2;
+  }
+  return level;
+}
+
+// Fills update[i] with the last node before position on each level and rank[i] with its position
+static void dfskiplist_find_before(DfSkipList *list, size_t position, DfSkipList_Node **update, size_t *rank)
+{
+  DfSkipList_Node *node = list->head;
+  size_t traversed = 0;
+
+  for (size_t i = list->level; i-- > 0;)
+  {
+    while (node->links[i].next && traversed + node->links[i].width < position)
+    {
+      traversed += node->links[i].width;
+      node = node->links[i].next;
+    }
+    update[i] = node;
+    rank[i] = traversed;
+  }
+}
+
+static DfSkipList_Node *dfskiplist_locate(DfSkipList *list, size_t index)
+{
+  DfSkipList_Node *node = list->head;
+  size_t position = index + 1;
+  size_t traversed = 0;
+
+  for (size_t i = list->level; i-- > 0;)
+  {
+    while (node->links[i].next && traversed + node->links[i].width <= position)
+    {
+      traversed += node->links[i].width;
+      node = node->links[i].next;
+    }
+    if (traversed == position)
+    {
+      break;
+    }
+  }
+
+  return node;
+}
+
+DfResult dfskiplist_create()
+{
+  DfResult res = df_result_init();
+
+  DfSkipList *list = malloc(sizeof(DfSkipList));
+  if (!list)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  list->head = dfskiplist_new_node(NULL, DFSKIPLIST_MAX_LEVEL);
+  if (!list->head)
+  {
+    free(list);
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  for (size_t i = 0; i < DFSKIPLIST_MAX_LEVEL; i++)
+  {
+    list->head->links[i].next = NULL;
+    list->head->links[i].width = 1;
+  }
+
+  list->tail = NULL;
+  list->length = 0;
+  list->level = 1;
+  list->rng = 0x9E3779B97F4A7C15ull;
+  list->prefetch_distance = 0;
+  list->prefetch_elements = false;
+
+  res.value = list;
+  return res;
+}
+
+// Moves the prefetch runner one node on along the bottom level; see dflist_s_prefetch_step
+static DfSkipList_Node *dfskiplist_prefetch_step(DfSkipList *list, DfSkipList_Node *ahead)
+{
+  if (!ahead)
+  {
+    return NULL;
+  }
+
+  if (list->prefetch_elements)
+  {
+    DF_PREFETCH(ahead->element);
+  }
+
+  ahead = ahead->links[0].next;
+  if (ahead)
+  {
+    DF_PREFETCH(ahead);
+  }
+  return ahead;
+}
+
+// Places a runner prefetch_distance nodes past from, or returns NULL when prefetching is off
+static DfSkipList_Node *dfskiplist_prefetch_start(DfSkipList *list, DfSkipList_Node *from)
+{
+  if (list->prefetch_distance == 0)
+  {
+    return NULL;
+  }
+
+  DfSkipList_Node *ahead = from;
+  for (size_t i = 0; i < list->prefetch_distance && ahead; i++)
+  {
+    ahead = dfskiplist_prefetch_step(list, ahead);
+  }
+  return ahead;
+}
+
+DfResult dfskiplist_set_prefetch(DfSkipList *list, size_t distance, bool elements)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  list->prefetch_distance = distance;
+  list->prefetch_elements = distance > 0 && elements;
+
+  return res;
+}
+
+static void dfskiplist_release_nodes(DfSkipList *list, void (*cleanup)(void *element))
+{
+  DfSkipList_Node *current = list->head->links[0].next;
+  DfSkipList_Node *ahead = dfskiplist_prefetch_start(list, current);
+  while (current)
+  {
+    DfSkipList_Node *next = current->links[0].next;
+    if (cleanup)
+    {
+      cleanup(current->element);
+    }
+    free(current);
+    current = next;
+    ahead = dfskiplist_prefetch_step(list, ahead);
+  }
+
+  for (size_t i = 0; i < list->level; i++)
+  {
+    list->head->links[i].next = NULL;
+    list->head->links[i].width = 1;
+  }
+
+  list->tail = NULL;
+  list->length = 0;
+  list->level = 1;
+}
+
+DfResult dfskiplist_destroy(DfSkipList *list, void (*cleanup)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  dfskiplist_release_nodes(list, cleanup);
+  free(list->head);
+  free(list);
+
+  return res;
+}
+
+DfResult dfskiplist_insert_at(DfSkipList *list, void *element, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_insert(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t level = dfskiplist_random_level(list);
+  DfSkipList_Node *node = dfskiplist_new_node(element, level);
+  if (!node)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  DfSkipList_Node *update[DFSKIPLIST_MAX_LEVEL];
+  size_t rank[DFSKIPLIST_MAX_LEVEL];
+  size_t position = index + 1;
+
+  dfskiplist_find_before(list, position, update, rank);
+
+  // Newly used head levels span the whole list
+  for (size_t i = list->level; i < level; i++)
+  {
+    list->head->links[i].next = NULL;
+    list->head->links[i].width = list->length + 1;
+    update[i] = list->head;
+    rank[i] = 0;
+  }
+  if (level > list->level)
+  {
+    list->level = level;
+  }
+
+  for (size_t i = 0; i < level; i++)
+  {
+    DfSkipList_Link *link = &update[i]->links[i];
+    node->links[i].next = link->next;
+    node->links[i].width = rank[i] + link->width + 1 - position;
+    link->next = node;
+    link->width = position - rank[i];
+  }
+
+  for (size_t i = level; i < list->level; i++)
+  {
+    update[i]->links[i].width++;
+  }
+
+  if (!node->links[0].next)
+  {
+    list->tail = node;
+  }
+  list->length++;
+
+  return res;
+}
+
+DfResult dfskiplist_remove_at(DfSkipList *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfSkipList_Node *update[DFSKIPLIST_MAX_LEVEL];
+  size_t rank[DFSKIPLIST_MAX_LEVEL];
+
+  dfskiplist_find_before(list, index + 1, update, rank);
+
+  DfSkipList_Node *node = update[0]->links[0].next;
+
+  for (size_t i = 0; i < list->level; i++)
+  {
+    DfSkipList_Link *link = &update[i]->links[i];
+    if (link->next == node)
+    {
+      link->width += node->links[i].width - 1;
+      link->next = node->links[i].next;
+    }
+    else
+    {
+      link->width--;
+    }
+  }
+
+  while (list->level > 1 && !list->head->links[list->level - 1].next)
+  {
+    list->level--;
+  }
+
+  if (node == list->tail)
+  {
+    list->tail = update[0] == list->head ? NULL : update[0];
+  }
+  list->length--;
+
+  res.value = node->element;
+  free(node);
+  return res;
+}
+
+DfResult dfskiplist_push_back(DfSkipList *list, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dfskiplist_insert_at(list, element, list->length);
+}
+
+DfResult dfskiplist_push_front(DfSkipList *list, void *element)
+{
+  return dfskiplist_insert_at(list, element, 0);
+}
+
+DfResult dfskiplist_pop_front(DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  return dfskiplist_remove_at(list, 0);
+}
+
+DfResult dfskiplist_pop_back(DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  return dfskiplist_remove_at(list, list->length - 1);
+}
+
+DfResult dfskiplist_get(DfSkipList *list, size_t index)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  df_index_check_access(index, list->length, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = dfskiplist_locate(list, index)->element;
+  return res;
+}
+
+DfResult dfskiplist_peek_front(DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->head->links[0].next->element;
+  return res;
+}
+
+DfResult dfskiplist_peek_back(DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_EMPTY;
+    return res;
+  }
+
+  res.value = list->tail->element;
+  return res;
+}
+
+DfResult dfskiplist_length(DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)list->length;
+  return res;
+}
+
+// Iterator
+
+typedef struct DfSkipList_Iterator
+{
+  DfSkipList *list;
+  DfSkipList_Node *cur;
+  DfSkipList_Node *ahead; // Prefetch runner, NULL when the list does not prefetch
+  void *batch[DF_ITERATOR_BATCH];
+} DfSkipList_Iterator;
+
+_Static_assert(sizeof(DfSkipList_Iterator) <= DF_ITERATOR_STATE_SIZE, "DfSkipList_Iterator must fit in the embedded iterator state");
+
+int dfskiplist_iterator_has_next(Iterator *it)
+{
+  DfSkipList_Iterator *list_it = (DfSkipList_Iterator *)it->current;
+  return list_it->cur != NULL;
+}
+
+DfResult dfskiplist_iterator_next(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfSkipList_Iterator *list_it = (DfSkipList_Iterator *)it->current;
+
+  if (!list_it->cur)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  // Sequential iteration only follows the bottom level
+  res.value = list_it->cur->element;
+  list_it->cur = list_it->cur->links[0].next;
+  list_it->ahead = dfskiplist_prefetch_step(list_it->list, list_it->ahead);
+  return res;
+}
+
+DfResult dfskiplist_iterator_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->current, &res);
+  df_null_ptr_check(span, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfSkipList_Iterator *list_it = (DfSkipList_Iterator *)it->current;
+
+  size_t count = 0;
+  max = max < DF_ITERATOR_BATCH ? max : DF_ITERATOR_BATCH;
+  while (count < max && list_it->cur)
+  {
+    list_it->batch[count++] = list_it->cur->element;
+    list_it->cur = list_it->cur->links[0].next;
+    list_it->ahead = dfskiplist_prefetch_step(list_it->list, list_it->ahead);
+  }
+
+  span->items = list_it->batch;
+  span->count = count;
+  span->stride = 0;
+  return res;
+}
+
+DfResult dfskiplist_create_new(Iterator *it)
+{
+  (void)it;
+  return dfskiplist_create();
+}
+
+DfResult dfskiplist_insert_new(void *new_ds, void *element)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(new_ds, &res);
+  df_null_ptr_check(element, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  return dfskiplist_push_back((DfSkipList *)new_ds, element);
+}
+
+DfResult dfskiplist_free_all(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(it->structure, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfSkipList *list = (DfSkipList *)it->structure;
+
+  if (list->length == 0)
+  {
+    res.error = DF_ERR_ALREADY_FREED;
+    return res;
+  }
+
+  dfskiplist_release_nodes(list, NULL);
+  return res;
+}
+
+DfResult dfskiplist_iterator_init(Iterator *it, DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfSkipList_Iterator *list_it = (DfSkipList_Iterator *)iterator_prepare(it, list);
+  list_it->list = list;
+  list_it->cur = list->head->links[0].next;
+  list_it->ahead = dfskiplist_prefetch_start(list, list_it->cur);
+
+  it->next = dfskiplist_iterator_next;
+  it->has_next = dfskiplist_iterator_has_next;
+  it->create_new = dfskiplist_create_new;
+  it->insert_new = dfskiplist_insert_new;
+  it->elem_size = NULL; // Elements are caller-owned pointers of unknown size
+  it->free_all = dfskiplist_free_all;
+  it->next_batch = dfskiplist_iterator_next_batch;
+
+  res.value = it;
+  return res;
+}
+
+DfResult dfskiplist_iterator_create(DfSkipList *list)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(list, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    return it_res;
+  }
+
+  res = dfskiplist_iterator_init((Iterator *)it_res.value, list);
+  if (res.error)
+  {
+    free(it_res.value);
+  }
+  return res;
+}
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include "../includes/df_slab.h"
+#include "../includes/df_common.h"
+#include "../internal/df_internal.h"
+
+typedef struct DfSlab_Chunk
+{
+  struct DfSlab_Chunk *next;
+  max_align_t objects[];
+} DfSlab_Chunk;
+
+typedef struct DfSlab
+{
+  DfSlab_Chunk *chunks;
+  void *free_list;  // Returned objects, linked through their first word
+  char *bump;       // Next never-used object in the newest chunk
+  size_t bump_left; // Never-used objects left in the newest chunk
+  size_t object_size;
+  size_t objects_per_chunk;
+  DfSlab_Stats stats;
+} DfSlab;
+
+// Objects are padded so each one is suitably aligned and can hold a free list link
+static size_t dfslab_round_size(size_t object_size)
+{
+  size_t align = _Alignof(max_align_t);
+  if (object_size < sizeof(void *))
+  {
+    object_size = sizeof(void *);
+  }
+  return (object_size + align - 1) & ~(align - 1);
+}
+
+static void dfslab_release_chunks(DfSlab *slab)
+{
+  DfSlab_Chunk *chunk = slab->chunks;
+  while (chunk)
+  {
+    DfSlab_Chunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  slab->chunks = NULL;
+  slab->free_list = NULL;
+  slab->bump = NULL;
+  slab->bump_left = 0;
+}
+
+DfResult dfslab_create(size_t object_size, size_t objects_per_chunk)
+{
+  DfResult res = df_result_init();
+
+  if (object_size == 0)
+  {
+    res.error = DF_ERR_OUT_OF_RANGE;
+    return res;
+  }
+
+  DfSlab *slab = malloc(sizeof(DfSlab));
+  if (!slab)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  slab->chunks = NULL;
+  slab->free_list = NULL;
+  slab->bump = NULL;
+  slab->bump_left = 0;
+  slab->object_size = dfslab_round_size(object_size);
+  slab->objects_per_chunk = objects_per_chunk ? objects_per_chunk : DFSLAB_DEFAULT_OBJECTS_PER_CHUNK;
+  slab->stats = (DfSlab_Stats){0};
+
+  res.value = slab;
+  return res;
+}
+
+DfResult dfslab_destroy(DfSlab *slab)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(slab, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  dfslab_release_chunks(slab);
+  free(slab);
+
+  return res;
+}
+
+DfResult dfslab_alloc(DfSlab *slab)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(slab, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  void *object;
+
+  if (slab->free_list)
+  {
+    object = slab->free_list;
+    slab->free_list = *(void **)object;
+  }
+  else
+  {
+    if (slab->bump_left == 0)
+    {
+      DfSlab_Chunk *chunk = malloc(offsetof(DfSlab_Chunk, objects) + slab->objects_per_chunk * slab->object_size);
+      if (!chunk)
+      {
+        res.error = DF_ERR_ALLOC_FAILED;
+        return res;
+      }
+
+      chunk->next = slab->chunks;
+      slab->chunks = chunk;
+      slab->bump = (char *)chunk->objects;
+      slab->bump_left = slab->objects_per_chunk;
+      slab->stats.chunks++;
+      slab->stats.capacity += slab->objects_per_chunk;
+    }
+
+    object = slab->bump;
+    slab->bump += slab->object_size;
+    slab->bump_left--;
+  }
+
+  slab->stats.allocs++;
+  slab->stats.live++;
+
+  res.value = object;
+  return res;
+}
+
+DfResult dfslab_free(DfSlab *slab, void *object)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(slab, &res);
+  df_null_ptr_check(object, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  *(void **)object = slab->free_list;
+  slab->free_list = object;
+  slab->stats.frees++;
+  slab->stats.live--;
+
+  return res;
+}
+
+DfResult dfslab_reset(DfSlab *slab)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(slab, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  // Every outstanding object is released along with its chunk
+  slab->stats.frees += slab->stats.live;
+  slab->stats.live = 0;
+  slab->stats.capacity = 0;
+  dfslab_release_chunks(slab);
+
+  return res;
+}
+
+DfResult dfslab_object_size(DfSlab *slab)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(slab, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  res.value = (void *)slab->object_size;
+  return res;
+}
+
+DfResult dfslab_stats(DfSlab *slab, DfSlab_Stats *stats)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(slab, &res);
+  df_null_ptr_check(stats, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  *stats = slab->stats;
+  stats->fragmentation = stats->capacity ? 1.0 - (double)stats->live / (double)stats->capacity : 0.0;
+
+  res.value = stats;
+  return res;
+}
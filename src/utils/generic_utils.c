@@ -6,24 +6,37 @@
 #include <stdbool.h>
 #include <string.h>
 
-DfResult df_map(Iterator *it, void *(*func)(void *element))
+// Feeds every remaining element to visit until it returns false, over next_batch spans when
+// the iterator has them; *stopped_at receives the element visit stopped on, if any
+static DfResult df_visit(Iterator *it, bool (*visit)(void *ctx, void *element), void *ctx, void **stopped_at)
 {
   DfResult res = df_result_init();
 
-  df_null_ptr_check(it, &res);
-  if (res.error)
+  if (it->next_batch)
   {
-    return res;
-  }
+    DfSpan span;
+    do
+    {
+      res = it->next_batch(it, &span, DF_ITERATOR_BATCH);
+      if (res.error)
+      {
+        return res;
+      }
+
+      for (size_t i = 0; i < span.count; i++)
+      {
+        void *element = df_span_at(&span, i);
+        if (!visit(ctx, element))
+        {
+          *stopped_at = element;
+          return res;
+        }
+      }
+    } while (span.count > 0);
 
-  DfResult new_ds_res = it->create_new(it);
-  if (new_ds_res.error)
-  {
-    return new_ds_res;
+    return res;
   }
 
-  void *new_ds = new_ds_res.value;
-
   while (it->has_next(it))
   {
     DfResult element_res = it->next(it);
@@ -32,50 +45,104 @@ DfResult df_map(Iterator *it, void *(*func)(void *element))
       return element_res;
     }
 
-    void *element = element_res.value;
+    if (!visit(ctx, element_res.value))
+    {
+      *stopped_at = element_res.value;
+      return res;
+    }
+  }
+
+  return res;
+}
+
+typedef struct DfInsert_Context
+{
+  Iterator *it;
+  void *new_ds;
+  void *(*map)(void *element);
+  bool (*filter)(void *element);
+  DfResult error;
+} DfInsert_Context;
+
+static bool df_visit_insert(void *ctx, void *element)
+{
+  DfInsert_Context *insert = (DfInsert_Context *)ctx;
 
-    void *modified_element = func(element);
+  if (insert->filter && !insert->filter(element))
+  {
+    return true;
+  }
 
-    it->insert_new(new_ds, modified_element);
+  if (insert->map)
+  {
+    element = insert->map(element);
   }
 
-  res.value = new_ds;
-  return res;
+  insert->error = insert->it->insert_new(insert->new_ds, element);
+  return !insert->error.error;
 }
 
-DfResult df_filter(Iterator *it, bool (*func)(void *element))
+// Shared by df_map and df_filter: builds a new structure from the elements that pass
+static DfResult df_build(Iterator *it, void *(*map)(void *element), bool (*filter)(void *element))
+{
+  DfResult new_ds_res = it->create_new(it);
+  if (new_ds_res.error)
+  {
+    return new_ds_res;
+  }
+
+  DfInsert_Context insert = {it, new_ds_res.value, map, filter, df_result_init()};
+  void *stopped_at = NULL;
+
+  DfResult visit_res = df_visit(it, df_visit_insert, &insert, &stopped_at);
+  if (visit_res.error)
+  {
+    return visit_res;
+  }
+  if (insert.error.error)
+  {
+    return insert.error;
+  }
+
+  return new_ds_res;
+}
+
+DfResult df_map(Iterator *it, void *(*func)(void *element))
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(it, &res);
+  df_null_ptr_check(func, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfResult filtered_ds_res = it->create_new(it);
-  if (filtered_ds_res.error)
-  {
-    return filtered_ds_res;
-  }
+  return df_build(it, func, NULL);
+}
 
-  void *filtered_ds = filtered_ds_res.value;
+DfResult df_filter(Iterator *it, bool (*func)(void *element))
+{
+  DfResult res = df_result_init();
 
-  while (it->has_next(it))
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(func, &res);
+  if (res.error)
   {
-    DfResult element_res = it->next(it);
-    if (element_res.error)
-    {
-      return element_res;
-    }
-    void *element = element_res.value;
-
-    if (func(element))
-      it->insert_new(filtered_ds, element);
+    return res;
   }
 
-  res.value = filtered_ds;
-  return res;
+  return df_build(it, NULL, func);
+}
+
+typedef struct DfFind_Context
+{
+  bool (*func)(void *element);
+} DfFind_Context;
+
+static bool df_visit_find(void *ctx, void *element)
+{
+  return !((DfFind_Context *)ctx)->func(element);
 }
 
 DfResult df_find(Iterator *it, bool (*func)(void *element))
@@ -83,135 +150,195 @@ DfResult df_find(Iterator *it, bool (*func)(void *element))
   DfResult res = df_result_init();
 
   df_null_ptr_check(it, &res);
+  df_null_ptr_check(func, &res);
   if (res.error)
   {
     return res;
   }
 
-  DfResult element_res;
-  while (it->has_next(it))
+  DfFind_Context find = {func};
+  void *found = NULL;
+  res = df_visit(it, df_visit_find, &find, &found);
+  if (res.error)
   {
-    element_res = it->next(it);
-    if (element_res.error)
-    {
-      return element_res;
-    }
+    return res;
+  }
 
-    if (func(element_res.value))
-    {
-      return element_res;
-    }
+  if (!found)
+  {
+    res.error = DF_ERR_ELEMENT_NOT_FOUND;
+    return res;
   }
 
-  res.error = DF_ERR_ELEMENT_NOT_FOUND;
+  res.value = found;
   return res;
 }
 
+typedef struct DfFor_Each_Context
+{
+  void (*func)(void *element);
+  void *copy;
+  size_t size;
+} DfFor_Each_Context;
+
+// func gets a scratch copy so it cannot modify the structure
+static bool df_visit_for_each(void *ctx, void *element)
+{
+  DfFor_Each_Context *for_each = (DfFor_Each_Context *)ctx;
+
+  memcpy(for_each->copy, element, for_each->size);
+  for_each->func(for_each->copy);
+  return true;
+}
+
 DfResult df_for_each(Iterator *it, void (*func)(void *element))
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(it, &res);
+  df_null_ptr_check(func, &res);
   if (res.error)
   {
     return res;
   }
 
+  // Structures holding caller pointers have no element size to copy by
+  if (!it->elem_size)
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
   size_t size = it->elem_size(it);
   void *copy = malloc(size);
   if (!copy)
   {
     res.error = DF_ERR_ALLOC_FAILED;
+    return res;
   }
 
-  while (it->has_next(it))
-  {
-    DfResult element_res = it->next(it);
-    if (element_res.error)
-    {
-      return element_res;
-    }
-    void *element = element_res.value;
-    memcpy(copy, element, size);
-    func(copy);
-  }
+  DfFor_Each_Context for_each = {func, copy, size};
+  void *stopped_at = NULL;
+  res = df_visit(it, df_visit_for_each, &for_each, &stopped_at);
 
   free(copy);
 
   return res;
 }
 
+typedef struct DfCount_Context
+{
+  bool (*func)(void *element);
+  size_t count;
+} DfCount_Context;
+
+static bool df_visit_count(void *ctx, void *element)
+{
+  DfCount_Context *count = (DfCount_Context *)ctx;
+
+  if (count->func(element))
+    count->count++;
+  return true;
+}
+
 DfResult df_count(Iterator *it, bool (*func)(void *element))
 {
   DfResult res = df_result_init();
   res.value = 0;
 
   df_null_ptr_check(it, &res);
+  df_null_ptr_check(func, &res);
   if (res.error)
   {
     return res;
   }
 
-  while (it->has_next(it))
+  DfCount_Context count = {func, 0};
+  void *stopped_at = NULL;
+  res = df_visit(it, df_visit_count, &count, &stopped_at);
+  if (res.error)
   {
-    DfResult element_res = it->next(it);
-    if (element_res.error)
-    {
-      return element_res;
-    }
-    void *element = element_res.value;
-
-    if (func(element))
-      (size_t *)res.value++;
+    return res;
   }
 
+  res.value = (void *)count.count;
   return res;
 }
 
+typedef struct DfReduce_Context
+{
+  void (*func)(void *accumulator, void *element);
+  void *accumulator;
+} DfReduce_Context;
+
+static bool df_visit_reduce(void *ctx, void *element)
+{
+  DfReduce_Context *reduce = (DfReduce_Context *)ctx;
+
+  reduce->func(reduce->accumulator, element);
+  return true;
+}
+
 DfResult df_reduce(Iterator *it, void *initial, void (*func)(void *accumulator, void *element))
 {
   DfResult res = df_result_init();
 
   df_null_ptr_check(it, &res);
   df_null_ptr_check(initial, &res);
+  df_null_ptr_check(func, &res);
   if (res.error)
   {
     return res;
   }
 
-  size_t size = it->elem_size(it);
-  res.value = malloc(size);
-  if (!res.value)
+  if (!it->elem_size)
   {
-    res.value = NULL;
-    res.error = DF_ERR_ALLOC_FAILED;
+    res.error = DF_ERR_INCOMPATIBLE;
     return res;
   }
 
-  memcpy(res.value, initial, size);
-  if (!initial)
+  size_t size = it->elem_size(it);
+  void *accumulator = malloc(size);
+  if (!accumulator)
   {
-    free(res.value);
     res.error = DF_ERR_ALLOC_FAILED;
     return res;
   }
 
-  while (it->has_next(it))
+  memcpy(accumulator, initial, size);
+
+  DfReduce_Context reduce = {func, accumulator};
+  void *stopped_at = NULL;
+  res = df_visit(it, df_visit_reduce, &reduce, &stopped_at);
+  if (res.error)
   {
-    DfResult element_res = it->next(it);
-    if (element_res.error)
-    {
-      free(res.value);
-      free(initial);
-      return element_res;
-    }
-    void *element = element_res.value;
-    func(res.value, element);
+    free(accumulator);
+    return res;
   }
 
+  res.value = accumulator;
   return res;
 }
 
+DfResult df_collect(Iterator *it)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!it->create_new || !it->insert_new)
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
+  return df_build(it, NULL, NULL);
+}
+
 DfResult df_free_all(Iterator *it)
 {
   DfResult res = df_result_init();
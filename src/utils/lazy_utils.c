@@ -0,0 +1,566 @@
+#include "../../includes/df_iterator.h"
+#include "../../includes/df_utils.h"
+#include "../../includes/df_common.h"
+#include "../../internal/df_internal.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+// Every adaptor state starts with its sources, so the shared callbacks can reach them
+typedef struct DfLazy_Sources
+{
+  Iterator *source;
+  Iterator *second; // chain and zip only
+} DfLazy_Sources;
+
+typedef struct DfLazy_Map
+{
+  DfLazy_Sources sources;
+  void *(*func)(void *element);
+  size_t value_size; // Results are copied into values when the element size is known
+  void *batch[DF_ITERATOR_BATCH];
+  max_align_t values[];
+} DfLazy_Map;
+
+typedef struct DfLazy_Filter
+{
+  DfLazy_Sources sources;
+  bool (*func)(void *element);
+  DfResult pending; // Next matching element (or source error), valid while ready is set
+  bool ready;
+  void *batch[DF_ITERATOR_BATCH];
+} DfLazy_Filter;
+
+typedef struct DfLazy_Count
+{
+  DfLazy_Sources sources;
+  size_t count; // Elements still to take, or still to skip
+} DfLazy_Count;
+
+typedef struct DfLazy_Zip
+{
+  DfLazy_Sources sources;
+  void *(*combine)(void *left, void *right);
+} DfLazy_Zip;
+
+// Shared callbacks: new structures, element sizes and cleanup all come from the first source
+
+static DfResult df_lazy_create_new(Iterator *it)
+{
+  Iterator *source = ((DfLazy_Sources *)it->current)->source;
+  return source->create_new(source);
+}
+
+static size_t df_lazy_elem_size(Iterator *it)
+{
+  Iterator *source = ((DfLazy_Sources *)it->current)->source;
+  return source->elem_size(source);
+}
+
+static DfResult df_lazy_free_all(Iterator *it)
+{
+  DfLazy_Sources *sources = (DfLazy_Sources *)it->current;
+
+  DfResult res = sources->source->free_all(sources->source);
+  if (!res.error && sources->second)
+  {
+    res = sources->second->free_all(sources->second);
+  }
+  return res;
+}
+
+// Takes one element, through next_batch when the source has it so sources that copy on next()
+// (DfArray) hand out their storage instead, and without reading ahead
+static DfResult df_lazy_pull(Iterator *source)
+{
+  if (!source->next_batch)
+  {
+    return source->next(source);
+  }
+
+  DfSpan span;
+  DfResult res = source->next_batch(source, &span, 1);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (span.count == 0)
+  {
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  res.value = df_span_at(&span, 0);
+  return res;
+}
+
+static void df_lazy_span_empty(DfSpan *span)
+{
+  span->items = NULL;
+  span->count = 0;
+  span->stride = 0;
+}
+
+// Wraps state in a new Iterator; takes ownership of state, which iterator_destroy frees
+static DfResult df_lazy_create(void *state, DfResult (*next)(Iterator *), int (*has_next)(Iterator *))
+{
+  Iterator *source = ((DfLazy_Sources *)state)->source;
+
+  DfResult it_res = iterator_create();
+  if (it_res.error)
+  {
+    free(state);
+    return it_res;
+  }
+
+  Iterator *it = (Iterator *)it_res.value;
+
+  it->structure = source->structure;
+  it->current = state;
+  it->next = next;
+  it->has_next = has_next;
+  it->create_new = source->create_new ? df_lazy_create_new : NULL;
+  it->insert_new = source->insert_new;
+  it->elem_size = source->elem_size ? df_lazy_elem_size : NULL;
+  it->free_all = source->free_all ? df_lazy_free_all : NULL;
+
+  return it_res;
+}
+
+static void *df_lazy_state(size_t size, Iterator *source, Iterator *second, DfResult *res)
+{
+  df_null_ptr_check(source, res);
+  if (res->error)
+  {
+    return NULL;
+  }
+
+  DfLazy_Sources *sources = malloc(size);
+  if (!sources)
+  {
+    res->error = DF_ERR_ALLOC_FAILED;
+    return NULL;
+  }
+
+  sources->source = source;
+  sources->second = second;
+  return sources;
+}
+
+// Map
+
+static int df_lazy_map_has_next(Iterator *it)
+{
+  Iterator *source = ((DfLazy_Map *)it->current)->sources.source;
+  return source->has_next(source);
+}
+
+static DfResult df_lazy_map_next(Iterator *it)
+{
+  DfLazy_Map *map = (DfLazy_Map *)it->current;
+
+  DfResult res = df_lazy_pull(map->sources.source);
+  if (!res.error)
+  {
+    res.value = map->func(res.value);
+  }
+  return res;
+}
+
+// Every result of a batch is live at once, so results are copied out as func returns them
+// when their size is known; otherwise func must not return shared scratch storage
+static DfResult df_lazy_map_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfLazy_Map *map = (DfLazy_Map *)it->current;
+  Iterator *source = map->sources.source;
+
+  DfSpan source_span;
+  DfResult res = source->next_batch(source, &source_span, max < DF_ITERATOR_BATCH ? max : DF_ITERATOR_BATCH);
+  if (res.error)
+  {
+    return res;
+  }
+
+  span->count = source_span.count;
+
+  if (map->value_size)
+  {
+    char *values = (char *)map->values;
+    for (size_t i = 0; i < source_span.count; i++)
+    {
+      memcpy(values + i * map->value_size, map->func(df_span_at(&source_span, i)), map->value_size);
+    }
+
+    span->items = values;
+    span->stride = map->value_size;
+    return res;
+  }
+
+  for (size_t i = 0; i < source_span.count; i++)
+  {
+    map->batch[i] = map->func(df_span_at(&source_span, i));
+  }
+
+  span->items = map->batch;
+  span->stride = 0;
+  return res;
+}
+
+DfResult df_lazy_map(Iterator *source, void *(*func)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(source, &res);
+  df_null_ptr_check(func, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  size_t value_size = source->next_batch && source->elem_size ? source->elem_size(source) : 0;
+  DfLazy_Map *map = df_lazy_state(sizeof(DfLazy_Map) + DF_ITERATOR_BATCH * value_size, source, NULL, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  map->func = func;
+  map->value_size = value_size;
+  res = df_lazy_create(map, df_lazy_map_next, df_lazy_map_has_next);
+  if (!res.error && source->next_batch)
+  {
+    ((Iterator *)res.value)->next_batch = df_lazy_map_next_batch;
+  }
+  return res;
+}
+
+// Filter
+
+// Pulls from the source until an element matches; a source error is held like a match so next reports it
+static int df_lazy_filter_has_next(Iterator *it)
+{
+  DfLazy_Filter *filter = (DfLazy_Filter *)it->current;
+  Iterator *source = filter->sources.source;
+
+  while (!filter->ready && source->has_next(source))
+  {
+    DfResult element_res = df_lazy_pull(source);
+    if (element_res.error || filter->func(element_res.value))
+    {
+      filter->pending = element_res;
+      filter->ready = true;
+    }
+  }
+
+  return filter->ready;
+}
+
+static DfResult df_lazy_filter_next(Iterator *it)
+{
+  DfLazy_Filter *filter = (DfLazy_Filter *)it->current;
+
+  if (!df_lazy_filter_has_next(it))
+  {
+    DfResult res = df_result_init();
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  filter->ready = false;
+  return filter->pending;
+}
+
+// Gathers the matches of whole source batches, pulling until at least one matches
+static DfResult df_lazy_filter_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfLazy_Filter *filter = (DfLazy_Filter *)it->current;
+  Iterator *source = filter->sources.source;
+  DfResult res = df_result_init();
+
+  df_lazy_span_empty(span);
+  span->items = filter->batch;
+  if (max == 0)
+  {
+    return res;
+  }
+
+  // A match found by has_next goes out first, on its own
+  if (filter->ready)
+  {
+    filter->ready = false;
+    if (filter->pending.error)
+    {
+      return filter->pending;
+    }
+    filter->batch[0] = filter->pending.value;
+    span->count = 1;
+    return res;
+  }
+
+  max = max < DF_ITERATOR_BATCH ? max : DF_ITERATOR_BATCH;
+  DfSpan source_span;
+  do
+  {
+    res = source->next_batch(source, &source_span, max);
+    if (res.error)
+    {
+      return res;
+    }
+
+    for (size_t i = 0; i < source_span.count; i++)
+    {
+      void *element = df_span_at(&source_span, i);
+      if (filter->func(element))
+      {
+        filter->batch[span->count++] = element;
+      }
+    }
+  } while (span->count == 0 && source_span.count > 0);
+
+  return res;
+}
+
+DfResult df_lazy_filter(Iterator *source, bool (*func)(void *element))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(func, &res);
+  DfLazy_Filter *filter = df_lazy_state(sizeof(DfLazy_Filter), source, NULL, &res);
+  if (res.error)
+  {
+    free(filter);
+    return res;
+  }
+
+  filter->func = func;
+  filter->ready = false;
+  res = df_lazy_create(filter, df_lazy_filter_next, df_lazy_filter_has_next);
+  if (!res.error && source->next_batch)
+  {
+    ((Iterator *)res.value)->next_batch = df_lazy_filter_next_batch;
+  }
+  return res;
+}
+
+// Take
+
+static int df_lazy_take_has_next(Iterator *it)
+{
+  DfLazy_Count *take = (DfLazy_Count *)it->current;
+  return take->count > 0 && take->sources.source->has_next(take->sources.source);
+}
+
+static DfResult df_lazy_take_next(Iterator *it)
+{
+  DfLazy_Count *take = (DfLazy_Count *)it->current;
+
+  if (take->count == 0)
+  {
+    DfResult res = df_result_init();
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  take->count--;
+  return df_lazy_pull(take->sources.source);
+}
+
+static DfResult df_lazy_take_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfLazy_Count *take = (DfLazy_Count *)it->current;
+  Iterator *source = take->sources.source;
+
+  DfResult res = source->next_batch(source, span, max < take->count ? max : take->count);
+  if (!res.error)
+  {
+    take->count -= span->count;
+  }
+  return res;
+}
+
+DfResult df_lazy_take(Iterator *source, size_t count)
+{
+  DfResult res = df_result_init();
+
+  DfLazy_Count *take = df_lazy_state(sizeof(DfLazy_Count), source, NULL, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  take->count = count;
+  res = df_lazy_create(take, df_lazy_take_next, df_lazy_take_has_next);
+  if (!res.error && source->next_batch)
+  {
+    ((Iterator *)res.value)->next_batch = df_lazy_take_next_batch;
+  }
+  return res;
+}
+
+// Skip
+
+// The skipped prefix is only consumed once the adaptor is first pulled
+static int df_lazy_skip_has_next(Iterator *it)
+{
+  DfLazy_Count *skip = (DfLazy_Count *)it->current;
+  Iterator *source = skip->sources.source;
+
+  while (skip->count > 0 && source->has_next(source))
+  {
+    df_lazy_pull(source);
+    skip->count--;
+  }
+
+  return source->has_next(source);
+}
+
+static DfResult df_lazy_skip_next(Iterator *it)
+{
+  DfLazy_Count *skip = (DfLazy_Count *)it->current;
+
+  df_lazy_skip_has_next(it);
+  return df_lazy_pull(skip->sources.source);
+}
+
+static DfResult df_lazy_skip_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfLazy_Count *skip = (DfLazy_Count *)it->current;
+  Iterator *source = skip->sources.source;
+
+  while (skip->count > 0)
+  {
+    DfResult skip_res = source->next_batch(source, span, skip->count);
+    if (skip_res.error || span->count == 0)
+    {
+      return skip_res;
+    }
+    skip->count -= span->count;
+  }
+
+  return source->next_batch(source, span, max);
+}
+
+DfResult df_lazy_skip(Iterator *source, size_t count)
+{
+  DfResult res = df_result_init();
+
+  DfLazy_Count *skip = df_lazy_state(sizeof(DfLazy_Count), source, NULL, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  skip->count = count;
+  res = df_lazy_create(skip, df_lazy_skip_next, df_lazy_skip_has_next);
+  if (!res.error && source->next_batch)
+  {
+    ((Iterator *)res.value)->next_batch = df_lazy_skip_next_batch;
+  }
+  return res;
+}
+
+// Chain
+
+static int df_lazy_chain_has_next(Iterator *it)
+{
+  DfLazy_Sources *sources = (DfLazy_Sources *)it->current;
+  return sources->source->has_next(sources->source) || sources->second->has_next(sources->second);
+}
+
+static DfResult df_lazy_chain_next(Iterator *it)
+{
+  DfLazy_Sources *sources = (DfLazy_Sources *)it->current;
+
+  if (sources->source->has_next(sources->source))
+  {
+    return df_lazy_pull(sources->source);
+  }
+  return df_lazy_pull(sources->second);
+}
+
+static DfResult df_lazy_chain_next_batch(Iterator *it, DfSpan *span, size_t max)
+{
+  DfLazy_Sources *sources = (DfLazy_Sources *)it->current;
+
+  DfResult res = sources->source->next_batch(sources->source, span, max);
+  if (res.error || span->count > 0)
+  {
+    return res;
+  }
+  return sources->second->next_batch(sources->second, span, max);
+}
+
+DfResult df_lazy_chain(Iterator *first, Iterator *second)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(second, &res);
+  DfLazy_Sources *chain = df_lazy_state(sizeof(DfLazy_Sources), first, second, &res);
+  if (res.error)
+  {
+    free(chain);
+    return res;
+  }
+
+  res = df_lazy_create(chain, df_lazy_chain_next, df_lazy_chain_has_next);
+  if (!res.error && first->next_batch && second->next_batch)
+  {
+    ((Iterator *)res.value)->next_batch = df_lazy_chain_next_batch;
+  }
+  return res;
+}
+
+// Zip
+
+static int df_lazy_zip_has_next(Iterator *it)
+{
+  DfLazy_Sources *sources = (DfLazy_Sources *)it->current;
+  return sources->source->has_next(sources->source) && sources->second->has_next(sources->second);
+}
+
+// Stops at the shorter source
+static DfResult df_lazy_zip_next(Iterator *it)
+{
+  DfLazy_Zip *zip = (DfLazy_Zip *)it->current;
+
+  if (!df_lazy_zip_has_next(it))
+  {
+    DfResult res = df_result_init();
+    res.error = DF_ERR_END_OF_LIST;
+    return res;
+  }
+
+  DfResult left_res = df_lazy_pull(zip->sources.source);
+  if (left_res.error)
+  {
+    return left_res;
+  }
+
+  DfResult right_res = df_lazy_pull(zip->sources.second);
+  if (right_res.error)
+  {
+    return right_res;
+  }
+
+  left_res.value = zip->combine(left_res.value, right_res.value);
+  return left_res;
+}
+
+DfResult df_lazy_zip(Iterator *left, Iterator *right, void *(*combine)(void *left, void *right))
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(right, &res);
+  df_null_ptr_check(combine, &res);
+  DfLazy_Zip *zip = df_lazy_state(sizeof(DfLazy_Zip), left, right, &res);
+  if (res.error)
+  {
+    free(zip);
+    return res;
+  }
+
+  zip->combine = combine;
+  return df_lazy_create(zip, df_lazy_zip_next, df_lazy_zip_has_next);
+}
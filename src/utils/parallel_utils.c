@@ -0,0 +1,494 @@
+#include "../../includes/df_iterator.h"
+#include "../../includes/df_utils.h"
+#include "../../includes/df_array.h"
+#include "../../includes/df_pool.h"
+#include "../../includes/df_common.h"
+#include "../../internal/df_internal.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct DfParallel_Job DfParallel_Job;
+
+// Handles the elements of span, the first of which is element first of the source
+typedef void (*DfParallel_Visit)(DfParallel_Job *job, void *scratch, size_t chunk, size_t first, DfSpan *span);
+
+struct DfParallel_Job
+{
+  Iterator *it;
+  size_t length;
+  size_t grain;
+  size_t chunks;
+  atomic_size_t next_chunk;
+  DfParallel_Visit visit;
+  size_t scratch_size; // Per-thread scratch handed to visit, 0 for none
+  DfPool *pool;
+  atomic_bool scratch_failed; // A pool task could not allocate its scratch
+
+  // Operation arguments
+  void (*map)(void *element, void *out);
+  void (*for_each)(void *element);
+  void (*reduce)(void *accumulator, void *element);
+  DfArray *output;
+  char *out;
+  size_t out_stride;
+  char *partials;
+  size_t partial_size;
+  DfResult error; // Set by visits that can fail; only the sequential path has any
+};
+
+static size_t df_parallel_thread_count(const DfParallel_Options *options)
+{
+  if (options && options->pool)
+  {
+    DfPool_Stats stats;
+    dfpool_stats(options->pool, &stats);
+    return stats.workers;
+  }
+
+  if (options && options->threads)
+  {
+    return options->threads;
+  }
+
+  long online = sysconf(_SC_NPROCESSORS_ONLN);
+  return online > 0 ? (size_t)online : 1;
+}
+
+static size_t df_parallel_grain(const DfParallel_Options *options, size_t length, size_t threads)
+{
+  if (options && options->grain)
+  {
+    return options->grain;
+  }
+
+  // A few chunks per thread so threads that finish early can pick up the slack
+  size_t grain = length / (threads * 8);
+  return grain > DF_PARALLEL_MIN_GRAIN ? grain : DF_PARALLEL_MIN_GRAIN;
+}
+
+static void df_parallel_run_chunk(DfParallel_Job *job, void *scratch, size_t chunk)
+{
+  size_t start = chunk * job->grain;
+  size_t end = start + job->grain < job->length ? start + job->grain : job->length;
+
+  // Random-access spans can still break early, e.g. at a deque's wrap
+  while (start < end)
+  {
+    DfSpan span;
+    DfResult span_res = job->it->span_at(job->it, start, &span, end - start);
+    if (span_res.error || span.count == 0)
+    {
+      return;
+    }
+
+    job->visit(job, scratch, chunk, start, &span);
+    start += span.count;
+  }
+}
+
+static void *df_parallel_worker(void *arg)
+{
+  DfParallel_Job *job = (DfParallel_Job *)arg;
+
+  void *scratch = NULL;
+  if (job->scratch_size)
+  {
+    scratch = malloc(job->scratch_size);
+    if (!scratch)
+    {
+      // Leaves the chunks to threads that could allocate; the caller always can or has failed already
+      return NULL;
+    }
+  }
+
+  size_t chunk;
+  while ((chunk = atomic_fetch_add(&job->next_chunk, 1)) < job->chunks)
+  {
+    df_parallel_run_chunk(job, scratch, chunk);
+  }
+
+  free(scratch);
+  return NULL;
+}
+
+// Pool tasks cover chunk ranges rather than pulling from next_chunk, so the pool's stealing does the balancing
+static void df_parallel_pool_body(size_t begin, size_t end, void *arg)
+{
+  DfParallel_Job *job = (DfParallel_Job *)arg;
+
+  void *scratch = NULL;
+  if (job->scratch_size)
+  {
+    scratch = malloc(job->scratch_size);
+    if (!scratch)
+    {
+      atomic_store(&job->scratch_failed, true);
+      return;
+    }
+  }
+
+  for (size_t chunk = begin; chunk < end; chunk++)
+  {
+    df_parallel_run_chunk(job, scratch, chunk);
+  }
+
+  free(scratch);
+}
+
+// Walks a sequential source in order as a single chunk
+static DfResult df_parallel_run_sequential(DfParallel_Job *job, void *scratch)
+{
+  Iterator *it = job->it;
+  size_t first = 0;
+
+  if (it->next_batch)
+  {
+    DfSpan span;
+    do
+    {
+      DfResult batch_res = it->next_batch(it, &span, DF_ITERATOR_BATCH);
+      if (batch_res.error)
+      {
+        return batch_res;
+      }
+
+      job->visit(job, scratch, 0, first, &span);
+      first += span.count;
+    } while (span.count > 0);
+
+    return df_result_init();
+  }
+
+  while (it->has_next(it))
+  {
+    DfResult element_res = it->next(it);
+    if (element_res.error)
+    {
+      return element_res;
+    }
+
+    void *element = element_res.value;
+    DfSpan span = {&element, 1, 0};
+    job->visit(job, scratch, 0, first++, &span);
+  }
+
+  return df_result_init();
+}
+
+// Leaves the iterator exhausted, as the sequential versions do
+static DfResult df_parallel_exhaust(DfParallel_Job *job)
+{
+  DfResult res = df_result_init();
+
+  if (job->it->next_batch)
+  {
+    DfSpan span;
+    do
+    {
+      res = job->it->next_batch(job->it, &span, job->length);
+    } while (!res.error && span.count > 0);
+  }
+
+  return res;
+}
+
+// Runs the job's chunks on the job's pool, or on up to threads threads with the caller included, then exhausts the iterator
+static DfResult df_parallel_run(DfParallel_Job *job, size_t threads)
+{
+  DfResult res = df_result_init();
+
+  void *scratch = NULL;
+  if (job->scratch_size)
+  {
+    scratch = malloc(job->scratch_size);
+    if (!scratch)
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+      return res;
+    }
+  }
+
+  if (!job->it->span_at)
+  {
+    res = df_parallel_run_sequential(job, scratch);
+    free(scratch);
+    return res;
+  }
+
+  if (job->pool)
+  {
+    free(scratch);
+    res = dfpool_parallel_for(job->pool, 0, job->chunks, 1, df_parallel_pool_body, job);
+    if (!res.error && atomic_load(&job->scratch_failed))
+    {
+      res.error = DF_ERR_ALLOC_FAILED;
+    }
+    if (res.error)
+    {
+      return res;
+    }
+
+    return df_parallel_exhaust(job);
+  }
+
+  threads = threads < job->chunks ? threads : job->chunks;
+
+  pthread_t *helpers = NULL;
+  size_t started = 0;
+  if (threads > 1)
+  {
+    helpers = malloc((threads - 1) * sizeof(pthread_t));
+  }
+
+  // Threads that fail to start just leave more chunks to the others
+  for (size_t i = 0; helpers && i < threads - 1; i++)
+  {
+    if (pthread_create(&helpers[started], NULL, df_parallel_worker, job) == 0)
+    {
+      started++;
+    }
+  }
+
+  size_t chunk;
+  while ((chunk = atomic_fetch_add(&job->next_chunk, 1)) < job->chunks)
+  {
+    df_parallel_run_chunk(job, scratch, chunk);
+  }
+
+  for (size_t i = 0; i < started; i++)
+  {
+    pthread_join(helpers[i], NULL);
+  }
+  free(helpers);
+  free(scratch);
+
+  return df_parallel_exhaust(job);
+}
+
+static DfResult df_parallel_job_init(DfParallel_Job *job, Iterator *it, const DfParallel_Options *options, size_t *threads)
+{
+  DfResult res = df_result_init();
+
+  memset(job, 0, sizeof(*job));
+  job->it = it;
+  job->error = df_result_init();
+  atomic_init(&job->next_chunk, 0);
+  atomic_init(&job->scratch_failed, false);
+  job->pool = options ? options->pool : NULL;
+
+  *threads = df_parallel_thread_count(options);
+
+  if (!it->span_at)
+  {
+    job->chunks = 1;
+    return res;
+  }
+
+  job->length = it->remaining(it);
+  job->grain = df_parallel_grain(options, job->length, *threads);
+  job->chunks = (job->length + job->grain - 1) / job->grain;
+  return res;
+}
+
+// Map
+
+static void df_parallel_visit_map(DfParallel_Job *job, void *scratch, size_t chunk, size_t first, DfSpan *span)
+{
+  (void)scratch;
+  (void)chunk;
+
+  for (size_t i = 0; i < span->count; i++)
+  {
+    job->map(df_span_at(span, i), job->out + (first + i) * job->out_stride);
+  }
+}
+
+// Sequential sources have no length up front, so their output grows as elements arrive
+static void df_parallel_visit_map_growing(DfParallel_Job *job, void *scratch, size_t chunk, size_t first, DfSpan *span)
+{
+  (void)chunk;
+  (void)first;
+
+  for (size_t i = 0; i < span->count && !job->error.error; i++)
+  {
+    job->map(df_span_at(span, i), scratch);
+    job->error = dfarray_push(job->output, scratch);
+  }
+}
+
+DfResult df_parallel_map(Iterator *it, DfArray *output, void (*func)(void *element, void *out), const DfParallel_Options *options)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(output, &res);
+  df_null_ptr_check(func, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  DfParallel_Job job;
+  size_t threads;
+  df_parallel_job_init(&job, it, options, &threads);
+  job.map = func;
+  job.output = output;
+
+  if (!it->span_at)
+  {
+    DfResult clear_res = dfarray_set_length(output, 0);
+    if (clear_res.error)
+    {
+      return clear_res;
+    }
+
+    Iterator output_it;
+    dfarray_iterator_init(&output_it, output);
+    job.visit = df_parallel_visit_map_growing;
+    job.scratch_size = output_it.elem_size(&output_it);
+  }
+  else
+  {
+    DfResult length_res = dfarray_set_length(output, job.length);
+    if (length_res.error)
+    {
+      return length_res;
+    }
+
+    DfArray_Span out_span;
+    dfarray_span(output, &out_span);
+    job.visit = df_parallel_visit_map;
+    job.out = (char *)out_span.data;
+    job.out_stride = out_span.stride;
+  }
+
+  res = df_parallel_run(&job, threads);
+  if (res.error)
+  {
+    return res;
+  }
+  if (job.error.error)
+  {
+    return job.error;
+  }
+
+  res.value = output;
+  return res;
+}
+
+// For each
+
+// func gets a per-thread scratch copy so it cannot modify the structure, as with df_for_each
+static void df_parallel_visit_for_each(DfParallel_Job *job, void *scratch, size_t chunk, size_t first, DfSpan *span)
+{
+  (void)chunk;
+  (void)first;
+
+  for (size_t i = 0; i < span->count; i++)
+  {
+    memcpy(scratch, df_span_at(span, i), job->scratch_size);
+    job->for_each(scratch);
+  }
+}
+
+DfResult df_parallel_for_each(Iterator *it, void (*func)(void *element), const DfParallel_Options *options)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(func, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!it->elem_size)
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
+  DfParallel_Job job;
+  size_t threads;
+  df_parallel_job_init(&job, it, options, &threads);
+  job.for_each = func;
+  job.visit = df_parallel_visit_for_each;
+  job.scratch_size = it->elem_size(it);
+
+  return df_parallel_run(&job, threads);
+}
+
+// Reduce
+
+static void df_parallel_visit_reduce(DfParallel_Job *job, void *scratch, size_t chunk, size_t first, DfSpan *span)
+{
+  (void)scratch;
+  (void)first;
+  void *partial = job->partials + chunk * job->partial_size;
+
+  for (size_t i = 0; i < span->count; i++)
+  {
+    job->reduce(partial, df_span_at(span, i));
+  }
+}
+
+DfResult df_parallel_reduce(Iterator *it, void *initial, void (*func)(void *accumulator, void *element), void (*combine)(void *accumulator, void *partial), const DfParallel_Options *options)
+{
+  DfResult res = df_result_init();
+
+  df_null_ptr_check(it, &res);
+  df_null_ptr_check(initial, &res);
+  df_null_ptr_check(func, &res);
+  df_null_ptr_check(combine, &res);
+  if (res.error)
+  {
+    return res;
+  }
+
+  if (!it->elem_size)
+  {
+    res.error = DF_ERR_INCOMPATIBLE;
+    return res;
+  }
+
+  DfParallel_Job job;
+  size_t threads;
+  df_parallel_job_init(&job, it, options, &threads);
+  job.visit = df_parallel_visit_reduce;
+  job.reduce = func;
+  job.partial_size = it->elem_size(it);
+
+  size_t partial_count = job.chunks ? job.chunks : 1;
+  job.partials = malloc(partial_count * job.partial_size);
+  if (!job.partials)
+  {
+    res.error = DF_ERR_ALLOC_FAILED;
+    return res;
+  }
+
+  for (size_t i = 0; i < partial_count; i++)
+  {
+    memcpy(job.partials + i * job.partial_size, initial, job.partial_size);
+  }
+
+  res = df_parallel_run(&job, threads);
+  if (res.error)
+  {
+    free(job.partials);
+    return res;
+  }
+
+  // The first partial becomes the result; the rest fold into it in order
+  for (size_t i = 1; i < partial_count; i++)
+  {
+    combine(job.partials, job.partials + i * job.partial_size);
+  }
+
+  void *result = realloc(job.partials, job.partial_size);
+  res.value = result ? result : job.partials;
+  return res;
+}
@@ -7,6 +7,8 @@
 #include "../../../includes/df_array.h"
 #include "../../../includes/df_iterator.h"
 #include "../../../includes/df_common.h"
+#include "../../../includes/df_list_s.h"
+#include "../../../includes/df_deque.h"
 #include "../../../internal/df_internal.h"
 
 typedef struct DfArray
@@ -15,6 +17,14 @@ typedef struct DfArray
   size_t length;
   size_t elem_size;
   size_t capacity;
+  size_t stride;
+  size_t alignment;
+  DfArray_Policy policy;
+  DfArray_Stats stats;
+  size_t inline_capacity;
+  size_t mapped_bytes;
+  unsigned flags;
+  max_align_t inline_items[];
 } DfArray;
 
 // Helper functions
@@ -85,7 +95,14 @@ Test(df_array_suit, resizes_array_with_zero_capacity)
   arr->capacity = 0;
   arr->length = 0;
   arr->elem_size = sizeof(int);
+  arr->stride = sizeof(int);
+  arr->alignment = _Alignof(max_align_t);
   arr->items = NULL;
+  arr->policy = DFARRAY_POLICY_DEFAULT;
+  arr->stats = (DfArray_Stats){0};
+  arr->inline_capacity = 0;
+  arr->mapped_bytes = 0;
+  arr->flags = 0;
 
   DfResult resize_res = dfarray_resize(arr);
   cr_assert_eq(resize_res.error, DF_OK, "Resize with zero capacity failed");
@@ -634,6 +651,746 @@ Test(df_array_suit, returns_correct_length_after_operations)
   dfarray_destroy(arr);
 }
 
+Test(df_array_suit, at_returns_borrowed_pointer_into_items)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 5);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3};
+  for (size_t i = 0; i < 3; i++)
+  {
+    dfarray_push(arr, &values[i]);
+  }
+
+  DfResult at_res = dfarray_at(arr, 1);
+  cr_assert_eq(at_res.error, DF_OK, "Expected DF_OK when accessing a valid index");
+  cr_assert_eq(at_res.value, (int *)arr->items + 1, "Expected pointer into the array storage");
+
+  *(int *)at_res.value = 42;
+  cr_assert_eq(((int *)arr->items)[1], 42, "Expected write through borrowed pointer to update the array");
+
+  DfResult bad_res = dfarray_at(arr, 3);
+  cr_assert_eq(bad_res.error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for invalid index");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, front_and_back_return_end_elements)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 5);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+
+  cr_assert_eq(dfarray_front(arr).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY on empty array");
+  cr_assert_eq(dfarray_back(arr).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY on empty array");
+
+  int values[] = {7, 8, 9};
+  for (size_t i = 0; i < 3; i++)
+  {
+    dfarray_push(arr, &values[i]);
+  }
+
+  cr_assert_eq(*(int *)dfarray_front(arr).value, 7, "Expected front to be 7");
+  cr_assert_eq(*(int *)dfarray_back(arr).value, 9, "Expected back to be 9");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, span_describes_array_storage)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 5);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3, 4};
+  for (size_t i = 0; i < 4; i++)
+  {
+    dfarray_push(arr, &values[i]);
+  }
+
+  DfArray_Span span;
+  DfResult span_res = dfarray_span(arr, &span);
+  cr_assert_eq(span_res.error, DF_OK);
+  cr_assert_eq(span.data, arr->items, "Expected span data to alias items");
+  cr_assert_eq(span.length, 4, "Expected span length to be 4");
+  cr_assert_eq(span.elem_size, sizeof(int), "Expected span elem_size to match");
+
+  int sum = 0;
+  for (size_t i = 0; i < span.length; i++)
+  {
+    sum += ((int *)span.data)[i];
+  }
+  cr_assert_eq(sum, 10, "Expected sum over span to be 10");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, pop_into_copies_into_caller_buffer)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 6);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3, 4};
+  for (size_t i = 0; i < 4; i++)
+  {
+    dfarray_push(arr, &values[i]);
+  }
+
+  int out = 0;
+  DfResult pop_res = dfarray_pop_into(arr, &out);
+  cr_assert_eq(pop_res.error, DF_OK, "Pop into failed on non-empty array");
+  cr_assert_eq(out, 4, "Expected popped value to be 4");
+  cr_assert_eq(arr->length, 3, "Expected length to be 3 after pop");
+  cr_assert_eq(arr->capacity, 3, "Expected capacity to shrink after pop");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, shift_into_copies_into_caller_buffer)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 5);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+
+  int out = 0;
+  cr_assert_eq(dfarray_shift_into(arr, &out).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY on empty array");
+
+  int values[] = {1, 2, 3};
+  for (size_t i = 0; i < 3; i++)
+  {
+    dfarray_push(arr, &values[i]);
+  }
+
+  DfResult shift_res = dfarray_shift_into(arr, &out);
+  cr_assert_eq(shift_res.error, DF_OK, "Shift into failed on non-empty array");
+  cr_assert_eq(out, 1, "Expected shifted value to be 1");
+  cr_assert_eq(((int *)arr->items)[0], 2, "Expected remaining elements to move forward");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, append_n_grows_once_to_fit_batch)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 4);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[20];
+  for (int i = 0; i < 20; i++)
+  {
+    values[i] = i;
+  }
+
+  DfResult append_res = dfarray_append_n(arr, values, 20);
+  cr_assert_eq(append_res.error, DF_OK, "Append failed with valid array");
+  cr_assert_eq(arr->length, 20, "Expected length to be 20 after append");
+  cr_assert_eq(arr->capacity, 32, "Expected capacity to double up to the batch size");
+
+  for (int i = 0; i < 20; i++)
+  {
+    cr_assert_eq(((int *)arr->items)[i], i, "Expected value at index %d to be %d", i, i);
+  }
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, insert_range_shifts_tail_once)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 5);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 5, 6};
+  dfarray_append_n(arr, values, 4);
+
+  int block[] = {3, 4};
+  DfResult insert_res = dfarray_insert_range(arr, 2, block, 2);
+  cr_assert_eq(insert_res.error, DF_OK, "Insert range failed on valid index");
+  cr_assert_eq(arr->length, 6, "Expected length to be 6 after insert");
+
+  for (int i = 0; i < 6; i++)
+  {
+    cr_assert_eq(((int *)arr->items)[i], i + 1, "Expected value at index %d to be %d", i, i + 1);
+  }
+
+  DfResult bad_res = dfarray_insert_range(arr, 7, block, 2);
+  cr_assert_eq(bad_res.error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for invalid index");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, remove_range_removes_span)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 8);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  dfarray_append_n(arr, values, 8);
+
+  DfResult remove_res = dfarray_remove_range(arr, 2, 3);
+  cr_assert_eq(remove_res.error, DF_OK, "Remove range failed on valid span");
+  cr_assert_eq(arr->length, 5, "Expected length to be 5 after removal");
+
+  int expected[] = {1, 2, 6, 7, 8};
+  for (int i = 0; i < 5; i++)
+  {
+    cr_assert_eq(((int *)arr->items)[i], expected[i], "Expected value at index %d to be %d", i, expected[i]);
+  }
+
+  DfResult bad_res = dfarray_remove_range(arr, 3, 3);
+  cr_assert_eq(bad_res.error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for span past the end");
+  cr_assert_eq(arr->length, 5, "Expected length to be unchanged after failed removal");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, extends_from_array_iterator)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 2).value;
+  DfArray *source = dfarray_create(sizeof(int), 4).value;
+
+  int first[] = {1, 2};
+  int second[] = {3, 4, 5};
+  dfarray_append_n(arr, first, 2);
+  dfarray_append_n(source, second, 3);
+
+  Iterator *it = dfarray_iterator_create(source).value;
+  DfResult extend_res = dfarray_extend(arr, it);
+  cr_assert_eq(extend_res.error, DF_OK, "Extend failed with valid iterator");
+  cr_assert_eq(arr->length, 5, "Expected length to be 5 after extend");
+  cr_assert_not(it->has_next(it), "Expected source iterator to be exhausted");
+
+  for (int i = 0; i < 5; i++)
+  {
+    cr_assert_eq(((int *)arr->items)[i], i + 1, "Expected value at index %d to be %d", i, i + 1);
+  }
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfarray_destroy(source);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, extend_rejects_mismatched_element_size)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 2).value;
+  DfArray *source = dfarray_create(sizeof(double), 2).value;
+
+  double value = 1.5;
+  dfarray_push(source, &value);
+
+  Iterator *it = dfarray_iterator_create(source).value;
+  DfResult extend_res = dfarray_extend(arr, it);
+  cr_assert_eq(extend_res.error, DF_ERR_SIZE_MISMATCH, "Expected DF_ERR_SIZE_MISMATCH for different element sizes");
+  cr_assert_eq(arr->length, 0, "Expected array to be unchanged");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfarray_destroy(source);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, extends_from_list_iterator)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 2).value;
+  DfList_S *list = dflist_s_create().value;
+
+  int values[] = {1, 2, 3};
+  for (int i = 0; i < 3; i++)
+  {
+    dflist_s_push_back(list, &values[i]);
+  }
+
+  Iterator *it = dflist_s_iterator_create(list).value;
+  DfResult extend_res = dfarray_extend(arr, it);
+  cr_assert_eq(extend_res.error, DF_OK, "Extend failed with list iterator");
+
+  DfResult length_res = dfarray_length(arr);
+  cr_assert_eq((size_t)length_res.value, arr->length);
+  cr_assert_gt(arr->length, 0, "Expected elements to be appended from the list");
+  cr_assert_eq(((int *)arr->items)[arr->length - 1], 3, "Expected last appended value to be 3");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dflist_s_destroy(list, NULL);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, extend_from_deque_grows_once)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 1).value;
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+
+  // Pushing at both ends wraps the ring, so the deque yields two spans
+  for (int i = 500; i < 1000; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  for (int i = 499; i >= 0; i--)
+  {
+    dfdeque_push_front(deque, &i);
+  }
+
+  Iterator it;
+  dfdeque_iterator_init(&it, deque);
+  cr_assert_eq(dfarray_extend(arr, &it).error, DF_OK);
+  cr_assert_eq(arr->length, 1000, "Expected all 1000 elements to be appended");
+  for (int i = 0; i < 1000; i++)
+  {
+    cr_assert_eq(((int *)arr->items)[i], i, "Expected %d at index %d", i, i);
+  }
+
+  DfArray_Stats stats;
+  dfarray_stats(arr, &stats);
+  cr_assert_eq(stats.grows, 1, "Expected a single reallocation for a source of known length");
+
+  // Cleanup
+  dfdeque_destroy(deque);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, hysteresis_policy_avoids_realloc_when_oscillating)
+{
+  DfArray_Policy policy = {.growth_factor = 2.0, .shrink_divisor = 4, .shrink_slack = 2.0, .min_capacity = 0, .never_shrink = false};
+  DfResult create_res = dfarray_create_with_policy(sizeof(int), 8, &policy);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  dfarray_append_n(arr, values, 8);
+
+  // Oscillate around half capacity
+  for (int i = 0; i < 100; i++)
+  {
+    int out;
+    dfarray_pop_into(arr, &out);
+    dfarray_pop_into(arr, &out);
+    dfarray_pop_into(arr, &out);
+    dfarray_pop_into(arr, &out);
+    dfarray_append_n(arr, values, 4);
+  }
+
+  DfArray_Stats stats;
+  dfarray_stats(arr, &stats);
+  cr_assert_eq(stats.reallocs, 0, "Expected no reallocations but got %zu", stats.reallocs);
+  cr_assert_eq(arr->capacity, 8, "Expected capacity to remain 8");
+
+  // Dropping below a quarter shrinks, keeping twice the length
+  int out;
+  for (int i = 0; i < 6; i++)
+  {
+    dfarray_pop_into(arr, &out);
+  }
+  cr_assert_eq(arr->length, 2, "Expected length to be 2");
+  cr_assert_eq(arr->capacity, 4, "Expected capacity to shrink to twice the length");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, default_policy_counts_reallocs)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 4);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3, 4};
+  dfarray_append_n(arr, values, 4);
+
+  int value = 5;
+  dfarray_push(arr, &value);
+  cr_assert_eq(arr->capacity, 8, "Expected capacity to double");
+
+  int out;
+  dfarray_pop_into(arr, &out);
+  cr_assert_eq(arr->capacity, 4, "Expected capacity to shrink to length");
+
+  DfArray_Stats stats;
+  dfarray_stats(arr, &stats);
+  cr_assert_eq(stats.reallocs, 2, "Expected 2 reallocations but got %zu", stats.reallocs);
+  cr_assert_eq(stats.grows, 1, "Expected 1 grow");
+  cr_assert_eq(stats.shrinks, 1, "Expected 1 shrink");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, never_shrink_policy_keeps_capacity)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  policy.never_shrink = true;
+
+  DfResult create_res = dfarray_create_with_policy(sizeof(int), 8, &policy);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  int values[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  dfarray_append_n(arr, values, 8);
+  dfarray_remove_range(arr, 0, 8);
+
+  cr_assert_eq(arr->length, 0, "Expected array to be empty");
+  cr_assert_eq(arr->capacity, 8, "Expected capacity to be kept");
+  cr_assert_not_null(arr->items, "Expected items to be kept");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, min_capacity_bounds_shrinking)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  policy.min_capacity = 16;
+
+  DfResult create_res = dfarray_create_with_policy(sizeof(int), 2, &policy);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  cr_assert_eq(arr->capacity, 16, "Expected initial capacity to be raised to the minimum");
+
+  int values[40] = {0};
+  dfarray_append_n(arr, values, 40);
+  dfarray_remove_range(arr, 0, 39);
+  cr_assert_eq(arr->capacity, 16, "Expected capacity to stop at the minimum");
+
+  dfarray_shrink_to_fit(arr);
+  cr_assert_eq(arr->capacity, 16, "Expected shrink_to_fit to respect the minimum");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, reserve_and_shrink_to_fit)
+{
+  DfResult create_res = dfarray_create(sizeof(int), 2);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+
+  DfResult reserve_res = dfarray_reserve(arr, 100);
+  cr_assert_eq(reserve_res.error, DF_OK, "Reserve failed");
+  cr_assert_eq(arr->capacity, 100, "Expected capacity to be exactly 100");
+
+  dfarray_reserve(arr, 10);
+  cr_assert_eq(arr->capacity, 100, "Expected reserve to never reduce capacity");
+
+  int values[] = {1, 2, 3};
+  dfarray_append_n(arr, values, 3);
+
+  DfResult fit_res = dfarray_shrink_to_fit(arr);
+  cr_assert_eq(fit_res.error, DF_OK, "Shrink to fit failed");
+  cr_assert_eq(arr->capacity, 3, "Expected capacity to match length");
+  cr_assert_eq(((int *)arr->items)[2], 3, "Expected values to be kept");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, rejects_invalid_policy)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  policy.growth_factor = 1.0;
+
+  DfResult create_res = dfarray_create_with_policy(sizeof(int), 2, &policy);
+  cr_assert_eq(create_res.error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for growth factor of 1");
+
+  DfArray *arr = dfarray_create(sizeof(int), 2).value;
+  policy = DFARRAY_POLICY_DEFAULT;
+  policy.shrink_divisor = 0;
+  cr_assert_eq(dfarray_set_policy(arr, &policy).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for shrink divisor of 0");
+
+  DfArray_Policy current;
+  dfarray_get_policy(arr, &current);
+  cr_assert_eq(current.shrink_divisor, 2, "Expected policy to be unchanged");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, inline_array_spills_to_heap_on_overflow)
+{
+  DfResult create_res = dfarray_create_inline(sizeof(int), 4);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  cr_assert_eq(arr->items, (void *)arr->inline_items, "Expected items to use inline storage");
+  cr_assert_eq(arr->capacity, 4, "Expected capacity to be the inline count");
+
+  int values[] = {1, 2, 3, 4, 5};
+  dfarray_append_n(arr, values, 4);
+  cr_assert_eq(arr->items, (void *)arr->inline_items, "Expected items to stay inline while they fit");
+
+  DfArray_Stats stats;
+  dfarray_stats(arr, &stats);
+  cr_assert_eq(stats.reallocs, 0, "Expected no allocation while inline");
+
+  dfarray_push(arr, &values[4]);
+  cr_assert_neq(arr->items, (void *)arr->inline_items, "Expected items to spill to the heap");
+  cr_assert_eq(arr->capacity, 8, "Expected capacity to double on spill");
+
+  for (int i = 0; i < 5; i++)
+  {
+    cr_assert_eq(((int *)arr->items)[i], i + 1, "Expected value at index %d to be %d", i, i + 1);
+  }
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, inline_array_returns_to_inline_storage_on_shrink)
+{
+  DfArray *arr = dfarray_create_inline(sizeof(int), 4).value;
+
+  int values[] = {1, 2, 3, 4, 5, 6};
+  dfarray_append_n(arr, values, 6);
+  cr_assert_neq(arr->items, (void *)arr->inline_items, "Expected items on the heap");
+
+  dfarray_remove_range(arr, 0, 3);
+  cr_assert_eq(arr->items, (void *)arr->inline_items, "Expected items to move back inline");
+  cr_assert_eq(arr->capacity, 4, "Expected capacity to be the inline count");
+  cr_assert_eq(((int *)arr->items)[0], 4, "Expected value at index 0 to be 4");
+  cr_assert_eq(((int *)arr->items)[2], 6, "Expected value at index 2 to be 6");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, init_inline_places_array_in_caller_storage)
+{
+  DFARRAY_INLINE_STORAGE(storage, sizeof(int), 16);
+
+  DfResult init_res = dfarray_init_inline(storage, sizeof(storage), sizeof(int));
+  cr_assert_eq(init_res.error, DF_OK);
+
+  DfArray *arr = init_res.value;
+  cr_assert_eq((void *)arr, (void *)storage, "Expected header to live in the caller storage");
+  cr_assert_geq(arr->capacity, 16, "Expected room for at least 16 inline elements");
+
+  for (int i = 0; i < 40; i++)
+  {
+    dfarray_push(arr, &i);
+  }
+  cr_assert_eq(arr->length, 40, "Expected length to be 40");
+  cr_assert_eq(*(int *)dfarray_at(arr, 39).value, 39, "Expected last value to be 39");
+
+  // Releases the spilled heap storage but not the caller storage
+  DfResult destroy_res = dfarray_destroy(arr);
+  cr_assert_eq(destroy_res.error, DF_OK);
+
+  unsigned char small[8];
+  cr_assert_eq(dfarray_init_inline(small, sizeof(small), sizeof(int)).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for undersized storage");
+}
+
+Test(df_array_suit, inline_array_supports_iteration_and_free_all)
+{
+  DfArray *arr = dfarray_create_inline(sizeof(int), 8).value;
+
+  int values[] = {1, 2, 3};
+  dfarray_append_n(arr, values, 3);
+
+  Iterator *it = dfarray_iterator_create(arr).value;
+  int sum = 0;
+  while (it->has_next(it))
+  {
+    DfResult next_res = it->next(it);
+    sum += *(int *)next_res.value;
+    free(next_res.value);
+  }
+  cr_assert_eq(sum, 6, "Expected sum to be 6");
+
+  DfResult free_res = dfarray_free_all(it);
+  cr_assert_eq(free_res.error, DF_OK);
+  cr_assert_eq(arr->length, 0, "Expected array to be empty");
+  cr_assert_eq(arr->items, (void *)arr->inline_items, "Expected inline storage to be kept");
+
+  dfarray_push(arr, &values[0]);
+  cr_assert_eq(arr->length, 1, "Expected array to be reusable");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, aligned_array_keeps_alignment_across_growth_and_shrink)
+{
+  size_t alignments[] = {32, 64, 4096};
+  for (size_t a = 0; a < 3; a++)
+  {
+    DfResult create_res = dfarray_create_aligned(sizeof(float), 3, alignments[a], 0);
+    cr_assert_eq(create_res.error, DF_OK);
+
+    DfArray *arr = create_res.value;
+    cr_assert_eq((uintptr_t)arr->items % alignments[a], 0, "Expected %zu byte aligned storage", alignments[a]);
+
+    for (int i = 0; i < 1000; i++)
+    {
+      float value = (float)i;
+      dfarray_push(arr, &value);
+      cr_assert_eq((uintptr_t)arr->items % alignments[a], 0, "Expected alignment kept after growth");
+    }
+
+    float out;
+    for (int i = 0; i < 990; i++)
+    {
+      dfarray_pop_into(arr, &out);
+    }
+    cr_assert_lt(arr->capacity, 1000, "Expected the array to have shrunk");
+    cr_assert_eq((uintptr_t)arr->items % alignments[a], 0, "Expected alignment kept after shrink");
+    cr_assert_eq(*(float *)dfarray_at(arr, 9).value, 9.0f, "Expected elements to survive reallocation");
+
+    // Cleanup
+    dfarray_destroy(arr);
+  }
+}
+
+Test(df_array_suit, padded_stride_separates_elements)
+{
+  DfArray *arr = dfarray_create_aligned(sizeof(int), 2, 64, 64).value;
+
+  int values[] = {1, 2, 3, 4};
+  dfarray_append_n(arr, values, 4);
+  int zero = 0;
+  dfarray_unshift(arr, &zero);
+  int middle = 99;
+  dfarray_insert_at(arr, 2, &middle);
+  dfarray_remove_at(arr, 3);
+
+  int expected[] = {0, 1, 99, 3, 4};
+  cr_assert_eq(arr->length, 5, "Expected length to be 5");
+  for (size_t i = 0; i < 5; i++)
+  {
+    int *slot = dfarray_at(arr, i).value;
+    cr_assert_eq(*slot, expected[i], "Expected %d at index %zu", expected[i], i);
+    cr_assert_eq((uintptr_t)slot % 64, 0, "Expected each element on its own cache line");
+  }
+
+  DfArray_Span span;
+  dfarray_span(arr, &span);
+  cr_assert_eq(span.stride, 64, "Expected span stride to be 64");
+  cr_assert_eq(span.elem_size, sizeof(int), "Expected span elem_size to be int");
+
+  // Copying into an unpadded array packs the elements
+  DfArray *packed = dfarray_create(sizeof(int), 0).value;
+  Iterator *it = dfarray_iterator_create(arr).value;
+  dfarray_extend(packed, it);
+  dfarray_span(packed, &span);
+  for (size_t i = 0; i < 5; i++)
+  {
+    cr_assert_eq(((int *)span.data)[i], expected[i], "Expected packed %d at index %zu", expected[i], i);
+  }
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfarray_destroy(packed);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, rejects_invalid_alignment_and_stride)
+{
+  cr_assert_eq(dfarray_create_aligned(sizeof(int), 4, 48, 0).error, DF_ERR_OUT_OF_RANGE, "Expected non power of two alignment to fail");
+  cr_assert_eq(dfarray_create_aligned(sizeof(int), 4, 0, 0).error, DF_ERR_OUT_OF_RANGE, "Expected zero alignment to fail");
+  cr_assert_eq(dfarray_create_aligned(8, 4, 64, 4).error, DF_ERR_OUT_OF_RANGE, "Expected stride below elem_size to fail");
+}
+
+#ifdef __linux__
+// Mirrors DFARRAY_FLAG_MAPPED in df_array.c
+#define TEST_FLAG_MAPPED 0x2u
+
+Test(df_array_suit, maps_storage_above_threshold_and_remaps_on_growth)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  policy.mmap_threshold = 64 * 1024;
+  DfArray *arr = dfarray_create_with_policy(sizeof(int), 0, &policy).value;
+
+  for (int i = 0; i < 200000; i++)
+  {
+    dfarray_push(arr, &i);
+  }
+
+  cr_assert(arr->flags & TEST_FLAG_MAPPED, "Expected storage to be mapped above the threshold");
+  cr_assert_geq(arr->mapped_bytes, arr->capacity * sizeof(int), "Expected mapping to cover the capacity");
+
+  DfArray_Stats stats;
+  dfarray_stats(arr, &stats);
+  cr_assert_gt(stats.remaps, 0, "Expected mapped storage to grow with mremap");
+
+  for (int i = 0; i < 200000; i++)
+  {
+    cr_assert_eq(*(int *)dfarray_at(arr, i).value, i, "Expected %d at index %d", i, i);
+  }
+
+  // Shrinking below the threshold moves the elements back to the heap
+  dfarray_remove_range(arr, 10, 200000 - 10);
+  dfarray_shrink_to_fit(arr);
+  cr_assert_not(arr->flags & TEST_FLAG_MAPPED, "Expected storage to return to the heap");
+  cr_assert_eq(arr->mapped_bytes, 0, "Expected mapping to be released");
+  cr_assert_eq(*(int *)dfarray_at(arr, 9).value, 9, "Expected elements to survive the move");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, mapped_shrink_keeps_mapping_in_place)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  policy.mmap_threshold = 64 * 1024;
+  DfArray *arr = dfarray_create_with_policy(sizeof(int), 100000, &policy).value;
+  cr_assert(arr->flags & TEST_FLAG_MAPPED, "Expected large initial capacity to be mapped");
+
+  int values[50000];
+  for (int i = 0; i < 50000; i++)
+  {
+    values[i] = i;
+  }
+  dfarray_append_n(arr, values, 50000);
+
+  void *items = arr->items;
+  size_t mapped_bytes = arr->mapped_bytes;
+  dfarray_shrink_to_fit(arr);
+
+  cr_assert_eq(arr->capacity, 50000, "Expected capacity to shrink to the length");
+  cr_assert_eq(arr->items, items, "Expected the mapping not to move on shrink");
+  cr_assert_eq(arr->mapped_bytes, mapped_bytes, "Expected the reservation to be kept");
+  cr_assert_eq(*(int *)dfarray_at(arr, 49999).value, 49999, "Expected elements to be kept");
+
+  // Growing back into the reservation needs no new mapping
+  dfarray_reserve(arr, 100000);
+  cr_assert_eq(arr->items, items, "Expected growth inside the reservation to stay in place");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_suit, zero_mmap_threshold_keeps_heap_storage)
+{
+  DfArray_Policy policy = DFARRAY_POLICY_DEFAULT;
+  policy.mmap_threshold = 0;
+  DfArray *arr = dfarray_create_with_policy(sizeof(int), 1 << 20, &policy).value;
+
+  cr_assert_not(arr->flags & TEST_FLAG_MAPPED, "Expected heap storage when mapping is disabled");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+#endif
+
 Test(df_array_iterator_suit, iterator_has_next)
 {
   size_t elem_size = sizeof(int);
@@ -815,3 +1572,77 @@ Test(df_array_iterator_suit, iterator_free_all)
   dfarray_destroy(arr);
   iterator_destroy(it);
 }
+
+Test(df_array_iterator_suit, next_batch_hands_out_the_array_storage)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 4).value;
+  for (int i = 0; i < 5; i++)
+  {
+    dfarray_push(arr, &i);
+  }
+
+  Iterator *it = dfarray_iterator_create(arr).value;
+  DfSpan span;
+
+  cr_assert_eq(it->next_batch(it, &span, 3).error, DF_OK);
+  cr_assert_eq(span.count, 3);
+  cr_assert_eq(df_span_at(&span, 0), dfarray_at(arr, 0).value, "Expected the array's own storage");
+  cr_assert_eq(*(int *)df_span_at(&span, 2), 2);
+
+  it->next_batch(it, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 2);
+  cr_assert_eq(*(int *)df_span_at(&span, 1), 4);
+
+  it->next_batch(it, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 0, "Expected an empty span once exhausted");
+  cr_assert(!it->has_next(it));
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfarray_destroy(arr);
+}
+
+Test(df_array_iterator_suit, init_fills_a_stack_iterator)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 4).value;
+  for (int i = 0; i < 3; i++)
+  {
+    dfarray_push(arr, &i);
+  }
+
+  Iterator it;
+  DfResult res = dfarray_iterator_init(&it, arr);
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq(res.value, &it);
+  cr_assert_eq(it.current, (void *)it.state, "Expected the state to live inside the Iterator");
+
+  DfSpan span;
+  it.next_batch(&it, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 3);
+  cr_assert_eq(*(int *)df_span_at(&span, 2), 2);
+  cr_assert(!it.has_next(&it));
+
+  // Destroying a stack iterator releases nothing and is safe
+  cr_assert_eq(iterator_destroy(&it).error, DF_OK);
+  cr_assert_null(it.current);
+
+  cr_assert_eq(dfarray_iterator_init(NULL, arr).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfarray_iterator_init(&it, NULL).error, DF_ERR_NULL_PTR);
+
+  dfarray_destroy(arr);
+}
+
+Test(df_array_iterator_suit, iterator_free_releases_heap_iterators)
+{
+  DfArray *arr = dfarray_create(sizeof(int), 4).value;
+  int value = 7;
+  dfarray_push(arr, &value);
+
+  Iterator *it = dfarray_iterator_create(arr).value;
+  cr_assert_eq(it->current, (void *)it->state, "Expected heap iterators to need a single allocation");
+  cr_assert_eq(iterator_free(it).error, DF_OK);
+  cr_assert_eq(iterator_free(NULL).error, DF_ERR_NULL_PTR);
+
+  dfarray_destroy(arr);
+}
@@ -0,0 +1,292 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "../../../includes/df_array.h"
+#include "../../../includes/df_common.h"
+
+typedef struct SortRecord
+{
+  uint32_t id;
+  int64_t score;
+  char payload[80];
+} SortRecord;
+
+// Helper functions
+static int cmp_int(const void *a, const void *b)
+{
+  int x = *(const int *)a;
+  int y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static int cmp_record_score(const void *a, const void *b)
+{
+  int64_t x = ((const SortRecord *)a)->score;
+  int64_t y = ((const SortRecord *)b)->score;
+  return (x > y) - (x < y);
+}
+
+static uint64_t record_id_key(const void *element)
+{
+  return ((const SortRecord *)element)->id;
+}
+
+static DfArray *random_ints(size_t n, int modulo)
+{
+  DfArray *array = dfarray_create(sizeof(int), n).value;
+  srand(1234);
+  for (size_t i = 0; i < n; i++)
+  {
+    int value = rand() % modulo - modulo / 2;
+    dfarray_push(array, &value);
+  }
+  return array;
+}
+
+static int is_sorted_ints(DfArray *array)
+{
+  DfArray_Span span;
+  dfarray_span(array, &span);
+  const int *data = span.data;
+  for (size_t i = 1; i < span.length; i++)
+  {
+    if (data[i - 1] > data[i])
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+Test(df_array_sort_suit, sorts_with_comparator)
+{
+  DfArray *array = random_ints(10000, 1000000);
+
+  DfResult sort_res = dfarray_sort(array, cmp_int);
+  cr_assert_eq(sort_res.error, DF_OK);
+  cr_assert(is_sorted_ints(array), "Expected array to be sorted");
+  cr_assert_eq((size_t)dfarray_length(array).value, 10000, "Expected length to be unchanged");
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, sorts_many_duplicates_and_presorted_input)
+{
+  DfArray *array = random_ints(5000, 4);
+  dfarray_sort(array, cmp_int);
+  cr_assert(is_sorted_ints(array), "Expected array with duplicates to be sorted");
+
+  // Sorting sorted and reversed input exercises the depth limit
+  dfarray_sort(array, cmp_int);
+  cr_assert(is_sorted_ints(array), "Expected sorted input to stay sorted");
+
+  DfArray *reversed = dfarray_create(sizeof(int), 5000).value;
+  for (int i = 5000; i > 0; i--)
+  {
+    dfarray_push(reversed, &i);
+  }
+  dfarray_sort(reversed, cmp_int);
+  cr_assert(is_sorted_ints(reversed), "Expected reversed input to be sorted");
+
+  // Cleanup
+  dfarray_destroy(array);
+  dfarray_destroy(reversed);
+}
+
+Test(df_array_sort_suit, sorts_large_records_with_comparator)
+{
+  DfArray *array = dfarray_create(sizeof(SortRecord), 500).value;
+  srand(99);
+  for (uint32_t i = 0; i < 500; i++)
+  {
+    SortRecord record = {.id = i, .score = rand() % 100};
+    dfarray_push(array, &record);
+  }
+
+  dfarray_sort(array, cmp_record_score);
+
+  DfArray_Span span;
+  dfarray_span(array, &span);
+  const SortRecord *records = span.data;
+  for (size_t i = 1; i < span.length; i++)
+  {
+    cr_assert_leq(records[i - 1].score, records[i].score, "Expected records sorted by score at %zu", i);
+  }
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, radix_sorts_signed_integers)
+{
+  DfArray *array = random_ints(20000, 2000000);
+
+  DfResult sort_res = dfarray_radix_sort(array, DF_KEY_I32, 0);
+  cr_assert_eq(sort_res.error, DF_OK);
+  cr_assert(is_sorted_ints(array), "Expected array to be sorted");
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, radix_sorts_floating_point_keys)
+{
+  double values[] = {3.5, -0.25, 1e300, -1e300, 0.0, -7.0, 2.0, -0.5};
+  double expected[] = {-1e300, -7.0, -0.5, -0.25, 0.0, 2.0, 3.5, 1e300};
+  DfArray *doubles = dfarray_create(sizeof(double), 8).value;
+  dfarray_append_n(doubles, values, 8);
+
+  cr_assert_eq(dfarray_radix_sort(doubles, DF_KEY_F64, 0).error, DF_OK);
+  for (size_t i = 0; i < 8; i++)
+  {
+    cr_assert_eq(*(double *)dfarray_at(doubles, i).value, expected[i], "Expected double at %zu to be %g", i, expected[i]);
+  }
+
+  float fvalues[] = {1.5f, -2.5f, 0.0f, -0.125f, 8.0f};
+  float fexpected[] = {-2.5f, -0.125f, 0.0f, 1.5f, 8.0f};
+  DfArray *floats = dfarray_create(sizeof(float), 5).value;
+  dfarray_append_n(floats, fvalues, 5);
+
+  cr_assert_eq(dfarray_radix_sort(floats, DF_KEY_F32, 0).error, DF_OK);
+  for (size_t i = 0; i < 5; i++)
+  {
+    cr_assert_eq(*(float *)dfarray_at(floats, i).value, fexpected[i], "Expected float at %zu to be %g", i, fexpected[i]);
+  }
+
+  // Cleanup
+  dfarray_destroy(doubles);
+  dfarray_destroy(floats);
+}
+
+Test(df_array_sort_suit, radix_sorts_unsigned_64_bit_keys)
+{
+  DfArray *array = dfarray_create(sizeof(uint64_t), 1000).value;
+  uint64_t value = 88172645463325252ull;
+  for (int i = 0; i < 1000; i++)
+  {
+    value ^= value << 13;
+    value ^= value >> 7;
+    value ^= value << 17;
+    dfarray_push(array, &value);
+  }
+
+  cr_assert_eq(dfarray_radix_sort(array, DF_KEY_U64, 0).error, DF_OK);
+  for (size_t i = 1; i < 1000; i++)
+  {
+    cr_assert_leq(*(uint64_t *)dfarray_at(array, i - 1).value, *(uint64_t *)dfarray_at(array, i).value, "Expected ascending at %zu", i);
+  }
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, radix_sorts_records_by_key_field_stably)
+{
+  DfArray *array = dfarray_create(sizeof(SortRecord), 300).value;
+  for (uint32_t i = 0; i < 300; i++)
+  {
+    SortRecord record = {.id = i, .score = (int64_t)(i % 7) - 3};
+    dfarray_push(array, &record);
+  }
+
+  DfResult sort_res = dfarray_radix_sort(array, DF_KEY_I64, offsetof(SortRecord, score));
+  cr_assert_eq(sort_res.error, DF_OK);
+
+  for (size_t i = 1; i < 300; i++)
+  {
+    SortRecord *prev = dfarray_at(array, i - 1).value;
+    SortRecord *cur = dfarray_at(array, i).value;
+    cr_assert_leq(prev->score, cur->score, "Expected records sorted by score at %zu", i);
+    if (prev->score == cur->score)
+    {
+      cr_assert_lt(prev->id, cur->id, "Expected equal keys to keep their order at %zu", i);
+    }
+  }
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, radix_sorts_by_extracted_key)
+{
+  DfArray *array = dfarray_create(sizeof(SortRecord), 100).value;
+  for (uint32_t i = 0; i < 100; i++)
+  {
+    SortRecord record = {.id = (i * 37) % 100, .score = i};
+    dfarray_push(array, &record);
+  }
+
+  cr_assert_eq(dfarray_radix_sort_by(array, record_id_key).error, DF_OK);
+  for (uint32_t i = 0; i < 100; i++)
+  {
+    cr_assert_eq(((SortRecord *)dfarray_at(array, i).value)->id, i, "Expected id %u at index %u", i, i);
+  }
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, radix_rejects_key_outside_element)
+{
+  DfArray *array = dfarray_create(sizeof(int), 4).value;
+
+  cr_assert_eq(dfarray_radix_sort(array, DF_KEY_U64, 0).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for 8 byte key in 4 byte element");
+  cr_assert_eq(dfarray_radix_sort(array, DF_KEY_U32, 2).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for key past the end");
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, searches_sorted_array)
+{
+  int values[] = {1, 3, 3, 3, 5, 8};
+  DfArray *array = dfarray_create(sizeof(int), 6).value;
+  dfarray_append_n(array, values, 6);
+
+  int key = 3;
+  cr_assert_eq((size_t)dfarray_lower_bound(array, &key, cmp_int).value, 1, "Expected lower bound of 3 to be 1");
+  cr_assert_eq((size_t)dfarray_upper_bound(array, &key, cmp_int).value, 4, "Expected upper bound of 3 to be 4");
+
+  DfResult found = dfarray_binary_search(array, &key, cmp_int);
+  cr_assert_eq(found.error, DF_OK);
+  cr_assert_eq((size_t)found.value, 1, "Expected first match at index 1");
+
+  key = 4;
+  cr_assert_eq((size_t)dfarray_lower_bound(array, &key, cmp_int).value, 4, "Expected lower bound of 4 to be 4");
+  cr_assert_eq(dfarray_binary_search(array, &key, cmp_int).error, DF_ERR_ELEMENT_NOT_FOUND, "Expected 4 to be missing");
+
+  key = 9;
+  cr_assert_eq((size_t)dfarray_lower_bound(array, &key, cmp_int).value, 6, "Expected lower bound past the end");
+  cr_assert_eq(dfarray_binary_search(array, &key, cmp_int).error, DF_ERR_ELEMENT_NOT_FOUND, "Expected 9 to be missing");
+
+  // Cleanup
+  dfarray_destroy(array);
+}
+
+Test(df_array_sort_suit, sorts_padded_arrays)
+{
+  DfArray *array = dfarray_create_aligned(sizeof(int), 64, 64, 64).value;
+  srand(7);
+  for (int i = 0; i < 200; i++)
+  {
+    int value = rand() % 1000 - 500;
+    dfarray_push(array, &value);
+  }
+
+  dfarray_sort(array, cmp_int);
+  for (size_t i = 1; i < 200; i++)
+  {
+    cr_assert_leq(*(int *)dfarray_at(array, i - 1).value, *(int *)dfarray_at(array, i).value, "Expected ascending at %zu", i);
+  }
+
+  cr_assert_eq(dfarray_radix_sort(array, DF_KEY_I32, 0).error, DF_OK);
+  int key = 0;
+  size_t index = (size_t)dfarray_lower_bound(array, &key, cmp_int).value;
+  cr_assert(index == 200 || *(int *)dfarray_at(array, index).value >= 0, "Expected lower bound on padded storage");
+
+  // Cleanup
+  dfarray_destroy(array);
+}
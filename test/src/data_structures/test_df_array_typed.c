@@ -0,0 +1,129 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdint.h>
+#include "../../../includes/df_array.h"
+#include "../../../includes/df_array_typed.h"
+#include "../../../includes/df_common.h"
+
+DF_ARRAY_DEFINE(int32_t, i32)
+DF_ARRAY_DEFINE(double, f64)
+
+static void add_one(int32_t *element)
+{
+  *element += 1;
+}
+
+Test(df_array_typed_suit, pushes_and_gets_typed_values)
+{
+  DfResult create_res = dfarray_i32_create(2);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfArray *arr = create_res.value;
+  for (int32_t i = 0; i < 100; i++)
+  {
+    DfResult push_res = dfarray_i32_push(arr, i * 3);
+    cr_assert_eq(push_res.error, DF_OK, "Push failed at %d", i);
+  }
+
+  cr_assert_eq(dfarray_i32_length(arr), 100, "Expected length to be 100");
+
+  int32_t value = 0;
+  DfResult get_res = dfarray_i32_get(arr, 42, &value);
+  cr_assert_eq(get_res.error, DF_OK);
+  cr_assert_eq(value, 126, "Expected value at index 42 to be 126");
+
+  cr_assert_eq(dfarray_i32_get(arr, 100, &value).error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for invalid index");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_typed_suit, follows_untyped_growth_policy)
+{
+  DfArray *typed = dfarray_i32_create(3).value;
+  DfArray *untyped = dfarray_create(sizeof(int32_t), 3).value;
+
+  for (int32_t i = 0; i < 50; i++)
+  {
+    dfarray_i32_push(typed, i);
+    dfarray_push(untyped, &i);
+  }
+
+  DfArray_Stats typed_stats;
+  DfArray_Stats untyped_stats;
+  dfarray_stats(typed, &typed_stats);
+  dfarray_stats(untyped, &untyped_stats);
+  cr_assert_eq(typed_stats.grows, untyped_stats.grows, "Expected typed and untyped push to grow the same way");
+
+  // Cleanup
+  dfarray_destroy(typed);
+  dfarray_destroy(untyped);
+}
+
+Test(df_array_typed_suit, interoperates_with_untyped_api)
+{
+  DfArray *arr = dfarray_create(sizeof(double), 4).value;
+
+  double values[] = {1.5, 2.5, 3.5};
+  dfarray_append_n(arr, values, 3);
+
+  dfarray_f64_set(arr, 1, 10.0);
+  dfarray_f64_push(arr, 4.5);
+
+  cr_assert_eq(*(double *)dfarray_at(arr, 1).value, 10.0, "Expected typed set to be visible untyped");
+  cr_assert_eq(*(double *)dfarray_back(arr).value, 4.5, "Expected typed push to be visible untyped");
+
+  double out = 0;
+  DfResult pop_res = dfarray_f64_pop(arr, &out);
+  cr_assert_eq(pop_res.error, DF_OK);
+  cr_assert_eq(out, 4.5, "Expected popped value to be 4.5");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_typed_suit, rejects_array_of_other_element_size)
+{
+  DfArray *arr = dfarray_create(sizeof(double), 4).value;
+
+  cr_assert_eq(dfarray_i32_push(arr, 1).error, DF_ERR_SIZE_MISMATCH, "Expected DF_ERR_SIZE_MISMATCH for double array");
+  cr_assert_eq(dfarray_i32_push(NULL, 1).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR for NULL array");
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_typed_suit, iterates_in_place)
+{
+  DfArray *arr = dfarray_i32_create(4).value;
+  for (int32_t i = 0; i < 10; i++)
+  {
+    dfarray_i32_push(arr, i);
+  }
+
+  DfResult each_res = dfarray_i32_for_each(arr, add_one);
+  cr_assert_eq(each_res.error, DF_OK);
+
+  int32_t *data = dfarray_i32_data(arr);
+  for (int32_t i = 0; i < 10; i++)
+  {
+    cr_assert_eq(data[i], i + 1, "Expected value at index %d to be %d", i, i + 1);
+  }
+
+  // Cleanup
+  dfarray_destroy(arr);
+}
+
+Test(df_array_typed_suit, rejects_padded_arrays)
+{
+  DfArray *padded = dfarray_create_aligned(sizeof(int32_t), 4, 64, 64).value;
+  DfArray *aligned = dfarray_create_aligned(sizeof(int32_t), 4, 64, 0).value;
+
+  cr_assert_eq(dfarray_i32_push(padded, 1).error, DF_ERR_SIZE_MISMATCH, "Expected padded array to be rejected");
+  cr_assert_eq(dfarray_i32_push(aligned, 1).error, DF_OK, "Expected aligned unpadded array to be accepted");
+
+  // Cleanup
+  dfarray_destroy(padded);
+  dfarray_destroy(aligned);
+}
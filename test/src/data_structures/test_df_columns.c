@@ -0,0 +1,185 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../../includes/df_columns.h"
+#include "../../../includes/df_array.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static DfColumns *make_people(size_t rows)
+{
+  size_t sizes[] = {sizeof(uint32_t), sizeof(int32_t), sizeof(double)};
+  DfColumns *columns = dfcolumns_create(sizes, 3, 0).value;
+  for (size_t i = 0; i < rows; i++)
+  {
+    uint32_t id = (uint32_t)i;
+    int32_t age = (int32_t)(i % 50);
+    double balance = (double)i * 1.5;
+    const void *row[] = {&id, &age, &balance};
+    dfcolumns_append_row(columns, row);
+  }
+  return columns;
+}
+
+static bool is_adult(const void *element)
+{
+  return *(const int32_t *)element >= 18;
+}
+
+static bool is_rich(const void *element)
+{
+  return *(const double *)element > 100.0;
+}
+
+static void sum_double(void *acc, const void *elem)
+{
+  *(double *)acc += *(const double *)elem;
+}
+
+static bool is_even_age(void *element)
+{
+  return *(int32_t *)element % 2 == 0;
+}
+
+Test(df_columns_suit, creates_columns)
+{
+  size_t sizes[] = {sizeof(int), sizeof(double)};
+  DfResult res = dfcolumns_create(sizes, 2, 4);
+
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_not_null(res.value);
+  cr_assert_eq((size_t)dfcolumns_column_count(res.value).value, 2, "Expected 2 columns");
+  cr_assert_eq((size_t)dfcolumns_length(res.value).value, 0, "Expected no rows");
+
+  // Cleanup
+  dfcolumns_destroy(res.value);
+}
+
+Test(df_columns_suit, rejects_invalid_layout)
+{
+  size_t sizes[] = {sizeof(int), 0};
+
+  cr_assert_eq(dfcolumns_create(sizes, 2, 0).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for zero-sized column");
+  cr_assert_eq(dfcolumns_create(sizes, 0, 0).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE for no columns");
+  cr_assert_eq(dfcolumns_create(NULL, 1, 0).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR");
+}
+
+Test(df_columns_suit, appends_rows_across_columns)
+{
+  DfColumns *columns = make_people(100);
+
+  cr_assert_eq((size_t)dfcolumns_length(columns).value, 100, "Expected 100 rows");
+  cr_assert_eq(*(uint32_t *)dfcolumns_at(columns, 0, 42).value, 42, "Expected id 42");
+  cr_assert_eq(*(int32_t *)dfcolumns_at(columns, 1, 42).value, 42 % 50, "Expected age 42");
+  cr_assert_eq(*(double *)dfcolumns_at(columns, 2, 42).value, 63.0, "Expected balance 63.0");
+  cr_assert_eq(dfcolumns_at(columns, 3, 0).error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for column");
+  cr_assert_eq(dfcolumns_at(columns, 0, 100).error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for row");
+
+  // Cleanup
+  dfcolumns_destroy(columns);
+}
+
+Test(df_columns_suit, exposes_typed_column_storage)
+{
+  DfColumns *columns = make_people(10);
+
+  double *balances = DFCOLUMNS_DATA(columns, 2, double);
+  cr_assert_not_null(balances);
+  cr_assert_eq(balances[4], 6.0, "Expected balance 6.0");
+  cr_assert_null(DFCOLUMNS_DATA(columns, 2, float), "Expected NULL for wrong element type");
+  cr_assert_eq(dfcolumns_data(columns, 2, sizeof(float)).error, DF_ERR_SIZE_MISMATCH);
+
+  DfArray_Span span;
+  cr_assert_eq(dfcolumns_span(columns, 1, &span).error, DF_OK);
+  cr_assert_eq(span.length, 10, "Expected span length 10");
+  cr_assert_eq(span.elem_size, sizeof(int32_t), "Expected span elem_size of int32_t");
+
+  DfArray *ids = dfcolumns_column(columns, 0).value;
+  cr_assert_eq((size_t)dfarray_length(ids).value, 10, "Expected column array length 10");
+
+  // Cleanup
+  dfcolumns_destroy(columns);
+}
+
+Test(df_columns_suit, filters_into_selection_vectors)
+{
+  DfColumns *columns = make_people(100);
+
+  DfResult adults_res = dfcolumns_filter(columns, 1, NULL, is_adult);
+  cr_assert_eq(adults_res.error, DF_OK);
+  DfArray *adults = adults_res.value;
+  cr_assert_eq((size_t)dfarray_length(adults).value, 64, "Expected 64 adults");
+  cr_assert_eq(*(size_t *)dfarray_at(adults, 0).value, 18, "Expected first adult at row 18");
+
+  // Refine the selection with a predicate on another column
+  DfResult rich_res = dfcolumns_filter(columns, 2, adults, is_rich);
+  cr_assert_eq(rich_res.error, DF_OK);
+  DfArray *rich_adults = rich_res.value;
+
+  DfArray_Span span;
+  dfarray_span(rich_adults, &span);
+  const size_t *rows = span.data;
+  for (size_t i = 0; i < span.length; i++)
+  {
+    cr_assert_geq(*(int32_t *)dfcolumns_at(columns, 1, rows[i]).value, 18, "Expected adult at row %zu", rows[i]);
+    cr_assert_gt(*(double *)dfcolumns_at(columns, 2, rows[i]).value, 100.0, "Expected balance over 100 at row %zu", rows[i]);
+  }
+  cr_assert_eq(span.length, 32, "Expected 32 rich adults");
+
+  // Cleanup
+  dfarray_destroy(adults);
+  dfarray_destroy(rich_adults);
+  dfcolumns_destroy(columns);
+}
+
+Test(df_columns_suit, reduces_column_over_selection)
+{
+  DfColumns *columns = make_people(10);
+
+  double total = 0.0;
+  DfResult all_res = dfcolumns_reduce(columns, 2, NULL, &total, sum_double);
+  cr_assert_eq(all_res.error, DF_OK);
+  cr_assert_eq(total, 67.5, "Expected total balance 67.5");
+
+  DfArray *selection = dfarray_create(sizeof(size_t), 2).value;
+  size_t picks[] = {2, 8};
+  dfarray_append_n(selection, picks, 2);
+
+  double picked = 0.0;
+  dfcolumns_reduce(columns, 2, selection, &picked, sum_double);
+  cr_assert_eq(picked, 15.0, "Expected selected balance 15.0");
+
+  size_t bad_pick = 10;
+  dfarray_push(selection, &bad_pick);
+  cr_assert_eq(dfcolumns_reduce(columns, 2, selection, &picked, sum_double).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  DfArray *wrong = dfarray_create(sizeof(int), 1).value;
+  cr_assert_eq(dfcolumns_reduce(columns, 2, wrong, &picked, sum_double).error, DF_ERR_SIZE_MISMATCH);
+
+  // Cleanup
+  dfarray_destroy(selection);
+  dfarray_destroy(wrong);
+  dfcolumns_destroy(columns);
+}
+
+Test(df_columns_suit, iterates_single_column)
+{
+  DfColumns *columns = make_people(20);
+
+  Iterator *it = dfcolumns_iterator_create(columns, 1).value;
+  cr_assert_not_null(it);
+
+  DfResult count_res = df_count(it, is_even_age);
+  cr_assert_eq(count_res.error, DF_OK);
+  cr_assert_eq((size_t)count_res.value, 10, "Expected 10 even ages");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfcolumns_destroy(columns);
+}
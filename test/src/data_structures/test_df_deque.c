@@ -0,0 +1,305 @@
+#include <criterion/alloc.h>
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <criterion/logging.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "../../../includes/df_deque.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+#include "../../../internal/df_internal.h"
+
+typedef struct DfDeque
+{
+  void *items;
+  size_t head;
+  size_t length;
+  size_t capacity;
+  size_t elem_size;
+} DfDeque;
+
+// Helper functions
+static void *triple_value(void *element)
+{
+  *(int *)element *= 3;
+  return element;
+}
+
+static bool is_odd(void *element)
+{
+  return *(int *)element % 2 != 0;
+}
+
+static void sum_int(void *acc, void *elem)
+{
+  *(int *)acc += *(int *)elem;
+}
+
+Test(df_deque_suit, creates_deque_with_power_of_two_capacity)
+{
+  DfResult res = dfdeque_create(sizeof(int), 10);
+  cr_assert_eq(res.error, DF_OK, "Expected DF_OK but got error code %d", res.error);
+
+  DfDeque *deque = res.value;
+  cr_assert_eq(deque->capacity, 16, "Expected capacity to round up to 16");
+  cr_assert_eq(deque->length, 0, "Expected length to be 0");
+
+  DfDeque *small = dfdeque_create(sizeof(int), 0).value;
+  cr_assert_eq(small->capacity, DFDEQUE_MIN_CAPACITY, "Expected minimum capacity");
+
+  // Cleanup
+  dfdeque_destroy(deque);
+  dfdeque_destroy(small);
+}
+
+Test(df_deque_suit, rejects_capacities_that_overflow)
+{
+  DfResult res = dfdeque_create(sizeof(int), SIZE_MAX);
+  cr_assert_eq(res.error, DF_ERR_OUT_OF_RANGE, "Expected a capacity that cannot be rounded to fail");
+
+  res = dfdeque_create(8, SIZE_MAX / 4);
+  cr_assert_eq(res.error, DF_ERR_OUT_OF_RANGE, "Expected a capacity that cannot be sized to fail");
+}
+
+Test(df_deque_suit, pushes_and_pops_at_both_ends)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+
+  int values[] = {1, 2, 3, 4};
+  dfdeque_push_back(deque, &values[1]);
+  dfdeque_push_back(deque, &values[2]);
+  dfdeque_push_front(deque, &values[0]);
+  dfdeque_push_back(deque, &values[3]);
+
+  cr_assert_eq(*(int *)dfdeque_peek_front(deque).value, 1, "Expected front to be 1");
+  cr_assert_eq(*(int *)dfdeque_peek_back(deque).value, 4, "Expected back to be 4");
+
+  int out = 0;
+  cr_assert_eq(dfdeque_pop_front_into(deque, &out).error, DF_OK);
+  cr_assert_eq(out, 1, "Expected popped front to be 1");
+  cr_assert_eq(dfdeque_pop_back_into(deque, &out).error, DF_OK);
+  cr_assert_eq(out, 4, "Expected popped back to be 4");
+
+  DfResult pop_res = dfdeque_pop_front(deque);
+  cr_assert_eq(pop_res.error, DF_OK);
+  cr_assert_eq(*(int *)pop_res.value, 2, "Expected heap copy of 2");
+  free(pop_res.value);
+
+  pop_res = dfdeque_pop_back(deque);
+  cr_assert_eq(*(int *)pop_res.value, 3, "Expected heap copy of 3");
+  free(pop_res.value);
+
+  cr_assert_eq(dfdeque_pop_back(deque).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY on empty deque");
+  cr_assert_eq(dfdeque_pop_front_into(deque, &out).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY on empty deque");
+  cr_assert_eq(dfdeque_peek_front(deque).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY on empty deque");
+
+  // Cleanup
+  dfdeque_destroy(deque);
+}
+
+Test(df_deque_suit, wraps_around_without_moving_elements)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+
+  // Run a FIFO through the buffer several times over
+  int out;
+  for (int i = 0; i < 6; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  for (int i = 6; i < 100; i++)
+  {
+    dfdeque_push_back(deque, &i);
+    dfdeque_pop_front_into(deque, &out);
+    cr_assert_eq(out, i - 6, "Expected FIFO order");
+  }
+
+  cr_assert_eq(deque->capacity, 8, "Expected capacity to stay at 8");
+  cr_assert_eq(deque->length, 6, "Expected length to stay at 6");
+
+  // Cleanup
+  dfdeque_destroy(deque);
+}
+
+Test(df_deque_suit, grows_while_wrapped_and_keeps_order)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+
+  for (int i = 0; i < 4; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  for (int i = -1; i >= -8; i--)
+  {
+    dfdeque_push_front(deque, &i);
+  }
+
+  cr_assert_eq(deque->capacity, 16, "Expected capacity to double");
+  cr_assert_eq(deque->length, 12, "Expected length to be 12");
+
+  for (size_t i = 0; i < 12; i++)
+  {
+    cr_assert_eq(*(int *)dfdeque_at(deque, i).value, (int)i - 8, "Expected value at index %zu to be %d", i, (int)i - 8);
+  }
+
+  // Cleanup
+  dfdeque_destroy(deque);
+}
+
+Test(df_deque_suit, indexed_access_and_set)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+
+  int values[] = {10, 20, 30};
+  for (int i = 0; i < 3; i++)
+  {
+    dfdeque_push_front(deque, &values[i]);
+  }
+
+  int new_value = 99;
+  cr_assert_eq(dfdeque_set(deque, 1, &new_value).error, DF_OK);
+  cr_assert_eq(*(int *)dfdeque_at(deque, 0).value, 30, "Expected value at index 0 to be 30");
+  cr_assert_eq(*(int *)dfdeque_at(deque, 1).value, 99, "Expected value at index 1 to be 99");
+  cr_assert_eq(*(int *)dfdeque_at(deque, 2).value, 10, "Expected value at index 2 to be 10");
+
+  cr_assert_eq(dfdeque_at(deque, 3).error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for invalid index");
+  cr_assert_eq(dfdeque_set(deque, 3, &new_value).error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected DF_ERR_INDEX_OUT_OF_BOUNDS for invalid index");
+  cr_assert_eq((size_t)dfdeque_length(deque).value, 3, "Expected length to be 3");
+
+  // Cleanup
+  dfdeque_destroy(deque);
+}
+
+Test(df_deque_iterator_suit, iterates_front_to_back)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+
+  for (int i = 3; i < 6; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  for (int i = 2; i >= 0; i--)
+  {
+    dfdeque_push_front(deque, &i);
+  }
+
+  Iterator *it = dfdeque_iterator_create(deque).value;
+  int expected = 0;
+  while (it->has_next(it))
+  {
+    DfResult next_res = it->next(it);
+    cr_assert_eq(next_res.error, DF_OK);
+    cr_assert_eq(*(int *)next_res.value, expected, "Expected value %d", expected);
+    expected++;
+  }
+  cr_assert_eq(expected, 6, "Expected 6 elements");
+  cr_assert_eq(it->next(it).error, DF_ERR_INDEX_OUT_OF_BOUNDS, "Expected error past the end");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfdeque_destroy(deque);
+}
+
+Test(df_deque_iterator_suit, works_with_generic_utils)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+  for (int i = 1; i <= 5; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+
+  Iterator *it = dfdeque_iterator_create(deque).value;
+  DfResult filter_res = df_filter(it, is_odd);
+  cr_assert_eq(filter_res.error, DF_OK);
+  DfDeque *odd = filter_res.value;
+  cr_assert_eq(odd->length, 3, "Expected 3 odd values");
+  iterator_destroy(it);
+  free(it);
+
+  it = dfdeque_iterator_create(odd).value;
+  DfResult map_res = df_map(it, triple_value);
+  cr_assert_eq(map_res.error, DF_OK);
+  DfDeque *tripled = map_res.value;
+  cr_assert_eq(*(int *)dfdeque_at(tripled, 2).value, 15, "Expected 5 * 3 at index 2");
+  iterator_destroy(it);
+  free(it);
+
+  it = dfdeque_iterator_create(tripled).value;
+  int initial = 0;
+  DfResult reduce_res = df_reduce(it, &initial, sum_int);
+  cr_assert_eq(reduce_res.error, DF_OK);
+  cr_assert_eq(*(int *)reduce_res.value, 27, "Expected (1 + 3 + 5) * 3");
+  free(reduce_res.value);
+  iterator_destroy(it);
+  free(it);
+
+  // Cleanup
+  dfdeque_destroy(deque);
+  dfdeque_destroy(odd);
+  dfdeque_destroy(tripled);
+}
+
+Test(df_deque_iterator_suit, iterator_free_all_empties_deque)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+  int value = 1;
+  dfdeque_push_back(deque, &value);
+
+  Iterator *it = dfdeque_iterator_create(deque).value;
+  cr_assert_eq(dfdeque_elem_size(it), sizeof(int), "Element size mismatch");
+  cr_assert_eq(dfdeque_free_all(it).error, DF_OK);
+  cr_assert_eq(deque->length, 0, "Expected deque to be empty");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfdeque_destroy(deque);
+}
+
+Test(df_deque_iterator_suit, next_batch_stops_at_the_wrap)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+  for (int i = 0; i < 8; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  // Moves head to slot 3 so the last three elements wrap to the front of the buffer
+  int out;
+  for (int i = 0; i < 3; i++)
+  {
+    dfdeque_pop_front_into(deque, &out);
+  }
+  for (int i = 8; i < 11; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+
+  Iterator *it = dfdeque_iterator_create(deque).value;
+  DfSpan span;
+  int expected = 3;
+
+  it->next_batch(it, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 5, "Expected the span to end at the buffer's end");
+  for (size_t i = 0; i < span.count; i++)
+  {
+    cr_assert_eq(*(int *)df_span_at(&span, i), expected++);
+  }
+
+  it->next_batch(it, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 3);
+  for (size_t i = 0; i < span.count; i++)
+  {
+    cr_assert_eq(*(int *)df_span_at(&span, i), expected++);
+  }
+
+  it->next_batch(it, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 0);
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfdeque_destroy(deque);
+}
@@ -0,0 +1,227 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_list_d.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static int values[1000];
+
+static DfList_D *make_list(size_t n)
+{
+  DfList_D *list = dflist_d_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    values[i] = (int)i;
+    dflist_d_push_back(list, &values[i]);
+  }
+  return list;
+}
+
+static bool is_odd(void *element)
+{
+  return *(int *)element % 2 != 0;
+}
+
+Test(df_list_d_suit, creates_empty_list)
+{
+  DfResult res = dflist_d_create();
+
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq((size_t)dflist_d_length(res.value).value, 0, "Expected empty list");
+  cr_assert_eq(dflist_d_pop_front(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dflist_d_pop_back(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dflist_d_peek_back(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+
+  // Cleanup
+  dflist_d_destroy(res.value, NULL);
+}
+
+Test(df_list_d_suit, pops_from_both_ends)
+{
+  DfList_D *list = make_list(10);
+
+  cr_assert_eq(*(int *)dflist_d_pop_back(list).value, 9, "Expected 9 from the back");
+  cr_assert_eq(*(int *)dflist_d_pop_front(list).value, 0, "Expected 0 from the front");
+  cr_assert_eq(*(int *)dflist_d_peek_back(list).value, 8, "Expected 8 at the back");
+  cr_assert_eq(*(int *)dflist_d_peek_front(list).value, 1, "Expected 1 at the front");
+
+  for (int i = 8; i >= 1; i--)
+  {
+    cr_assert_eq(*(int *)dflist_d_pop_back(list).value, i, "Expected %d from the back", i);
+  }
+  cr_assert_eq((size_t)dflist_d_length(list).value, 0, "Expected empty list");
+  cr_assert_eq(dflist_d_peek_front(list).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+
+  // The list must be usable again after draining
+  int extra = 42;
+  dflist_d_push_front(list, &extra);
+  cr_assert_eq(*(int *)dflist_d_peek_back(list).value, 42, "Expected 42 at the back");
+
+  // Cleanup
+  dflist_d_destroy(list, NULL);
+}
+
+Test(df_list_d_suit, indexes_from_the_closer_end)
+{
+  DfList_D *list = make_list(101);
+
+  for (size_t i = 0; i < 101; i++)
+  {
+    cr_assert_eq(*(int *)dflist_d_get(list, i).value, (int)i, "Expected %zu at index %zu", i, i);
+  }
+  cr_assert_eq(dflist_d_get(list, 101).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  int a = -1, b = -2;
+  cr_assert_eq(dflist_d_insert_at(list, &a, 10).error, DF_OK);
+  cr_assert_eq(dflist_d_insert_at(list, &b, 95).error, DF_OK);
+  cr_assert_eq(*(int *)dflist_d_get(list, 10).value, -1, "Expected -1 at index 10");
+  cr_assert_eq(*(int *)dflist_d_get(list, 95).value, -2, "Expected -2 at index 95");
+  cr_assert_eq(*(int *)dflist_d_get(list, 96).value, 94, "Expected 94 after the insert");
+
+  cr_assert_eq(*(int *)dflist_d_remove_at(list, 95).value, -2, "Expected -2 removed");
+  cr_assert_eq(*(int *)dflist_d_remove_at(list, 10).value, -1, "Expected -1 removed");
+  cr_assert_eq(dflist_d_insert_at(list, &a, 102).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+  cr_assert_eq((size_t)dflist_d_length(list).value, 101, "Expected 101 elements");
+
+  // Cleanup
+  dflist_d_destroy(list, NULL);
+}
+
+Test(df_list_d_suit, unlinks_through_node_handles)
+{
+  DfList_D *list = dflist_d_create().value;
+  int nums[5] = {0, 1, 2, 3, 4};
+
+  DfList_D_Node *middle = NULL;
+  for (int i = 0; i < 5; i++)
+  {
+    DfList_D_Node *node = dflist_d_push_back(list, &nums[i]).value;
+    if (i == 2)
+    {
+      middle = node;
+    }
+  }
+
+  cr_assert_eq(*(int *)dflist_d_node_element(middle).value, 2, "Expected the handle to hold 2");
+
+  int before = 10, after = 20;
+  dflist_d_insert_before(list, middle, &before);
+  dflist_d_insert_after(list, middle, &after);
+  cr_assert_eq(*(int *)dflist_d_get(list, 2).value, 10, "Expected 10 before the handle");
+  cr_assert_eq(*(int *)dflist_d_get(list, 4).value, 20, "Expected 20 after the handle");
+
+  cr_assert_eq(*(int *)dflist_d_unlink(list, middle).value, 2, "Expected 2 unlinked");
+  cr_assert_eq((size_t)dflist_d_length(list).value, 6, "Expected 6 elements");
+
+  DfList_D_Node *back = dflist_d_push_back(list, &nums[0]).value;
+  dflist_d_unlink(list, back);
+  cr_assert_eq(*(int *)dflist_d_peek_back(list).value, 4, "Expected 4 back at the tail");
+
+  int expected[6] = {0, 1, 10, 20, 3, 4};
+  for (size_t i = 0; i < 6; i++)
+  {
+    cr_assert_eq(*(int *)dflist_d_get(list, i).value, expected[i], "Expected %d at index %zu", expected[i], i);
+  }
+
+  // Cleanup
+  dflist_d_destroy(list, NULL);
+}
+
+Test(df_list_d_iterator_suit, iterates_in_both_directions)
+{
+  DfList_D *list = make_list(100);
+
+  Iterator *it = dflist_d_iterator_create(list).value;
+  int expected = 0;
+  while (it->has_next(it))
+  {
+    cr_assert_eq(*(int *)it->next(it).value, expected, "Expected %d", expected);
+    expected++;
+  }
+  cr_assert_eq(expected, 100, "Expected 100 elements");
+  cr_assert_eq(it->next(it).error, DF_ERR_END_OF_LIST, "Expected DF_ERR_END_OF_LIST");
+
+  Iterator *rev = dflist_d_iterator_create_reverse(list).value;
+  while (rev->has_next(rev))
+  {
+    expected--;
+    cr_assert_eq(*(int *)rev->next(rev).value, expected, "Expected %d", expected);
+  }
+  cr_assert_eq(expected, 0, "Expected the reverse walk to reach the head");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  iterator_destroy(rev);
+  free(rev);
+  dflist_d_destroy(list, NULL);
+}
+
+Test(df_list_d_iterator_suit, works_with_generic_utils)
+{
+  DfList_D *list = make_list(100);
+  Iterator *it = dflist_d_iterator_create_reverse(list).value;
+
+  DfResult filter_res = df_filter(it, is_odd);
+  cr_assert_eq(filter_res.error, DF_OK);
+
+  DfList_D *odds = filter_res.value;
+  cr_assert_eq((size_t)dflist_d_length(odds).value, 50, "Expected 50 odd elements");
+  cr_assert_eq(*(int *)dflist_d_peek_front(odds).value, 99, "Expected 99 first");
+  cr_assert_eq(*(int *)dflist_d_peek_back(odds).value, 1, "Expected 1 last");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dflist_d_destroy(odds, NULL);
+  dflist_d_destroy(list, NULL);
+}
+
+Test(df_list_d_iterator_suit, prefetching_does_not_change_traversals)
+{
+  DfList_D *list = make_list(100);
+  cr_assert_eq(dflist_d_set_prefetch(list, 4, true).error, DF_OK);
+
+  Iterator *it = dflist_d_iterator_create(list).value;
+  Iterator *rev = dflist_d_iterator_create_reverse(list).value;
+  for (int i = 0; i < 100; i++)
+  {
+    cr_assert_eq(*(int *)it->next(it).value, i, "Expected %d going forward", i);
+    cr_assert_eq(*(int *)rev->next(rev).value, 99 - i, "Expected %d going back", 99 - i);
+  }
+  cr_assert_eq(it->has_next(it), 0, "Expected the forward walk to end");
+  cr_assert_eq(rev->has_next(rev), 0, "Expected the reverse walk to end");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  iterator_destroy(rev);
+  free(rev);
+  dflist_d_destroy(list, NULL);
+}
+
+Test(df_list_d_iterator_suit, init_reverse_walks_back_to_front)
+{
+  DfList_D *list = dflist_d_create().value;
+  int values[] = {1, 2, 3};
+  for (int i = 0; i < 3; i++)
+  {
+    dflist_d_push_back(list, &values[i]);
+  }
+
+  Iterator it;
+  cr_assert_eq(dflist_d_iterator_init_reverse(&it, list).error, DF_OK);
+  for (int i = 2; i >= 0; i--)
+  {
+    cr_assert_eq(it.next(&it).value, &values[i]);
+  }
+  cr_assert(!it.has_next(&it));
+
+  iterator_destroy(&it);
+  dflist_d_destroy(list, NULL);
+}
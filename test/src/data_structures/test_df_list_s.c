@@ -0,0 +1,538 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_list_s.h"
+#include "../../../includes/df_slab.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static int values[100];
+
+static bool count_all(void *element)
+{
+  (void)element;
+  return true;
+}
+
+static DfList_S *make_range(DfList_S *list, int from, int to)
+{
+  for (int i = from; i < to; i++)
+  {
+    values[i] = i;
+    dflist_s_push_back(list, &values[i]);
+  }
+  return list;
+}
+
+// Checks length, contents and that tail is the last node by pushing through it
+static void assert_range(DfList_S *list, int from, int to)
+{
+  size_t length = (size_t)dflist_s_length(list).value;
+  cr_assert_eq(length, (size_t)(to - from), "Expected %d elements, got %zu", to - from, length);
+
+  for (int i = from; i < to; i++)
+  {
+    cr_assert_eq(*(int *)dflist_s_get(list, (size_t)(i - from)).value, i, "Expected %d at index %d", i, i - from);
+  }
+
+  if (length > 0)
+  {
+    cr_assert_eq(*(int *)dflist_s_peek_back(list).value, to - 1, "Expected %d at the tail", to - 1);
+  }
+  else
+  {
+    cr_assert_eq(dflist_s_peek_back(list).error, DF_ERR_EMPTY, "Expected no tail");
+  }
+}
+
+Test(df_list_s_relink_suit, concatenates_lists)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 10);
+  DfList_S *other = make_range(dflist_s_create().value, 10, 25);
+  DfList_S *empty = dflist_s_create().value;
+
+  cr_assert_eq(dflist_s_concat(list, other).error, DF_OK);
+  assert_range(list, 0, 25);
+  assert_range(other, 0, 0);
+
+  cr_assert_eq(dflist_s_concat(list, empty).error, DF_OK);
+  cr_assert_eq(dflist_s_concat(empty, list).error, DF_OK);
+  assert_range(empty, 0, 25);
+  assert_range(list, 0, 0);
+
+  // The emptied list is still usable
+  make_range(list, 25, 30);
+  dflist_s_concat(empty, list);
+  assert_range(empty, 0, 30);
+
+  cr_assert_eq(dflist_s_concat(empty, empty).error, DF_ERR_INCOMPATIBLE, "Expected self-concat to be rejected");
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+  dflist_s_destroy(other, NULL);
+  dflist_s_destroy(empty, NULL);
+}
+
+Test(df_list_s_relink_suit, splices_at_positions)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 10);
+  DfList_S *front = dflist_s_create().value;
+  DfList_S *middle = dflist_s_create().value;
+  DfList_S *back = dflist_s_create().value;
+  int nums[3] = {-1, -2, -3};
+
+  dflist_s_push_back(front, &nums[0]);
+  dflist_s_push_back(middle, &nums[1]);
+  dflist_s_push_back(back, &nums[2]);
+
+  cr_assert_eq(dflist_s_splice_at(list, middle, 5).error, DF_OK);
+  cr_assert_eq(dflist_s_splice_at(list, front, 0).error, DF_OK);
+  cr_assert_eq(dflist_s_splice_at(list, back, 12).error, DF_OK);
+  cr_assert_eq(dflist_s_splice_at(list, back, 14).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  int expected[13] = {-1, 0, 1, 2, 3, 4, -2, 5, 6, 7, 8, 9, -3};
+  cr_assert_eq((size_t)dflist_s_length(list).value, 13, "Expected 13 elements");
+  for (size_t i = 0; i < 13; i++)
+  {
+    cr_assert_eq(*(int *)dflist_s_get(list, i).value, expected[i], "Expected %d at index %zu", expected[i], i);
+  }
+  cr_assert_eq(*(int *)dflist_s_peek_back(list).value, -3, "Expected -3 at the tail");
+  assert_range(middle, 0, 0);
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+  dflist_s_destroy(front, NULL);
+  dflist_s_destroy(middle, NULL);
+  dflist_s_destroy(back, NULL);
+}
+
+Test(df_list_s_relink_suit, splits_at_index)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 20);
+
+  DfResult split_res = dflist_s_split_at(list, 12);
+  cr_assert_eq(split_res.error, DF_OK);
+  assert_range(list, 0, 12);
+  assert_range(split_res.value, 12, 20);
+
+  DfResult all_res = dflist_s_split_at(list, 0);
+  assert_range(list, 0, 0);
+  assert_range(all_res.value, 0, 12);
+
+  DfResult none_res = dflist_s_split_at(split_res.value, 8);
+  assert_range(none_res.value, 0, 0);
+  assert_range(split_res.value, 12, 20);
+  cr_assert_eq(dflist_s_split_at(list, 1).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  // Reassemble in the original order
+  dflist_s_concat(all_res.value, split_res.value);
+  assert_range(all_res.value, 0, 20);
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+  dflist_s_destroy(split_res.value, NULL);
+  dflist_s_destroy(all_res.value, NULL);
+  dflist_s_destroy(none_res.value, NULL);
+}
+
+Test(df_list_s_relink_suit, splits_at_iterator)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 20);
+  Iterator *it = dflist_s_iterator_create(list).value;
+
+  // After 7 steps the iterator has returned indices 0 to 6
+  for (int i = 0; i < 7; i++)
+  {
+    it->next(it);
+  }
+
+  DfResult split_res = dflist_s_split_at_iterator(list, it);
+  cr_assert_eq(split_res.error, DF_OK);
+  assert_range(list, 0, 7);
+  assert_range(split_res.value, 7, 20);
+  cr_assert_eq(it->has_next(it), 0, "Expected the iterator to be exhausted");
+
+  Iterator *other_it = dflist_s_iterator_create(split_res.value).value;
+  cr_assert_eq(dflist_s_split_at_iterator(list, other_it).error, DF_ERR_INCOMPATIBLE, "Expected an iterator of another list to be rejected");
+
+  // An iterator that has returned nothing hands over the whole list
+  Iterator fresh;
+  dflist_s_iterator_init(&fresh, split_res.value);
+  DfResult whole_res = dflist_s_split_at_iterator(split_res.value, &fresh);
+  cr_assert_eq(whole_res.error, DF_OK);
+  assert_range(split_res.value, 0, 0);
+  assert_range(whole_res.value, 7, 20);
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  iterator_destroy(other_it);
+  free(other_it);
+  dflist_s_destroy(list, NULL);
+  dflist_s_destroy(split_res.value, NULL);
+  dflist_s_destroy(whole_res.value, NULL);
+}
+
+Test(df_list_s_relink_suit, requires_matching_node_allocators)
+{
+  DfSlab *pool = dflist_s_pool_create(64).value;
+  DfList_S *plain = make_range(dflist_s_create().value, 0, 5);
+  DfList_S *shared_a = make_range(dflist_s_create_pooled(pool).value, 5, 10);
+  DfList_S *shared_b = make_range(dflist_s_create_pooled(pool).value, 10, 15);
+  DfList_S *private = make_range(dflist_s_create_pooled(NULL).value, 15, 20);
+
+  cr_assert_eq(dflist_s_concat(plain, shared_a).error, DF_ERR_INCOMPATIBLE, "Expected malloc and pooled nodes not to mix");
+  cr_assert_eq(dflist_s_splice_at(shared_a, private, 0).error, DF_ERR_INCOMPATIBLE, "Expected different pools not to mix");
+  cr_assert_eq(dflist_s_split_at(private, 2).error, DF_ERR_INCOMPATIBLE, "Expected a private pool to keep its nodes");
+
+  cr_assert_eq(dflist_s_concat(shared_a, shared_b).error, DF_OK, "Expected lists on one pool to concatenate");
+  assert_range(shared_a, 5, 15);
+
+  DfResult split_res = dflist_s_split_at(shared_a, 3);
+  cr_assert_eq(split_res.error, DF_OK);
+  cr_assert_eq(dflist_s_pool(split_res.value).value, pool, "Expected the split list to share the pool");
+  assert_range(split_res.value, 8, 15);
+
+  // Cleanup
+  dflist_s_destroy(split_res.value, NULL);
+  dflist_s_destroy(shared_a, NULL);
+  dflist_s_destroy(shared_b, NULL);
+  dflist_s_destroy(private, NULL);
+  dflist_s_destroy(plain, NULL);
+  dfslab_destroy(pool);
+}
+
+Test(df_list_s_cursor_suit, edits_in_a_single_pass)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 20);
+  DfList_S_Cursor *cursor = dflist_s_cursor_create(list).value;
+  int marker = -1;
+
+  // Drop even numbers and put a marker after each odd one
+  while (!dflist_s_cursor_at_end(cursor))
+  {
+    int value = *(int *)dflist_s_cursor_get(cursor).value;
+    if (value % 2 == 0)
+    {
+      cr_assert_eq(*(int *)dflist_s_cursor_remove(cursor).value, value, "Expected %d removed", value);
+    }
+    else
+    {
+      cr_assert_eq(dflist_s_cursor_insert_after(cursor, &marker).error, DF_OK);
+      dflist_s_cursor_advance(cursor);
+      dflist_s_cursor_advance(cursor);
+    }
+  }
+  cr_assert_eq(dflist_s_cursor_advance(cursor).error, DF_ERR_END_OF_LIST, "Expected DF_ERR_END_OF_LIST");
+
+  cr_assert_eq((size_t)dflist_s_length(list).value, 20, "Expected 10 odd values and 10 markers");
+  for (size_t i = 0; i < 20; i += 2)
+  {
+    cr_assert_eq(*(int *)dflist_s_get(list, i).value, (int)i + 1, "Expected %zu at index %zu", i + 1, i);
+    cr_assert_eq(*(int *)dflist_s_get(list, i + 1).value, -1, "Expected a marker at index %zu", i + 1);
+  }
+  cr_assert_eq(*(int *)dflist_s_peek_back(list).value, -1, "Expected the last marker at the tail");
+
+  // Cleanup
+  dflist_s_cursor_destroy(cursor);
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_list_s_cursor_suit, push_front_on_the_head_moves_the_cursor)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 3);
+  DfList_S_Cursor *cursor = dflist_s_cursor_create(list).value;
+  int extra[2] = {10, 11};
+
+  // Away from the head the cursor keeps its element
+  dflist_s_cursor_advance(cursor);
+  dflist_s_push_front(list, &extra[0]);
+  cr_assert_eq(*(int *)dflist_s_cursor_get(cursor).value, 1, "Expected the cursor to stay on 1");
+
+  // On the head it lands on whatever is pushed in front
+  dflist_s_cursor_reset(cursor);
+  dflist_s_push_front(list, &extra[1]);
+  cr_assert_eq(*(int *)dflist_s_cursor_get(cursor).value, 11, "Expected the cursor on the new head");
+
+  // Cleanup
+  dflist_s_cursor_destroy(cursor);
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_list_s_cursor_suit, keeps_tail_and_length_consistent)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 3);
+  DfList_S_Cursor *cursor = dflist_s_cursor_create(list).value;
+  int extra[3] = {10, 11, 12};
+
+  dflist_s_cursor_advance(cursor);
+  dflist_s_cursor_advance(cursor);
+  cr_assert_eq(*(int *)dflist_s_cursor_remove(cursor).value, 2, "Expected the tail removed");
+  cr_assert_eq(*(int *)dflist_s_peek_back(list).value, 1, "Expected the tail to move back");
+  cr_assert(dflist_s_cursor_at_end(cursor), "Expected the cursor at the end");
+
+  // Inserting at the end appends, and pushes past the cursor become visible to it
+  dflist_s_cursor_insert_before(cursor, &extra[0]);
+  cr_assert_eq(*(int *)dflist_s_peek_back(list).value, 10, "Expected 10 appended");
+  dflist_s_push_back(list, &extra[1]);
+  cr_assert_eq(*(int *)dflist_s_cursor_get(cursor).value, 11, "Expected the cursor to see the push");
+
+  cr_assert_eq(*(int *)dflist_s_cursor_replace(cursor, &extra[2]).value, 11, "Expected 11 replaced");
+  cr_assert_eq(*(int *)dflist_s_peek_back(list).value, 12, "Expected 12 at the tail");
+  cr_assert_eq(dflist_s_cursor_remove_after(cursor).error, DF_ERR_END_OF_LIST, "Expected nothing after the tail");
+
+  dflist_s_cursor_reset(cursor);
+  cr_assert_eq(*(int *)dflist_s_cursor_remove_after(cursor).value, 1, "Expected 1 removed after the head");
+  while (!dflist_s_cursor_at_end(cursor))
+  {
+    dflist_s_cursor_remove(cursor);
+  }
+  cr_assert_eq((size_t)dflist_s_length(list).value, 0, "Expected empty list");
+  cr_assert_eq(dflist_s_peek_back(list).error, DF_ERR_EMPTY, "Expected no tail");
+
+  dflist_s_cursor_insert_before(cursor, &extra[0]);
+  cr_assert_eq(*(int *)dflist_s_peek_front(list).value, 10, "Expected 10 at the head");
+  cr_assert_eq(*(int *)dflist_s_peek_back(list).value, 10, "Expected 10 at the tail");
+
+  // Cleanup
+  dflist_s_cursor_destroy(cursor);
+  dflist_s_destroy(list, NULL);
+}
+
+typedef struct
+{
+  int key;
+  int order;
+} Keyed;
+
+static int cmp_keyed(const void *a, const void *b)
+{
+  int ka = ((const Keyed *)a)->key, kb = ((const Keyed *)b)->key;
+  return (ka > kb) - (ka < kb);
+}
+
+static void assert_sorted_stable(DfList_S *list, size_t expected_length)
+{
+  cr_assert_eq((size_t)dflist_s_length(list).value, expected_length, "Expected %zu elements", expected_length);
+
+  DfList_S_Cursor *cursor = dflist_s_cursor_create(list).value;
+  Keyed *prev = NULL;
+  size_t count = 0;
+  while (!dflist_s_cursor_at_end(cursor))
+  {
+    Keyed *cur = dflist_s_cursor_get(cursor).value;
+    if (prev)
+    {
+      cr_assert_leq(prev->key, cur->key, "Expected keys in order at %zu", count);
+      if (prev->key == cur->key)
+      {
+        cr_assert_lt(prev->order, cur->order, "Expected equal keys to keep their order at %zu", count);
+      }
+    }
+    prev = cur;
+    count++;
+    dflist_s_cursor_advance(cursor);
+  }
+  cr_assert_eq(count, expected_length, "Expected to walk %zu nodes", expected_length);
+  if (prev)
+  {
+    cr_assert_eq(dflist_s_peek_back(list).value, prev, "Expected the tail to be the last node");
+  }
+
+  dflist_s_cursor_destroy(cursor);
+}
+
+Test(df_list_s_sort_suit, sorts_stably)
+{
+  static Keyed items[5000];
+  DfList_S *list = dflist_s_create().value;
+
+  srand(11);
+  for (int i = 0; i < 5000; i++)
+  {
+    items[i] = (Keyed){rand() % 100, i};
+    dflist_s_push_back(list, &items[i]);
+  }
+
+  cr_assert_eq(dflist_s_sort(list, cmp_keyed).error, DF_OK);
+  assert_sorted_stable(list, 5000);
+
+  // Already sorted input stays put
+  cr_assert_eq(dflist_s_sort(list, cmp_keyed).error, DF_OK);
+  assert_sorted_stable(list, 5000);
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_list_s_sort_suit, sorts_small_lists)
+{
+  Keyed items[3] = {{3, 0}, {1, 1}, {2, 2}};
+  DfList_S *list = dflist_s_create().value;
+
+  cr_assert_eq(dflist_s_sort(list, cmp_keyed).error, DF_OK, "Expected an empty list to sort");
+  dflist_s_push_back(list, &items[0]);
+  cr_assert_eq(dflist_s_sort(list, cmp_keyed).error, DF_OK, "Expected one element to sort");
+
+  dflist_s_push_back(list, &items[1]);
+  dflist_s_push_back(list, &items[2]);
+  dflist_s_sort(list, cmp_keyed);
+  assert_sorted_stable(list, 3);
+  cr_assert_eq(dflist_s_peek_front(list).value, &items[1], "Expected key 1 first");
+  cr_assert_eq(dflist_s_sort(list, NULL).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR");
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_list_s_sort_suit, merges_sorted_lists)
+{
+  static Keyed items[300];
+  DfList_S *list = dflist_s_create().value;
+  DfList_S *other = dflist_s_create().value;
+
+  // Orders follow the key within each list, and list's ties come first
+  for (int i = 0; i < 150; i++)
+  {
+    items[i] = (Keyed){i * 2 % 200, i};
+    items[150 + i] = (Keyed){i * 3 % 250, 150 + i};
+  }
+  for (int i = 0; i < 150; i++)
+  {
+    dflist_s_push_back(list, &items[i]);
+    dflist_s_push_back(other, &items[150 + i]);
+  }
+  dflist_s_sort(list, cmp_keyed);
+  dflist_s_sort(other, cmp_keyed);
+
+  cr_assert_eq(dflist_s_merge(list, other, cmp_keyed).error, DF_OK);
+  assert_sorted_stable(list, 300);
+  cr_assert_eq((size_t)dflist_s_length(other).value, 0, "Expected other to be emptied");
+
+  // A list that sorts entirely after is appended
+  Keyed late = {1000, 1000};
+  dflist_s_push_back(other, &late);
+  dflist_s_merge(list, other, cmp_keyed);
+  cr_assert_eq(dflist_s_peek_back(list).value, &late, "Expected the late element at the tail");
+
+  DfList_S *pooled = dflist_s_create_pooled(NULL).value;
+  cr_assert_eq(dflist_s_merge(list, pooled, cmp_keyed).error, DF_ERR_INCOMPATIBLE, "Expected DF_ERR_INCOMPATIBLE");
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+  dflist_s_destroy(other, NULL);
+  dflist_s_destroy(pooled, NULL);
+}
+
+static int cleanup_calls;
+
+static void count_cleanup(void *element)
+{
+  (void)element;
+  cleanup_calls++;
+}
+
+// Collects what an iterator hands out, so walks with and without prefetching can be compared
+static size_t collect(DfList_S *list, int **out)
+{
+  Iterator *it = dflist_s_iterator_create(list).value;
+  size_t count = 0;
+  while (it->has_next(it))
+  {
+    out[count++] = it->next(it).value;
+  }
+  iterator_destroy(it);
+  free(it);
+  return count;
+}
+
+Test(df_list_s_prefetch_suit, prefetching_does_not_change_traversals)
+{
+  size_t distances[] = {1, 3, DFLIST_PREFETCH_DEFAULT_DISTANCE, 1000};
+  int *plain[50], *prefetched[50];
+
+  for (size_t d = 0; d < sizeof(distances) / sizeof(distances[0]); d++)
+  {
+    DfList_S *list = make_range(dflist_s_create().value, 0, 50);
+    size_t plain_count = collect(list, plain);
+
+    cr_assert_eq(dflist_s_set_prefetch(list, distances[d], d % 2 == 0).error, DF_OK);
+    size_t prefetched_count = collect(list, prefetched);
+
+    cr_assert_eq(prefetched_count, plain_count, "Expected the same walk length with distance %zu", distances[d]);
+    cr_assert_eq(memcmp(plain, prefetched, plain_count * sizeof(int *)), 0, "Expected the same elements with distance %zu", distances[d]);
+
+    cleanup_calls = 0;
+    dflist_s_destroy(list, count_cleanup);
+    cr_assert_eq(cleanup_calls, 50, "Expected cleanup on every element with distance %zu", distances[d]);
+  }
+
+  cr_assert_eq(dflist_s_set_prefetch(NULL, 4, true).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR");
+}
+
+Test(df_list_s_iterator_suit, next_batch_matches_next)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 100);
+  Iterator *single = dflist_s_iterator_create(list).value;
+  Iterator *batched = dflist_s_iterator_create(list).value;
+  DfSpan span;
+
+  // Small batches so the walk takes several gathers
+  do
+  {
+    cr_assert_eq(batched->next_batch(batched, &span, 7).error, DF_OK);
+    cr_assert_leq(span.count, 7);
+    for (size_t i = 0; i < span.count; i++)
+    {
+      cr_assert_eq(df_span_at(&span, i), single->next(single).value);
+    }
+  } while (span.count > 0);
+
+  cr_assert(!single->has_next(single));
+  cr_assert(!batched->has_next(batched));
+
+  iterator_destroy(single);
+  free(single);
+  iterator_destroy(batched);
+  free(batched);
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_list_s_iterator_suit, yields_the_head)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 100);
+  Iterator it;
+  dflist_s_iterator_init(&it, list);
+
+  cr_assert_eq(*(int *)it.next(&it).value, 0, "Expected the first element to be the head");
+
+  dflist_s_iterator_init(&it, list);
+  DfResult count_res = df_count(&it, count_all);
+  cr_assert_eq(count_res.error, DF_OK);
+  cr_assert_eq((size_t)count_res.value, 100, "Expected df_count to see all 100 elements");
+
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_list_s_iterator_suit, init_matches_heap_iterator)
+{
+  DfList_S *list = make_range(dflist_s_create().value, 0, 20);
+  Iterator *heap = dflist_s_iterator_create(list).value;
+  Iterator stack;
+  cr_assert_eq(dflist_s_iterator_init(&stack, list).error, DF_OK);
+
+  while (heap->has_next(heap))
+  {
+    cr_assert(stack.has_next(&stack));
+    cr_assert_eq(stack.next(&stack).value, heap->next(heap).value);
+  }
+  cr_assert(!stack.has_next(&stack));
+
+  iterator_destroy(&stack);
+  iterator_free(heap);
+  dflist_s_destroy(list, NULL);
+}
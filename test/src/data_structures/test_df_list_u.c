@@ -0,0 +1,196 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_list_u.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static int values[5000];
+
+static DfList_U *make_list(size_t n)
+{
+  DfList_U *list = dflist_u_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    values[i] = (int)i;
+    dflist_u_push_back(list, &values[i]);
+  }
+  return list;
+}
+
+static bool is_even(void *element)
+{
+  return *(int *)element % 2 == 0;
+}
+
+Test(df_list_u_suit, creates_empty_list)
+{
+  DfResult res = dflist_u_create();
+
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq((size_t)dflist_u_length(res.value).value, 0, "Expected empty list");
+  cr_assert_eq(dflist_u_pop_front(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dflist_u_peek_back(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+
+  // Cleanup
+  dflist_u_destroy(res.value, NULL);
+}
+
+Test(df_list_u_suit, packs_elements_into_nodes)
+{
+  DfList_U *list = make_list(1000);
+
+  size_t nodes = (size_t)dflist_u_node_count(list).value;
+  cr_assert_eq(nodes, (1000 + DFLIST_U_NODE_CAPACITY - 1) / DFLIST_U_NODE_CAPACITY, "Expected full nodes, got %zu", nodes);
+
+  for (size_t i = 0; i < 1000; i += 37)
+  {
+    cr_assert_eq(*(int *)dflist_u_get(list, i).value, (int)i, "Expected %zu at index %zu", i, i);
+  }
+  cr_assert_eq(*(int *)dflist_u_peek_front(list).value, 0, "Expected 0 at the front");
+  cr_assert_eq(*(int *)dflist_u_peek_back(list).value, 999, "Expected 999 at the back");
+  cr_assert_eq(dflist_u_get(list, 1000).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  // Cleanup
+  dflist_u_destroy(list, NULL);
+}
+
+Test(df_list_u_suit, matches_reference_under_random_edits)
+{
+  DfList_U *list = dflist_u_create().value;
+  int *reference[5000];
+  size_t length = 0;
+
+  srand(42);
+  for (int step = 0; step < 20000; step++)
+  {
+    int op = rand() % 6;
+    if (length == 0 || op < 2)
+    {
+      size_t index = (size_t)rand() % (length + 1);
+      int *element = &values[step % 5000];
+      cr_assert_eq(dflist_u_insert_at(list, element, index).error, DF_OK);
+      memmove(reference + index + 1, reference + index, (length - index) * sizeof(int *));
+      reference[index] = element;
+      length++;
+    }
+    else if (op < 4 || length >= 4000)
+    {
+      size_t index = (size_t)rand() % length;
+      cr_assert_eq(dflist_u_remove_at(list, index).value, reference[index], "Expected removed element to match at step %d", step);
+      memmove(reference + index, reference + index + 1, (length - index - 1) * sizeof(int *));
+      length--;
+    }
+    else if (op == 4)
+    {
+      cr_assert_eq(dflist_u_pop_back(list).value, reference[--length], "Expected pop_back to match at step %d", step);
+    }
+    else
+    {
+      dflist_u_push_front(list, &values[0]);
+      memmove(reference + 1, reference, length * sizeof(int *));
+      reference[0] = &values[0];
+      length++;
+    }
+  }
+
+  cr_assert_eq((size_t)dflist_u_length(list).value, length, "Expected lengths to match");
+  for (size_t i = 0; i < length; i++)
+  {
+    cr_assert_eq(dflist_u_get(list, i).value, reference[i], "Expected element %zu to match", i);
+  }
+
+  // Removals merge nodes, so the list never degrades to one element per node
+  size_t nodes = (size_t)dflist_u_node_count(list).value;
+  cr_assert_leq(nodes, 2 * length / (DFLIST_U_NODE_CAPACITY / 2) + 2, "Expected merged nodes, got %zu for %zu elements", nodes, length);
+
+  // Cleanup
+  dflist_u_destroy(list, NULL);
+}
+
+Test(df_list_u_suit, drains_from_both_ends)
+{
+  DfList_U *list = make_list(100);
+
+  for (int i = 0; i < 50; i++)
+  {
+    cr_assert_eq(*(int *)dflist_u_pop_front(list).value, i, "Expected %d from the front", i);
+    cr_assert_eq(*(int *)dflist_u_pop_back(list).value, 99 - i, "Expected %d from the back", 99 - i);
+  }
+  cr_assert_eq((size_t)dflist_u_node_count(list).value, 0, "Expected all nodes to be freed");
+
+  // Cleanup
+  dflist_u_destroy(list, NULL);
+}
+
+Test(df_list_u_iterator_suit, iterates_every_element_in_order)
+{
+  DfList_U *list = make_list(100);
+  Iterator *it = dflist_u_iterator_create(list).value;
+
+  int expected = 0;
+  while (it->has_next(it))
+  {
+    DfResult next_res = it->next(it);
+    cr_assert_eq(next_res.error, DF_OK);
+    cr_assert_eq(*(int *)next_res.value, expected, "Expected %d", expected);
+    expected++;
+  }
+  cr_assert_eq(expected, 100, "Expected 100 elements");
+  cr_assert_eq(it->next(it).error, DF_ERR_END_OF_LIST, "Expected DF_ERR_END_OF_LIST");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dflist_u_destroy(list, NULL);
+}
+
+Test(df_list_u_iterator_suit, works_with_generic_utils)
+{
+  DfList_U *list = make_list(100);
+  Iterator *it = dflist_u_iterator_create(list).value;
+
+  DfResult filter_res = df_filter(it, is_even);
+  cr_assert_eq(filter_res.error, DF_OK);
+
+  DfList_U *evens = filter_res.value;
+  cr_assert_eq((size_t)dflist_u_length(evens).value, 50, "Expected 50 even elements");
+  cr_assert_eq(*(int *)dflist_u_get(evens, 49).value, 98, "Expected 98 last");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dflist_u_destroy(evens, NULL);
+  dflist_u_destroy(list, NULL);
+}
+
+Test(df_list_u_suit, next_batch_hands_out_node_arrays)
+{
+  DfList_U *list = make_list(DFLIST_U_NODE_CAPACITY + 5);
+  Iterator *it = dflist_u_iterator_create(list).value;
+  DfSpan span;
+  int expected = 0;
+  size_t batches = 0;
+
+  do
+  {
+    cr_assert_eq(it->next_batch(it, &span, DF_ITERATOR_BATCH).error, DF_OK);
+    cr_assert_leq(span.count, DFLIST_U_NODE_CAPACITY, "Expected spans not to cross nodes");
+    for (size_t i = 0; i < span.count; i++)
+    {
+      cr_assert_eq(*(int *)df_span_at(&span, i), expected++);
+    }
+    batches += span.count > 0;
+  } while (span.count > 0);
+
+  cr_assert_eq(expected, DFLIST_U_NODE_CAPACITY + 5);
+  cr_assert_geq(batches, 2);
+
+  iterator_destroy(it);
+  free(it);
+  dflist_u_destroy(list, NULL);
+}
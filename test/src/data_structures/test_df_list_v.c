@@ -0,0 +1,187 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_list_v.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+#include "../../../internal/df_internal.h"
+
+typedef struct
+{
+  double x;
+  double y;
+  char name[24];
+} Point;
+
+// Helper functions
+static DfList_V *make_ints(int n)
+{
+  DfList_V *list = dflist_v_create(sizeof(int)).value;
+  for (int i = 0; i < n; i++)
+  {
+    dflist_v_push_back(list, &i);
+  }
+  return list;
+}
+
+static bool is_odd(void *element)
+{
+  return *(int *)element % 2 != 0;
+}
+
+static void sum_int(void *acc, void *elem)
+{
+  *(int *)acc += *(int *)elem;
+}
+
+Test(df_list_v_suit, copies_values_in)
+{
+  DfList_V *list = dflist_v_create(sizeof(Point)).value;
+  Point p = {1.5, -2.0, "origin"};
+
+  cr_assert_eq(dflist_v_push_back(list, &p).error, DF_OK);
+
+  // Changing the caller's copy does not reach the stored value
+  p.x = 99.0;
+  strcpy(p.name, "moved");
+  dflist_v_push_front(list, &p);
+
+  Point *stored = dflist_v_get(list, 1).value;
+  cr_assert_eq(stored->x, 1.5, "Expected the stored copy to keep x");
+  cr_assert_eq(strcmp(stored->name, "origin"), 0, "Expected the stored copy to keep its name");
+  cr_assert_eq((uintptr_t)stored % _Alignof(max_align_t), 0, "Expected the payload to be aligned");
+  cr_assert_eq(((Point *)dflist_v_peek_front(list).value)->x, 99.0, "Expected the second copy at the front");
+  cr_assert_eq((size_t)dflist_v_elem_size(list).value, sizeof(Point), "Element size mismatch");
+
+  cr_assert_eq(dflist_v_create(0).error, DF_ERR_OUT_OF_RANGE, "Expected zero-sized elements to be rejected");
+
+  // Cleanup
+  dflist_v_destroy(list);
+}
+
+Test(df_list_v_suit, pops_and_removes_by_copy)
+{
+  DfList_V *list = make_ints(10);
+  int out = -1;
+
+  cr_assert_eq(dflist_v_pop_front_into(list, &out).error, DF_OK);
+  cr_assert_eq(out, 0, "Expected 0 from the front");
+  cr_assert_eq(dflist_v_pop_back_into(list, &out).error, DF_OK);
+  cr_assert_eq(out, 9, "Expected 9 from the back");
+  cr_assert_eq(*(int *)dflist_v_peek_back(list).value, 8, "Expected 8 at the tail");
+
+  int *copy = dflist_v_pop_front(list).value;
+  cr_assert_eq(*copy, 1, "Expected a heap copy of 1");
+  free(copy);
+
+  cr_assert_eq(dflist_v_remove_at(list, 3, &out).error, DF_OK);
+  cr_assert_eq(out, 5, "Expected 5 removed");
+  cr_assert_eq(dflist_v_remove_at(list, 5, NULL).error, DF_OK, "Expected removal without a destination");
+  cr_assert_eq(*(int *)dflist_v_peek_back(list).value, 7, "Expected the tail to move back");
+  cr_assert_eq(dflist_v_remove_at(list, 5, NULL).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  int expected[5] = {2, 3, 4, 6, 7};
+  cr_assert_eq((size_t)dflist_v_length(list).value, 5, "Expected 5 elements");
+  for (size_t i = 0; i < 5; i++)
+  {
+    cr_assert_eq(*(int *)dflist_v_get(list, i).value, expected[i], "Expected %d at index %zu", expected[i], i);
+  }
+
+  while (dflist_v_pop_back_into(list, &out).error == DF_OK)
+  {
+  }
+  cr_assert_eq(dflist_v_peek_front(list).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dflist_v_pop_front(list).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+
+  // Cleanup
+  dflist_v_destroy(list);
+}
+
+Test(df_list_v_suit, inserts_and_sets_in_place)
+{
+  DfList_V *list = make_ints(5);
+  int value = 42;
+
+  cr_assert_eq(dflist_v_insert_at(list, &value, 2).error, DF_OK);
+  cr_assert_eq(dflist_v_insert_at(list, &value, 6).error, DF_OK);
+  cr_assert_eq(dflist_v_insert_at(list, &value, 8).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  value = -7;
+  cr_assert_eq(dflist_v_set(list, 0, &value).error, DF_OK);
+
+  int expected[7] = {-7, 1, 42, 2, 3, 4, 42};
+  for (size_t i = 0; i < 7; i++)
+  {
+    cr_assert_eq(*(int *)dflist_v_get(list, i).value, expected[i], "Expected %d at index %zu", expected[i], i);
+  }
+
+  // Writing through a borrowed pointer edits the stored value
+  *(int *)dflist_v_peek_back(list).value = 100;
+  cr_assert_eq(*(int *)dflist_v_get(list, 6).value, 100, "Expected the edit to stick");
+
+  // Cleanup
+  dflist_v_destroy(list);
+}
+
+Test(df_list_v_iterator_suit, works_with_generic_utils)
+{
+  DfList_V *list = make_ints(10);
+
+  Iterator *it = dflist_v_iterator_create(list).value;
+  cr_assert_eq(dflist_v_iterator_elem_size(it), sizeof(int), "Element size mismatch");
+  DfResult filter_res = df_filter(it, is_odd);
+  cr_assert_eq(filter_res.error, DF_OK);
+  DfList_V *odd = filter_res.value;
+  cr_assert_eq((size_t)dflist_v_length(odd).value, 5, "Expected 5 odd values");
+  iterator_destroy(it);
+  free(it);
+
+  it = dflist_v_iterator_create(odd).value;
+  int initial = 0;
+  DfResult reduce_res = df_reduce(it, &initial, sum_int);
+  cr_assert_eq(*(int *)reduce_res.value, 25, "Expected 1 + 3 + 5 + 7 + 9");
+  free(reduce_res.value);
+  iterator_destroy(it);
+  free(it);
+
+  it = dflist_v_iterator_create(list).value;
+  cr_assert_eq(dflist_v_free_all(it).error, DF_OK);
+  cr_assert_eq((size_t)dflist_v_length(list).value, 0, "Expected the list to be emptied");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dflist_v_destroy(list);
+  dflist_v_destroy(odd);
+}
+
+Test(df_list_v_iterator_suit, prefetching_does_not_change_traversals)
+{
+  size_t distances[] = {1, 4, 500};
+
+  for (size_t d = 0; d < sizeof(distances) / sizeof(distances[0]); d++)
+  {
+    DfList_V *list = make_ints(100);
+    cr_assert_eq(dflist_v_set_prefetch(list, distances[d], d % 2 == 0).error, DF_OK);
+
+    Iterator it;
+    dflist_v_iterator_init(&it, list);
+    for (int i = 0; i < 100; i++)
+    {
+      cr_assert_eq(*(int *)it.next(&it).value, i, "Expected %d with distance %zu", i, distances[d]);
+    }
+    cr_assert_eq(it.has_next(&it), 0, "Expected the walk to end with distance %zu", distances[d]);
+
+    dflist_v_iterator_init(&it, list);
+    cr_assert_eq((size_t)df_count(&it, is_odd).value, 50, "Expected batches to see every element with distance %zu", distances[d]);
+
+    // Cleanup
+    dflist_v_destroy(list);
+  }
+
+  cr_assert_eq(dflist_v_set_prefetch(NULL, 4, true).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR");
+}
@@ -0,0 +1,196 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "../../../includes/df_pool.h"
+#include "../../../includes/df_common.h"
+
+// Helper functions
+#define TEST_RANGE 100000
+
+static atomic_int covered[TEST_RANGE];
+static atomic_int ran;
+
+static void count_task(void *arg)
+{
+  (void)arg;
+  atomic_fetch_add(&ran, 1);
+}
+
+static void mark_range(size_t begin, size_t end, void *arg)
+{
+  (void)arg;
+  for (size_t i = begin; i < end; i++)
+  {
+    atomic_fetch_add(&covered[i], 1);
+  }
+}
+
+static void reset_covered()
+{
+  for (size_t i = 0; i < TEST_RANGE; i++)
+  {
+    atomic_store(&covered[i], 0);
+  }
+}
+
+typedef struct Nested
+{
+  DfPool *pool;
+  size_t rows;
+} Nested;
+
+// Each outer index runs its own parallel_for from inside a worker
+static void outer_rows(size_t begin, size_t end, void *arg)
+{
+  Nested *nested = (Nested *)arg;
+  for (size_t row = begin; row < end; row++)
+  {
+    size_t width = TEST_RANGE / nested->rows;
+    dfpool_parallel_for(nested->pool, row * width, (row + 1) * width, 64, mark_range, NULL);
+  }
+}
+
+typedef struct Spawner
+{
+  DfPool *pool;
+  DfWait_Group *group;
+} Spawner;
+
+// Submits more work from a worker, then waits on it without blocking the worker
+static void spawn_children(void *arg)
+{
+  Spawner *spawner = (Spawner *)arg;
+  DfWait_Group *children = dfwaitgroup_create().value;
+
+  for (int i = 0; i < 50; i++)
+  {
+    dfpool_submit(spawner->pool, count_task, NULL, children);
+  }
+  dfwaitgroup_wait(children);
+  dfwaitgroup_destroy(children);
+}
+
+Test(df_pool_suit, runs_every_submitted_task)
+{
+  DfPool *pool = dfpool_create(4).value;
+  DfWait_Group *group = dfwaitgroup_create().value;
+  atomic_store(&ran, 0);
+
+  for (int i = 0; i < 10000; i++)
+  {
+    cr_assert_eq(dfpool_submit(pool, count_task, NULL, group).error, DF_OK);
+  }
+  cr_assert_eq(dfwaitgroup_wait(group).error, DF_OK);
+  cr_assert_eq(atomic_load(&ran), 10000, "Expected all 10000 tasks to have run");
+
+  DfPool_Stats stats;
+  cr_assert_eq(dfpool_stats(pool, &stats).error, DF_OK);
+  cr_assert_eq(stats.workers, 4);
+  cr_assert_eq(stats.submitted, 10000);
+  cr_assert_eq(stats.executed, 10000);
+
+  // Cleanup
+  dfwaitgroup_destroy(group);
+  dfpool_destroy(pool);
+}
+
+Test(df_pool_suit, parallel_for_covers_the_range_once)
+{
+  DfPool *pool = dfpool_create(4).value;
+  size_t grains[] = {0, 1, 7, 1000, TEST_RANGE * 2};
+
+  for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++)
+  {
+    reset_covered();
+    cr_assert_eq(dfpool_parallel_for(pool, 3, TEST_RANGE, grains[g], mark_range, NULL).error, DF_OK);
+    for (size_t i = 0; i < TEST_RANGE; i++)
+    {
+      cr_assert_eq(atomic_load(&covered[i]), i >= 3 ? 1 : 0, "Grain %zu: index %zu covered %d times", grains[g], i, atomic_load(&covered[i]));
+    }
+  }
+
+  // An empty range has nothing to run
+  cr_assert_eq(dfpool_parallel_for(pool, 5, 5, 0, mark_range, NULL).error, DF_OK);
+
+  // Cleanup
+  dfpool_destroy(pool);
+}
+
+Test(df_pool_suit, nested_parallel_for_and_waits_do_not_deadlock)
+{
+  DfPool *pool = dfpool_create(2).value;
+  Nested nested = {pool, 100};
+
+  reset_covered();
+  dfpool_parallel_for(pool, 0, nested.rows, 1, outer_rows, &nested);
+  for (size_t i = 0; i < TEST_RANGE; i++)
+  {
+    cr_assert_eq(atomic_load(&covered[i]), 1, "Index %zu covered %d times", i, atomic_load(&covered[i]));
+  }
+
+  // Every worker blocks in a wait of its own while the children are still queued
+  DfWait_Group *group = dfwaitgroup_create().value;
+  Spawner spawner = {pool, group};
+  atomic_store(&ran, 0);
+  for (int i = 0; i < 8; i++)
+  {
+    dfpool_submit(pool, spawn_children, &spawner, group);
+  }
+  dfwaitgroup_wait(group);
+  cr_assert_eq(atomic_load(&ran), 400, "Expected every child task to have run");
+
+  DfPool_Stats stats;
+  dfpool_stats(pool, &stats);
+  cr_assert_eq(stats.submitted, stats.executed, "Expected no task left behind");
+
+  // Cleanup
+  dfwaitgroup_destroy(group);
+  dfpool_destroy(pool);
+}
+
+Test(df_pool_suit, destroy_runs_pending_tasks)
+{
+  DfPool *pool = dfpool_create(1).value;
+  atomic_store(&ran, 0);
+
+  for (int i = 0; i < 1000; i++)
+  {
+    dfpool_submit(pool, count_task, NULL, NULL);
+  }
+  cr_assert_eq(dfpool_destroy(pool).error, DF_OK);
+  cr_assert_eq(atomic_load(&ran), 1000, "Expected destroy to run the queued tasks first");
+}
+
+Test(df_pool_suit, wait_group_counts_down)
+{
+  DfWait_Group *group = dfwaitgroup_create().value;
+
+  cr_assert_eq(dfwaitgroup_wait(group).error, DF_OK, "Expected an idle group not to block");
+  cr_assert_eq(dfwaitgroup_add(group, 2).error, DF_OK);
+  cr_assert_eq(dfwaitgroup_done(group).error, DF_OK);
+  cr_assert_eq(dfwaitgroup_done(group).error, DF_OK);
+  cr_assert_eq(dfwaitgroup_done(group).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY below zero");
+  cr_assert_eq(dfwaitgroup_wait(group).error, DF_OK);
+
+  // Cleanup
+  dfwaitgroup_destroy(group);
+}
+
+Test(df_pool_suit, rejects_bad_arguments)
+{
+  DfPool *pool = dfpool_create(1).value;
+  DfPool_Stats stats;
+
+  cr_assert_eq(dfpool_submit(NULL, count_task, NULL, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfpool_submit(pool, NULL, NULL, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfpool_parallel_for(pool, 0, 10, 1, NULL, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfpool_stats(pool, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfpool_stats(NULL, &stats).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfpool_destroy(NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(dfwaitgroup_wait(NULL).error, DF_ERR_NULL_PTR);
+
+  // Cleanup
+  dfpool_destroy(pool);
+}
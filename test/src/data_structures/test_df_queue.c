@@ -0,0 +1,183 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_queue.h"
+#include "../../../includes/df_common.h"
+
+// Helper functions
+#define TEST_THREADS 4
+#define TEST_PER_PRODUCER 20000
+
+static int values[TEST_THREADS * TEST_PER_PRODUCER];
+static atomic_int seen[TEST_THREADS * TEST_PER_PRODUCER];
+static atomic_int consumed;
+
+typedef struct
+{
+  DfQueue *queue;
+  size_t id;
+} Worker;
+
+static void *produce(void *arg)
+{
+  Worker *worker = arg;
+  for (size_t i = 0; i < TEST_PER_PRODUCER; i++)
+  {
+    int *element = &values[worker->id * TEST_PER_PRODUCER + i];
+    while (dfqueue_push(worker->queue, element).error == DF_ERR_FULL)
+    {
+    }
+  }
+  return NULL;
+}
+
+static void *consume(void *arg)
+{
+  Worker *worker = arg;
+  int last[TEST_THREADS];
+  for (size_t i = 0; i < TEST_THREADS; i++)
+  {
+    last[i] = -1;
+  }
+
+  while (atomic_load(&consumed) < TEST_THREADS * TEST_PER_PRODUCER)
+  {
+    DfResult res = dfqueue_pop(worker->queue);
+    if (res.error)
+    {
+      continue;
+    }
+
+    int value = *(int *)res.value;
+    atomic_fetch_add(&seen[value], 1);
+    atomic_fetch_add(&consumed, 1);
+
+    // Elements from one producer must come out in the order they went in
+    int producer = value / TEST_PER_PRODUCER;
+    if (value <= last[producer])
+    {
+      atomic_fetch_add(&seen[value], 100);
+    }
+    last[producer] = value;
+  }
+  return NULL;
+}
+
+static void run_producers_and_consumers(size_t capacity)
+{
+  DfQueue *queue = dfqueue_create(capacity).value;
+  pthread_t producers[TEST_THREADS], consumers[TEST_THREADS];
+  Worker workers[TEST_THREADS];
+
+  for (size_t i = 0; i < TEST_THREADS * TEST_PER_PRODUCER; i++)
+  {
+    values[i] = (int)i;
+    atomic_store(&seen[i], 0);
+  }
+  atomic_store(&consumed, 0);
+
+  for (size_t i = 0; i < TEST_THREADS; i++)
+  {
+    workers[i] = (Worker){queue, i};
+    pthread_create(&consumers[i], NULL, consume, &workers[i]);
+    pthread_create(&producers[i], NULL, produce, &workers[i]);
+  }
+  for (size_t i = 0; i < TEST_THREADS; i++)
+  {
+    pthread_join(producers[i], NULL);
+    pthread_join(consumers[i], NULL);
+  }
+
+  for (size_t i = 0; i < TEST_THREADS * TEST_PER_PRODUCER; i++)
+  {
+    cr_assert_eq(atomic_load(&seen[i]), 1, "Expected element %zu exactly once and in order", i);
+  }
+  cr_assert_eq((size_t)dfqueue_length(queue).value, 0, "Expected the queue to be drained");
+  cr_assert_eq(dfqueue_pop(queue).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+
+  // Cleanup
+  dfqueue_destroy(queue, NULL);
+}
+
+Test(df_queue_suit, pops_in_fifo_order)
+{
+  DfQueue *queue = dfqueue_create(0).value;
+  int nums[1000];
+
+  cr_assert_eq(dfqueue_pop(queue).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+
+  for (int i = 0; i < 1000; i++)
+  {
+    nums[i] = i;
+    cr_assert_eq(dfqueue_push(queue, &nums[i]).error, DF_OK);
+  }
+  cr_assert_eq((size_t)dfqueue_length(queue).value, 1000, "Expected 1000 elements");
+
+  for (int i = 0; i < 1000; i++)
+  {
+    cr_assert_eq(*(int *)dfqueue_pop(queue).value, i, "Expected %d", i);
+  }
+  cr_assert_eq(dfqueue_pop(queue).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dfqueue_push(queue, NULL).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR");
+
+  // Cleanup
+  dfqueue_destroy(queue, NULL);
+}
+
+Test(df_queue_suit, rejects_pushes_when_bounded_queue_is_full)
+{
+  DfQueue *queue = dfqueue_create(3).value;
+  int nums[4] = {0, 1, 2, 3};
+
+  cr_assert_eq((size_t)dfqueue_capacity(queue).value, 3, "Expected capacity 3");
+  for (int i = 0; i < 3; i++)
+  {
+    cr_assert_eq(dfqueue_push(queue, &nums[i]).error, DF_OK);
+  }
+  cr_assert_eq(dfqueue_push(queue, &nums[3]).error, DF_ERR_FULL, "Expected DF_ERR_FULL");
+  cr_assert_eq((size_t)dfqueue_length(queue).value, 3, "Expected the failed push not to count");
+
+  cr_assert_eq(*(int *)dfqueue_pop(queue).value, 0, "Expected 0");
+  cr_assert_eq(dfqueue_push(queue, &nums[3]).error, DF_OK, "Expected room after a pop");
+
+  // Cleanup
+  dfqueue_destroy(queue, NULL);
+}
+
+static int cleaned;
+
+static void count_cleanup(void *element)
+{
+  (void)element;
+  cleaned++;
+}
+
+Test(df_queue_suit, destroy_cleans_up_remaining_elements)
+{
+  DfQueue *queue = dfqueue_create(0).value;
+  int nums[5] = {0};
+
+  for (int i = 0; i < 5; i++)
+  {
+    dfqueue_push(queue, &nums[i]);
+  }
+  dfqueue_pop(queue);
+
+  cleaned = 0;
+  dfqueue_destroy(queue, count_cleanup);
+  cr_assert_eq(cleaned, 4, "Expected cleanup on the 4 remaining elements");
+}
+
+Test(df_queue_suit, delivers_every_element_once_across_threads)
+{
+  run_producers_and_consumers(0);
+}
+
+Test(df_queue_suit, delivers_every_element_once_when_bounded)
+{
+  run_producers_and_consumers(64);
+}
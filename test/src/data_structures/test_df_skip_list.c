@@ -0,0 +1,198 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_skip_list.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static int values[5000];
+
+static DfSkipList *make_list(size_t n)
+{
+  DfSkipList *list = dfskiplist_create().value;
+  for (size_t i = 0; i < n; i++)
+  {
+    values[i] = (int)i;
+    dfskiplist_push_back(list, &values[i]);
+  }
+  return list;
+}
+
+static bool is_even(void *element)
+{
+  return *(int *)element % 2 == 0;
+}
+
+Test(df_skip_list_suit, creates_empty_list)
+{
+  DfResult res = dfskiplist_create();
+
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq((size_t)dfskiplist_length(res.value).value, 0, "Expected empty list");
+  cr_assert_eq(dfskiplist_pop_front(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dfskiplist_pop_back(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dfskiplist_peek_back(res.value).error, DF_ERR_EMPTY, "Expected DF_ERR_EMPTY");
+  cr_assert_eq(dfskiplist_get(res.value, 0).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  // Cleanup
+  dfskiplist_destroy(res.value, NULL);
+}
+
+Test(df_skip_list_suit, indexes_every_position)
+{
+  DfSkipList *list = make_list(5000);
+
+  for (size_t i = 0; i < 5000; i++)
+  {
+    cr_assert_eq(*(int *)dfskiplist_get(list, i).value, (int)i, "Expected %zu at index %zu", i, i);
+  }
+  cr_assert_eq(*(int *)dfskiplist_peek_front(list).value, 0, "Expected 0 at the front");
+  cr_assert_eq(*(int *)dfskiplist_peek_back(list).value, 4999, "Expected 4999 at the back");
+  cr_assert_eq(dfskiplist_get(list, 5000).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+  cr_assert_eq(dfskiplist_insert_at(list, &values[0], 5001).error, DF_ERR_INDEX_OUT_OF_BOUNDS);
+
+  // Cleanup
+  dfskiplist_destroy(list, NULL);
+}
+
+Test(df_skip_list_suit, matches_reference_under_random_edits)
+{
+  DfSkipList *list = dfskiplist_create().value;
+  int *reference[5000];
+  size_t length = 0;
+
+  srand(7);
+  for (int step = 0; step < 20000; step++)
+  {
+    int op = rand() % 6;
+    if (length == 0 || op < 2)
+    {
+      size_t index = (size_t)rand() % (length + 1);
+      int *element = &values[step % 5000];
+      cr_assert_eq(dfskiplist_insert_at(list, element, index).error, DF_OK);
+      memmove(reference + index + 1, reference + index, (length - index) * sizeof(int *));
+      reference[index] = element;
+      length++;
+    }
+    else if (op < 4 || length >= 4000)
+    {
+      size_t index = (size_t)rand() % length;
+      cr_assert_eq(dfskiplist_remove_at(list, index).value, reference[index], "Expected removed element to match at step %d", step);
+      memmove(reference + index, reference + index + 1, (length - index - 1) * sizeof(int *));
+      length--;
+    }
+    else if (op == 4)
+    {
+      cr_assert_eq(dfskiplist_pop_back(list).value, reference[--length], "Expected pop_back to match at step %d", step);
+    }
+    else
+    {
+      size_t index = (size_t)rand() % length;
+      cr_assert_eq(dfskiplist_get(list, index).value, reference[index], "Expected get to match at step %d", step);
+    }
+
+    if (length > 0)
+    {
+      cr_assert_eq(dfskiplist_peek_back(list).value, reference[length - 1], "Expected the tail to match at step %d", step);
+    }
+  }
+
+  cr_assert_eq((size_t)dfskiplist_length(list).value, length, "Expected lengths to match");
+  for (size_t i = 0; i < length; i++)
+  {
+    cr_assert_eq(dfskiplist_get(list, i).value, reference[i], "Expected element %zu to match", i);
+  }
+
+  // Cleanup
+  dfskiplist_destroy(list, NULL);
+}
+
+Test(df_skip_list_suit, drains_and_refills)
+{
+  DfSkipList *list = make_list(100);
+
+  for (int i = 0; i < 50; i++)
+  {
+    cr_assert_eq(*(int *)dfskiplist_pop_front(list).value, i, "Expected %d from the front", i);
+    cr_assert_eq(*(int *)dfskiplist_pop_back(list).value, 99 - i, "Expected %d from the back", 99 - i);
+  }
+  cr_assert_eq((size_t)dfskiplist_length(list).value, 0, "Expected empty list");
+
+  for (int i = 0; i < 10; i++)
+  {
+    dfskiplist_push_front(list, &values[i]);
+  }
+  for (int i = 0; i < 10; i++)
+  {
+    cr_assert_eq(*(int *)dfskiplist_get(list, (size_t)i).value, 9 - i, "Expected %d at index %d", 9 - i, i);
+  }
+
+  // Cleanup
+  dfskiplist_destroy(list, NULL);
+}
+
+Test(df_skip_list_iterator_suit, iterates_every_element_in_order)
+{
+  DfSkipList *list = make_list(1000);
+  Iterator *it = dfskiplist_iterator_create(list).value;
+
+  int expected = 0;
+  while (it->has_next(it))
+  {
+    DfResult next_res = it->next(it);
+    cr_assert_eq(next_res.error, DF_OK);
+    cr_assert_eq(*(int *)next_res.value, expected, "Expected %d", expected);
+    expected++;
+  }
+  cr_assert_eq(expected, 1000, "Expected 1000 elements");
+  cr_assert_eq(it->next(it).error, DF_ERR_END_OF_LIST, "Expected DF_ERR_END_OF_LIST");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfskiplist_destroy(list, NULL);
+}
+
+Test(df_skip_list_iterator_suit, works_with_generic_utils)
+{
+  DfSkipList *list = make_list(100);
+  Iterator *it = dfskiplist_iterator_create(list).value;
+
+  DfResult filter_res = df_filter(it, is_even);
+  cr_assert_eq(filter_res.error, DF_OK);
+
+  DfSkipList *evens = filter_res.value;
+  cr_assert_eq((size_t)dfskiplist_length(evens).value, 50, "Expected 50 even elements");
+  cr_assert_eq(*(int *)dfskiplist_get(evens, 25).value, 50, "Expected 50 at index 25");
+
+  // Cleanup
+  iterator_destroy(it);
+  free(it);
+  dfskiplist_destroy(evens, NULL);
+  dfskiplist_destroy(list, NULL);
+}
+
+Test(df_skip_list_iterator_suit, prefetching_does_not_change_traversals)
+{
+  DfSkipList *list = make_list(1000);
+  cr_assert_eq(dfskiplist_set_prefetch(list, 8, true).error, DF_OK);
+
+  Iterator it;
+  dfskiplist_iterator_init(&it, list);
+  for (int i = 0; i < 1000; i++)
+  {
+    cr_assert_eq(*(int *)it.next(&it).value, i, "Expected %d", i);
+  }
+  cr_assert_eq(it.has_next(&it), 0, "Expected the walk to end");
+
+  dfskiplist_iterator_init(&it, list);
+  cr_assert_eq((size_t)df_count(&it, is_even).value, 500, "Expected batches to see every element");
+
+  // Cleanup
+  dfskiplist_destroy(list, NULL);
+  cr_assert_eq(dfskiplist_set_prefetch(NULL, 4, true).error, DF_ERR_NULL_PTR, "Expected DF_ERR_NULL_PTR");
+}
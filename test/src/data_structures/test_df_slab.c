@@ -0,0 +1,151 @@
+#include <criterion/criterion.h>
+#include <criterion/internal/assert.h>
+#include <criterion/internal/test.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../../../includes/df_slab.h"
+#include "../../../includes/df_list_s.h"
+#include "../../../includes/df_common.h"
+
+Test(df_slab_suit, allocates_aligned_objects_from_chunks)
+{
+  DfResult create_res = dfslab_create(24, 4);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfSlab *slab = create_res.value;
+  void *objects[10];
+  for (int i = 0; i < 10; i++)
+  {
+    DfResult alloc_res = dfslab_alloc(slab);
+    cr_assert_eq(alloc_res.error, DF_OK);
+    objects[i] = alloc_res.value;
+    cr_assert_eq((uintptr_t)objects[i] % _Alignof(max_align_t), 0, "Expected object %d to be aligned", i);
+    memset(objects[i], 0xab, 24);
+  }
+
+  DfSlab_Stats stats;
+  dfslab_stats(slab, &stats);
+  cr_assert_eq(stats.allocs, 10, "Expected 10 allocations");
+  cr_assert_eq(stats.live, 10, "Expected 10 live objects");
+  cr_assert_eq(stats.chunks, 3, "Expected 3 chunks of 4 objects");
+  cr_assert_eq(stats.capacity, 12, "Expected room for 12 objects");
+
+  // Cleanup
+  dfslab_destroy(slab);
+}
+
+Test(df_slab_suit, reuses_freed_objects)
+{
+  DfSlab *slab = dfslab_create(sizeof(double), 8).value;
+
+  void *first = dfslab_alloc(slab).value;
+  void *second = dfslab_alloc(slab).value;
+  dfslab_free(slab, first);
+  dfslab_free(slab, second);
+
+  cr_assert_eq(dfslab_alloc(slab).value, second, "Expected the last freed object to be reused first");
+  cr_assert_eq(dfslab_alloc(slab).value, first, "Expected the earlier freed object to be reused next");
+
+  DfSlab_Stats stats;
+  dfslab_stats(slab, &stats);
+  cr_assert_eq(stats.chunks, 1, "Expected reuse not to allocate another chunk");
+  cr_assert_eq(stats.frees, 2, "Expected 2 frees");
+  cr_assert_float_eq(stats.fragmentation, 0.75, 1e-9, "Expected 6 of 8 slots unused");
+
+  // Cleanup
+  dfslab_destroy(slab);
+}
+
+Test(df_slab_suit, reset_releases_everything)
+{
+  DfSlab *slab = dfslab_create(16, 2).value;
+  for (int i = 0; i < 5; i++)
+  {
+    dfslab_alloc(slab);
+  }
+
+  cr_assert_eq(dfslab_reset(slab).error, DF_OK);
+
+  DfSlab_Stats stats;
+  dfslab_stats(slab, &stats);
+  cr_assert_eq(stats.live, 0, "Expected no live objects after reset");
+  cr_assert_eq(stats.capacity, 0, "Expected chunks to be released");
+  cr_assert_not_null(dfslab_alloc(slab).value, "Expected the slab to be usable after reset");
+
+  // Cleanup
+  dfslab_destroy(slab);
+}
+
+Test(df_slab_suit, rejects_zero_size)
+{
+  cr_assert_eq(dfslab_create(0, 4).error, DF_ERR_OUT_OF_RANGE, "Expected DF_ERR_OUT_OF_RANGE");
+}
+
+Test(df_slab_suit, pooled_list_draws_nodes_from_pool)
+{
+  DfResult create_res = dflist_s_create_pooled(NULL);
+  cr_assert_eq(create_res.error, DF_OK);
+
+  DfList_S *list = create_res.value;
+  DfSlab *pool = dflist_s_pool(list).value;
+  cr_assert_not_null(pool, "Expected the list to own a pool");
+
+  int values[2000];
+  for (int i = 0; i < 2000; i++)
+  {
+    values[i] = i;
+    dflist_s_push_back(list, &values[i]);
+  }
+
+  for (int i = 0; i < 1000; i++)
+  {
+    cr_assert_eq(*(int *)dflist_s_pop_front(list).value, i, "Expected %d from the front", i);
+  }
+  cr_assert_eq(*(int *)dflist_s_pop_back(list).value, 1999, "Expected 1999 from the back");
+  cr_assert_eq(*(int *)dflist_s_remove_at(list, 10).value, 1010, "Expected 1010 removed");
+
+  DfSlab_Stats stats;
+  dfslab_stats(pool, &stats);
+  cr_assert_eq(stats.allocs, 2000, "Expected one pool allocation per push");
+  cr_assert_eq(stats.live, 998, "Expected 998 live nodes");
+  cr_assert_eq(stats.chunks, 2, "Expected 2 chunks for 2000 nodes");
+
+  // Churn reuses freed nodes instead of growing the pool
+  for (int i = 0; i < 1000; i++)
+  {
+    dflist_s_push_front(list, &values[i]);
+  }
+  dfslab_stats(pool, &stats);
+  cr_assert_eq(stats.chunks, 2, "Expected churn to reuse freed nodes");
+
+  // Cleanup
+  dflist_s_destroy(list, NULL);
+}
+
+Test(df_slab_suit, lists_share_a_pool)
+{
+  DfSlab *pool = dflist_s_pool_create(16).value;
+  DfList_S *a = dflist_s_create_pooled(pool).value;
+  DfList_S *b = dflist_s_create_pooled(pool).value;
+
+  int values[] = {1, 2, 3};
+  dflist_s_push_back(a, &values[0]);
+  dflist_s_push_back(b, &values[1]);
+  dflist_s_push_back(b, &values[2]);
+
+  DfSlab_Stats stats;
+  dfslab_stats(pool, &stats);
+  cr_assert_eq(stats.live, 3, "Expected both lists to allocate from the shared pool");
+
+  // Destroying one list returns its nodes but leaves the pool alive
+  dflist_s_destroy(a, NULL);
+  dfslab_stats(pool, &stats);
+  cr_assert_eq(stats.live, 2, "Expected the destroyed list's node to be returned");
+  cr_assert_eq(*(int *)dflist_s_peek_back(b).value, 3, "Expected the other list to be intact");
+
+  // Cleanup
+  dflist_s_destroy(b, NULL);
+  dfslab_destroy(pool);
+}
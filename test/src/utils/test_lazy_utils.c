@@ -0,0 +1,306 @@
+#include <criterion/criterion.h>
+#include <stdlib.h>
+#include "../../../includes/df_deque.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static int calls;
+
+static DfDeque *make_range(int from, int to)
+{
+  DfDeque *deque = dfdeque_create(sizeof(int), 8).value;
+  for (int i = from; i < to; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  return deque;
+}
+
+static Iterator *iterate(DfDeque *deque)
+{
+  return (Iterator *)dfdeque_iterator_create(deque).value;
+}
+
+static void release(Iterator *it)
+{
+  iterator_destroy(it);
+  free(it);
+}
+
+static void *triple_value(void *element)
+{
+  calls++;
+  *(int *)element *= 3;
+  return element;
+}
+
+static bool is_odd(void *element)
+{
+  calls++;
+  return *(int *)element % 2 != 0;
+}
+
+static void *add_values(void *left, void *right)
+{
+  *(int *)left += *(int *)right;
+  return left;
+}
+
+static void sum_int(void *acc, void *elem)
+{
+  *(int *)acc += *(int *)elem;
+}
+
+static void assert_collects(Iterator *it, const int *expected, size_t count)
+{
+  DfResult res = df_collect(it);
+  cr_assert_eq(res.error, DF_OK);
+
+  DfDeque *collected = (DfDeque *)res.value;
+  cr_assert_eq((size_t)dfdeque_length(collected).value, count);
+  for (size_t i = 0; i < count; i++)
+  {
+    cr_assert_eq(*(int *)dfdeque_at(collected, i).value, expected[i]);
+  }
+  dfdeque_destroy(collected);
+}
+
+Test(df_lazy_suit, adaptors_do_no_work_until_pulled)
+{
+  DfDeque *deque = make_range(0, 10);
+  Iterator *source = iterate(deque);
+
+  calls = 0;
+  Iterator *filtered = (Iterator *)df_lazy_filter(source, is_odd).value;
+  Iterator *mapped = (Iterator *)df_lazy_map(filtered, triple_value).value;
+  cr_assert_eq(calls, 0);
+
+  cr_assert(mapped->has_next(mapped));
+  cr_assert_eq(*(int *)mapped->next(mapped).value, 3);
+  // One rejected and one accepted element, then one map call
+  cr_assert_eq(calls, 3);
+
+  release(mapped);
+  release(filtered);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, fused_pipeline_reduces_without_intermediates)
+{
+  DfDeque *deque = make_range(0, 10);
+  Iterator *source = iterate(deque);
+  Iterator *filtered = (Iterator *)df_lazy_filter(source, is_odd).value;
+  Iterator *mapped = (Iterator *)df_lazy_map(filtered, triple_value).value;
+
+  int initial = 0;
+  DfResult res = df_reduce(mapped, &initial, sum_int);
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq(*(int *)res.value, 3 * (1 + 3 + 5 + 7 + 9));
+  free(res.value);
+
+  release(mapped);
+  release(filtered);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, skip_and_take_window_the_source)
+{
+  DfDeque *deque = make_range(0, 10);
+  Iterator *source = iterate(deque);
+  Iterator *skipped = (Iterator *)df_lazy_skip(source, 3).value;
+  Iterator *taken = (Iterator *)df_lazy_take(skipped, 4).value;
+
+  int expected[] = {3, 4, 5, 6};
+  assert_collects(taken, expected, 4);
+  cr_assert(!taken->has_next(taken));
+  cr_assert_eq(taken->next(taken).error, DF_ERR_END_OF_LIST);
+
+  release(taken);
+  release(skipped);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, take_stops_without_pulling_further)
+{
+  DfDeque *deque = make_range(0, 10);
+  Iterator *source = iterate(deque);
+
+  calls = 0;
+  Iterator *mapped = (Iterator *)df_lazy_map(source, triple_value).value;
+  Iterator *taken = (Iterator *)df_lazy_take(mapped, 2).value;
+
+  int expected[] = {0, 3};
+  assert_collects(taken, expected, 2);
+  cr_assert_eq(calls, 2);
+
+  release(taken);
+  release(mapped);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, skip_past_the_end_is_empty)
+{
+  DfDeque *deque = make_range(0, 3);
+  Iterator *source = iterate(deque);
+  Iterator *skipped = (Iterator *)df_lazy_skip(source, 5).value;
+
+  cr_assert(!skipped->has_next(skipped));
+  cr_assert_eq((size_t)df_count(skipped, is_odd).value, 0);
+
+  release(skipped);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, chain_yields_both_sources_in_order)
+{
+  DfDeque *first = make_range(0, 3);
+  DfDeque *second = make_range(10, 12);
+  Iterator *first_it = iterate(first);
+  Iterator *second_it = iterate(second);
+  Iterator *chained = (Iterator *)df_lazy_chain(first_it, second_it).value;
+
+  int expected[] = {0, 1, 2, 10, 11};
+  assert_collects(chained, expected, 5);
+
+  release(chained);
+  release(first_it);
+  release(second_it);
+  dfdeque_destroy(first);
+  dfdeque_destroy(second);
+}
+
+Test(df_lazy_suit, zip_stops_at_the_shorter_source)
+{
+  DfDeque *left = make_range(0, 5);
+  DfDeque *right = make_range(100, 103);
+  Iterator *left_it = iterate(left);
+  Iterator *right_it = iterate(right);
+  Iterator *zipped = (Iterator *)df_lazy_zip(left_it, right_it, add_values).value;
+
+  int expected[] = {100, 102, 104};
+  assert_collects(zipped, expected, 3);
+
+  release(zipped);
+  release(left_it);
+  release(right_it);
+  dfdeque_destroy(left);
+  dfdeque_destroy(right);
+}
+
+Test(df_lazy_suit, free_all_reaches_every_source)
+{
+  DfDeque *first = make_range(0, 3);
+  DfDeque *second = make_range(0, 3);
+  Iterator *first_it = iterate(first);
+  Iterator *second_it = iterate(second);
+  Iterator *chained = (Iterator *)df_lazy_chain(first_it, second_it).value;
+
+  cr_assert_eq(df_free_all(chained).error, DF_OK);
+  cr_assert_eq((size_t)dfdeque_length(first).value, 0);
+  cr_assert_eq((size_t)dfdeque_length(second).value, 0);
+
+  release(chained);
+  release(first_it);
+  release(second_it);
+  dfdeque_destroy(first);
+  dfdeque_destroy(second);
+}
+
+Test(df_lazy_suit, rejects_null_arguments)
+{
+  DfDeque *deque = make_range(0, 3);
+  Iterator *source = iterate(deque);
+
+  cr_assert_eq(df_lazy_map(NULL, triple_value).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_lazy_map(source, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_lazy_filter(source, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_lazy_take(NULL, 1).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_lazy_chain(source, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_lazy_zip(source, source, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_collect(NULL).error, DF_ERR_NULL_PTR);
+
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, batched_pipeline_matches_single_steps)
+{
+  DfDeque *deque = make_range(0, 200);
+  Iterator *source = iterate(deque);
+  Iterator *skipped = (Iterator *)df_lazy_skip(source, 5).value;
+  Iterator *filtered = (Iterator *)df_lazy_filter(skipped, is_odd).value;
+  Iterator *taken = (Iterator *)df_lazy_take(filtered, 50).value;
+  cr_assert_not_null(taken->next_batch, "Expected batches to pass through skip, filter and take");
+
+  DfSpan span;
+  int expected = 5;
+  size_t seen = 0;
+  do
+  {
+    cr_assert_eq(taken->next_batch(taken, &span, DF_ITERATOR_BATCH).error, DF_OK);
+    for (size_t i = 0; i < span.count; i++, seen++, expected += 2)
+    {
+      cr_assert_eq(*(int *)df_span_at(&span, i), expected);
+    }
+  } while (span.count > 0);
+  cr_assert_eq(seen, 50);
+
+  release(taken);
+  release(filtered);
+  release(skipped);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+Test(df_lazy_suit, filter_hands_out_a_pending_match_first)
+{
+  DfDeque *deque = make_range(0, 10);
+  Iterator *source = iterate(deque);
+  Iterator *filtered = (Iterator *)df_lazy_filter(source, is_odd).value;
+
+  cr_assert(filtered->has_next(filtered));
+  DfSpan span;
+  filtered->next_batch(filtered, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 1);
+  cr_assert_eq(*(int *)df_span_at(&span, 0), 1);
+
+  filtered->next_batch(filtered, &span, DF_ITERATOR_BATCH);
+  cr_assert_eq(span.count, 4);
+  cr_assert_eq(*(int *)df_span_at(&span, 3), 9);
+
+  release(filtered);
+  release(source);
+  dfdeque_destroy(deque);
+}
+
+static int scratch;
+
+static void *triple_into_scratch(void *element)
+{
+  scratch = *(int *)element * 3;
+  return &scratch;
+}
+
+Test(df_lazy_suit, batched_map_keeps_results_from_shared_storage)
+{
+  DfDeque *deque = make_range(0, 100);
+  Iterator *source = iterate(deque);
+  Iterator *mapped = (Iterator *)df_lazy_map(source, triple_into_scratch).value;
+
+  int initial = 0;
+  DfResult res = df_reduce(mapped, &initial, sum_int);
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq(*(int *)res.value, 3 * 4950);
+  free(res.value);
+
+  release(mapped);
+  release(source);
+  dfdeque_destroy(deque);
+}
@@ -0,0 +1,240 @@
+#include <criterion/criterion.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include "../../../includes/df_array.h"
+#include "../../../includes/df_deque.h"
+#include "../../../includes/df_list_s.h"
+#include "../../../includes/df_list_v.h"
+#include "../../../includes/df_iterator.h"
+#include "../../../includes/df_common.h"
+#include "../../../includes/df_utils.h"
+
+// Helper functions
+static const DfParallel_Options four_threads = {4, 1000, NULL};
+
+static DfArray *make_array(long long count)
+{
+  DfArray *array = dfarray_create(sizeof(long long), (size_t)count).value;
+  for (long long i = 0; i < count; i++)
+  {
+    dfarray_push(array, &i);
+  }
+  return array;
+}
+
+static void square_into(void *element, void *out)
+{
+  *(double *)out = (double)(*(long long *)element) * (double)(*(long long *)element);
+}
+
+static void add_into(void *acc, void *elem)
+{
+  *(long long *)acc += *(long long *)elem;
+}
+
+static atomic_llong visited_sum;
+
+static void visit_value(void *element)
+{
+  atomic_fetch_add(&visited_sum, *(long long *)element);
+}
+
+// Consecutive runs of indices: combining is associative but not commutative
+typedef struct Run
+{
+  long long first;
+  long long last;
+  long long ordered;
+} Run;
+
+static void join_runs(void *acc, void *elem)
+{
+  Run *run = (Run *)acc;
+  Run *next = (Run *)elem;
+
+  if (run->first < 0)
+  {
+    *run = *next;
+    return;
+  }
+  if (next->first < 0)
+  {
+    return;
+  }
+
+  run->ordered = run->ordered && next->ordered && next->first == run->last + 1;
+  run->last = next->last;
+}
+
+Test(df_parallel_suit, map_writes_every_slot_of_the_output)
+{
+  DfArray *source = make_array(25000);
+  DfArray *output = dfarray_create(sizeof(double), 0).value;
+  Iterator it;
+  dfarray_iterator_init(&it, source);
+
+  DfResult res = df_parallel_map(&it, output, square_into, &four_threads);
+  cr_assert_eq(res.error, DF_OK);
+  cr_assert_eq(res.value, output);
+  cr_assert_eq((size_t)dfarray_length(output).value, 25000);
+  for (size_t i = 0; i < 25000; i += 997)
+  {
+    cr_assert_eq(*(double *)dfarray_at(output, i).value, (double)i * (double)i);
+  }
+  cr_assert(!it.has_next(&it), "Expected the iterator to be exhausted");
+
+  dfarray_destroy(source);
+  dfarray_destroy(output);
+}
+
+Test(df_parallel_suit, reduce_matches_sequential_for_any_split)
+{
+  DfArray *source = make_array(30001);
+  long long expected = 30000LL * 30001LL / 2;
+  DfParallel_Options splits[] = {{1, 0, NULL}, {2, 7, NULL}, {4, 1000, NULL}, {8, 30001, NULL}, {3, 100000, NULL}};
+
+  for (size_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++)
+  {
+    Iterator it;
+    dfarray_iterator_init(&it, source);
+    long long initial = 0;
+
+    DfResult res = df_parallel_reduce(&it, &initial, add_into, add_into, &splits[s]);
+    cr_assert_eq(res.error, DF_OK);
+    cr_assert_eq(*(long long *)res.value, expected, "Split %zu: expected %lld, got %lld", s, expected, *(long long *)res.value);
+    free(res.value);
+  }
+
+  dfarray_destroy(source);
+}
+
+Test(df_parallel_suit, reduce_combines_partials_in_order)
+{
+  DfArray *runs = dfarray_create(sizeof(Run), 0).value;
+  for (long long i = 0; i < 20000; i++)
+  {
+    Run run = {i, i, 1};
+    dfarray_push(runs, &run);
+  }
+
+  Iterator it;
+  dfarray_iterator_init(&it, runs);
+  Run identity = {-1, -1, 1};
+
+  DfResult res = df_parallel_reduce(&it, &identity, join_runs, join_runs, &four_threads);
+  cr_assert_eq(res.error, DF_OK);
+  Run *total = (Run *)res.value;
+  cr_assert_eq(total->first, 0);
+  cr_assert_eq(total->last, 19999);
+  cr_assert(total->ordered, "Expected partials to be combined in source order");
+
+  free(res.value);
+  dfarray_destroy(runs);
+}
+
+Test(df_parallel_suit, runs_on_a_pool)
+{
+  DfPool *pool = dfpool_create(3).value;
+  DfParallel_Options on_pool = {0, 500, pool};
+  DfArray *runs = dfarray_create(sizeof(Run), 0).value;
+  for (long long i = 0; i < 20000; i++)
+  {
+    Run run = {i, i, 1};
+    dfarray_push(runs, &run);
+  }
+
+  Iterator it;
+  dfarray_iterator_init(&it, runs);
+  Run identity = {-1, -1, 1};
+
+  DfResult res = df_parallel_reduce(&it, &identity, join_runs, join_runs, &on_pool);
+  cr_assert_eq(res.error, DF_OK);
+  Run *total = (Run *)res.value;
+  cr_assert_eq(total->first, 0);
+  cr_assert_eq(total->last, 19999);
+  cr_assert(total->ordered, "Expected partials to be combined in source order");
+  cr_assert(!it.has_next(&it), "Expected the iterator to be exhausted");
+
+  DfPool_Stats stats;
+  dfpool_stats(pool, &stats);
+  cr_assert_eq(stats.submitted, stats.executed, "Expected every chunk task to have run");
+
+  free(res.value);
+  dfarray_destroy(runs);
+  dfpool_destroy(pool);
+}
+
+Test(df_parallel_suit, for_each_covers_a_wrapped_deque)
+{
+  DfDeque *deque = dfdeque_create(sizeof(long long), 4096).value;
+  for (long long i = 0; i < 4096; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+  long long out;
+  for (int i = 0; i < 1000; i++)
+  {
+    dfdeque_pop_front_into(deque, &out);
+  }
+  for (long long i = 4096; i < 5096; i++)
+  {
+    dfdeque_push_back(deque, &i);
+  }
+
+  Iterator it;
+  dfdeque_iterator_init(&it, deque);
+  atomic_store(&visited_sum, 0);
+
+  cr_assert_eq(df_parallel_for_each(&it, visit_value, &four_threads).error, DF_OK);
+  cr_assert_eq(atomic_load(&visited_sum), (5095LL * 5096LL - 999LL * 1000LL) / 2);
+
+  dfdeque_destroy(deque);
+}
+
+Test(df_parallel_suit, sequential_sources_fall_back_in_order)
+{
+  DfList_V *list = dflist_v_create(sizeof(long long)).value;
+  for (long long i = 0; i < 100; i++)
+  {
+    dflist_v_push_back(list, &i);
+  }
+
+  Iterator it;
+  dflist_v_iterator_init(&it, list);
+  long long initial = 0;
+  DfResult reduce_res = df_parallel_reduce(&it, &initial, add_into, add_into, NULL);
+  cr_assert_eq(reduce_res.error, DF_OK);
+  cr_assert_eq(*(long long *)reduce_res.value, 4950);
+  free(reduce_res.value);
+
+  DfArray *output = dfarray_create(sizeof(double), 0).value;
+  dflist_v_iterator_init(&it, list);
+  cr_assert_eq(df_parallel_map(&it, output, square_into, &four_threads).error, DF_OK);
+  cr_assert_eq((size_t)dfarray_length(output).value, 100);
+  cr_assert_eq(*(double *)dfarray_at(output, 99).value, 99.0 * 99.0);
+
+  dfarray_destroy(output);
+  dflist_v_destroy(list);
+}
+
+Test(df_parallel_suit, rejects_bad_arguments)
+{
+  DfArray *source = make_array(10);
+  DfList_S *list = dflist_s_create().value;
+  Iterator it;
+  dfarray_iterator_init(&it, source);
+  long long initial = 0;
+
+  cr_assert_eq(df_parallel_map(NULL, source, square_into, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_parallel_map(&it, NULL, square_into, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_parallel_for_each(&it, NULL, NULL).error, DF_ERR_NULL_PTR);
+  cr_assert_eq(df_parallel_reduce(&it, &initial, add_into, NULL, NULL).error, DF_ERR_NULL_PTR);
+
+  // Pointer lists have no element size to copy or accumulate by
+  Iterator list_it;
+  dflist_s_iterator_init(&list_it, list);
+  cr_assert_eq(df_parallel_for_each(&list_it, visit_value, NULL).error, DF_ERR_INCOMPATIBLE);
+
+  dflist_s_destroy(list, NULL);
+  dfarray_destroy(source);
+}